@@ -16,7 +16,7 @@
 #include "vw.h"
 #include "benchmarks_common.h"
 
-std::shared_ptr<std::vector<char>> get_cache_buffer(const std::string& es)
+std::shared_ptr<std::vector<char>> get_cache_buffer(const std::string& es, bool block_codec = false)
 {
   auto vw = VW::initialize("--cb 2 --quiet");
   auto buffer = std::make_shared<std::vector<char>>();
@@ -30,7 +30,7 @@ std::shared_ptr<std::vector<char>> get_cache_buffer(const std::string& es)
   if (vw->example_parser->write_cache)
   {
     vw->example_parser->lbl_parser.cache_label(&ae->l, ae->_reduction_features, *(vw->example_parser->output));
-    cache_features(*(vw->example_parser->output), ae, vw->parse_mask);
+    cache_features(*(vw->example_parser->output), ae, vw->parse_mask, block_codec);
   }
   vw->example_parser->output->flush();
   VW::finish_example(*vw, *ae);
@@ -84,6 +84,30 @@ static void bench_cache_io_buf_collections(benchmark::State& state, ExtraArgs&&.
   }
 }
 
+template <class... ExtraArgs>
+static void bench_block_cache_io_buf(benchmark::State& state, ExtraArgs&&... extra_args)
+{
+  std::string res[sizeof...(extra_args)] = {extra_args...};
+  auto example_string = res[0];
+
+  auto buffer = get_cache_buffer(example_string, true);
+  auto vw = VW::initialize("--cb 2 --quiet");
+  vw->example_parser->block_cache = true;
+
+  v_array<example*> examples;
+  examples.push_back(&VW::get_unused_example(vw));
+
+  vw->example_parser->input = VW::make_unique<io_buf>();
+
+  for (auto _ : state)
+  {
+    vw->example_parser->input->add_file(VW::io::create_buffer_view(buffer->data(), buffer->size()));
+    read_cached_features(vw, examples);
+    VW::empty_example(*vw, *examples[0]);
+    benchmark::ClobberMemory();
+  }
+}
+
 template <class... ExtraArgs>
 static void bench_text_io_buf(benchmark::State& state, ExtraArgs&&... extra_args)
 {
@@ -129,9 +153,11 @@ static void benchmark_example_reuse(benchmark::State& state)
 }
 
 BENCHMARK_CAPTURE(bench_cache_io_buf, 120_string_fts, get_x_string_fts(120));
+BENCHMARK_CAPTURE(bench_block_cache_io_buf, 120_string_fts, get_x_string_fts(120));
 BENCHMARK_CAPTURE(bench_text_io_buf, 120_string_fts, get_x_string_fts(120));
 
 BENCHMARK_CAPTURE(bench_cache_io_buf, 120_num_fts, get_x_numerical_fts(120));
+BENCHMARK_CAPTURE(bench_block_cache_io_buf, 120_num_fts, get_x_numerical_fts(120));
 BENCHMARK_CAPTURE(bench_text_io_buf, 120_num_fts, get_x_numerical_fts(120));
 
 BENCHMARK(benchmark_example_reuse);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "queue.h"
+#include "lock_free_queue.h"
+#include "object_pool.h"
+
+// Moves items from one producer thread to the benchmark thread, mirroring the parser -> learner handoff.
+template <typename QueueT>
+static void bench_queue_handoff(benchmark::State& state)
+{
+  const auto items_per_iteration = static_cast<size_t>(state.range(0));
+  const auto capacity = static_cast<size_t>(state.range(1));
+  std::vector<int> payload(items_per_iteration);
+
+  for (auto _ : state)
+  {
+    QueueT queue(capacity);
+    std::thread producer([&] {
+      for (auto& item : payload) { queue.push(&item); }
+      queue.set_done();
+    });
+
+    size_t received = 0;
+    while (queue.pop() != nullptr) { received++; }
+    producer.join();
+    benchmark::DoNotOptimize(received);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items_per_iteration));
+}
+
+// Several producers share one ring, as in the multi-threaded parsing mode.
+template <typename QueueT>
+static void bench_queue_many_producers(benchmark::State& state)
+{
+  const auto num_producers = static_cast<size_t>(state.range(0));
+  const size_t items_per_producer = 1 << 16;
+  std::vector<int> payload(items_per_producer);
+
+  for (auto _ : state)
+  {
+    QueueT queue(256);
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < num_producers; ++i)
+    {
+      producers.emplace_back([&] {
+        for (auto& item : payload) { queue.push(&item); }
+      });
+    }
+
+    for (size_t i = 0; i < num_producers * items_per_producer; ++i) { benchmark::DoNotOptimize(queue.pop()); }
+    for (auto& producer : producers) { producer.join(); }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_producers * items_per_producer));
+}
+
+// The parser gets objects from the pool and the learner returns them.
+template <typename PoolT>
+static void bench_pool_round_trip(benchmark::State& state)
+{
+  const size_t items_per_iteration = 1 << 16;
+  PoolT pool(256);
+  VW::lock_free_ptr_queue<int> in_flight(256);
+
+  for (auto _ : state)
+  {
+    std::thread consumer([&] {
+      for (size_t i = 0; i < items_per_iteration; ++i) { pool.return_object(in_flight.pop()); }
+    });
+    for (size_t i = 0; i < items_per_iteration; ++i) { in_flight.push(pool.get_object()); }
+    consumer.join();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items_per_iteration));
+}
+
+BENCHMARK_TEMPLATE(bench_queue_handoff, VW::ptr_queue<int>)->Args({1 << 18, 256})->Args({1 << 18, 4096});
+BENCHMARK_TEMPLATE(bench_queue_handoff, VW::lock_free_ptr_queue<int>)->Args({1 << 18, 256})->Args({1 << 18, 4096});
+
+BENCHMARK_TEMPLATE(bench_queue_many_producers, VW::ptr_queue<int>)->Arg(2)->Arg(4);
+BENCHMARK_TEMPLATE(bench_queue_many_producers, VW::lock_free_ptr_queue<int>)->Arg(2)->Arg(4);
+
+BENCHMARK_TEMPLATE(bench_pool_round_trip, VW::object_pool<int>);
+BENCHMARK_TEMPLATE(bench_pool_round_trip, VW::lock_free_object_pool<int>);
@@ -43,3 +43,96 @@ BOOST_AUTO_TEST_CASE(write_and_read_features_from_cache)
 
   VW::finish(vw);
 }
+
+BOOST_AUTO_TEST_CASE(write_and_read_features_from_block_cache)
+{
+  auto& vw = *VW::initialize("--quiet");
+  example src_ex;
+  VW::read_line(vw, &src_ex, "|ns1 example value test |ss2 ex:0.5 ex2:-1 |big 0:1 4294967296:2 3:1");
+
+  // Enough features to span several blocks, with unsorted indices.
+  for (size_t i = 0; i < 300; i++) { src_ex.feature_space['m'].push_back(static_cast<float>(i % 3) - 1.f, 300 - i); }
+  src_ex.indices.push_back('m');
+
+  auto backing_vector = std::make_shared<std::vector<char>>();
+  io_buf io_writer;
+  io_writer.add_file(VW::io::create_vector_writer(backing_vector));
+
+  VW::write_example_to_cache(io_writer, &src_ex, vw.example_parser->lbl_parser, ~0ULL, true);
+
+  io_writer.flush();
+
+  io_buf io_reader;
+  io_reader.add_file(VW::io::create_buffer_view(backing_vector->data(), backing_vector->size()));
+
+  example dest_ex;
+  VW::read_example_from_cache(
+      io_reader, &dest_ex, vw.example_parser->lbl_parser, true, vw.example_parser->_shared_data, true);
+
+  BOOST_CHECK_EQUAL(dest_ex.indices.size(), 4);
+  BOOST_CHECK_EQUAL(dest_ex.sorted, false);
+  for (auto ns : {'n', 's', 'b', 'm'})
+  {
+    BOOST_CHECK_EQUAL(src_ex.feature_space[ns].size(), dest_ex.feature_space[ns].size());
+    check_collections_exact(src_ex.feature_space[ns].values, dest_ex.feature_space[ns].values);
+    check_collections_exact(src_ex.feature_space[ns].indicies, dest_ex.feature_space[ns].indicies);
+    BOOST_CHECK_EQUAL(src_ex.feature_space[ns].sum_feat_sq, dest_ex.feature_space[ns].sum_feat_sq);
+  }
+
+  VW::finish(vw);
+}
+
+namespace
+{
+std::vector<char> write_block_cache(vw& all, const std::string& line)
+{
+  example ex;
+  VW::read_line(all, &ex, line.c_str());
+  auto backing_vector = std::make_shared<std::vector<char>>();
+  io_buf io_writer;
+  io_writer.add_file(VW::io::create_vector_writer(backing_vector));
+  VW::write_example_to_cache(io_writer, &ex, all.example_parser->lbl_parser, ~0ULL, true);
+  io_writer.flush();
+  return *backing_vector;
+}
+
+void read_block_cache(vw& all, std::vector<char> cache)
+{
+  io_buf io_reader;
+  io_reader.add_file(VW::io::create_buffer_view(cache.data(), cache.size()));
+  example ex;
+  VW::read_example_from_cache(
+      io_reader, &ex, all.example_parser->lbl_parser, true, all.example_parser->_shared_data, true);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(read_corrupted_block_cache)
+{
+  auto& vw = *VW::initialize("--quiet");
+  const auto cache = write_block_cache(vw, "1 |x a b:0.5 c");
+  // The namespace follows the example without features, as its index byte, storage size, feature count and the
+  // header of its only block.
+  const size_t header = write_block_cache(vw, "1").size() + 1 + sizeof(size_t) + sizeof(uint32_t);
+  const size_t index_encoding = header + sizeof(uint32_t) + sizeof(uint16_t);
+  const size_t value_encoding = index_encoding + 1;
+  read_block_cache(vw, cache);
+
+  auto corrupted = cache;
+  corrupted[index_encoding] = 7;
+  BOOST_CHECK_THROW(read_block_cache(vw, corrupted), VW::vw_exception);
+
+  corrupted = cache;
+  corrupted[value_encoding] = 9;
+  BOOST_CHECK_THROW(read_block_cache(vw, corrupted), VW::vw_exception);
+
+  // A payload that runs past the namespace.
+  corrupted = cache;
+  corrupted[header] += 1;
+  BOOST_CHECK_THROW(read_block_cache(vw, corrupted), VW::vw_exception);
+
+  corrupted = cache;
+  corrupted.pop_back();
+  BOOST_CHECK_THROW(read_block_cache(vw, corrupted), VW::vw_exception);
+
+  VW::finish(vw);
+}
@@ -0,0 +1,97 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+const std::string model_name = "cb_explore_adf_bag_fused_test.model";
+
+std::vector<std::string> make_lines(size_t i)
+{
+  std::vector<std::string> lines = {
+      "shared |User u" + std::to_string(i % 3) + " v:0.5 |Context c" + std::to_string(i % 2)};
+  for (size_t a = 0; a < 6; a++)
+  {
+    std::string line = a == i % 6 ? std::to_string(a) + ":" + std::to_string(i % 4 == 0 ? 0.f : -1.f) + ":0.4 " : "";
+    lines.push_back(line + "|Action a" + std::to_string(a) + " b" + std::to_string(a % 2) + " |Other o" +
+        std::to_string((a + i) % 3));
+  }
+  return lines;
+}
+
+void train_model(const std::string& args)
+{
+  auto& all = *VW::initialize("--quiet --cb_explore_adf " + args);
+  for (size_t pass = 0; pass < 3; pass++)
+  {
+    for (size_t i = 0; i < 30; i++)
+    {
+      multi_ex examples;
+      for (const auto& line : make_lines(i)) { examples.push_back(VW::read_example(all, line)); }
+      all.learn(examples);
+      all.finish_example(examples);
+    }
+  }
+  VW::save_predictor(all, model_name);
+  VW::finish(all);
+}
+
+std::vector<std::map<uint32_t, float>> predict(const std::string& args)
+{
+  auto& all = *VW::initialize("--quiet -t -i " + model_name + " " + args);
+  std::vector<std::map<uint32_t, float>> probabilities;
+  for (size_t i = 0; i < 30; i++)
+  {
+    multi_ex examples;
+    for (const auto& line : make_lines(i)) { examples.push_back(VW::read_example(all, line)); }
+    all.predict(examples);
+    probabilities.emplace_back();
+    for (const auto& a_s : examples[0]->pred.a_s) { probabilities.back()[a_s.action] = a_s.score; }
+    all.finish_example(examples);
+  }
+  VW::finish(all);
+  return probabilities;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(cb_explore_adf_fused_bag_keeps_probabilities)
+{
+  for (const std::string args : {"--bag 4", "--bag 8 -q UA --epsilon 0.1", "--bag 5 --first_only -q :: --cb_type ips",
+           "--bag 3 --cb_type dr -q UA"})
+  {
+    train_model(args);
+    const auto expected = predict("");
+    for (const std::string fused_args : {"--fused_bag", "--fused_bag --ldf_predict_threads 3"})
+    {
+      // Threads can't be used with interactions, which are generated by a reduction of their own.
+      if (fused_args != "--fused_bag" && args.find("-q") != std::string::npos) { continue; }
+      const auto actual = predict(fused_args);
+      BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+      for (size_t i = 0; i < expected.size(); i++)
+      {
+        BOOST_REQUIRE_EQUAL(expected[i].size(), actual[i].size());
+        for (const auto& action_prob : expected[i])
+        {
+          BOOST_REQUIRE_EQUAL(actual[i].count(action_prob.first), 1);
+          BOOST_CHECK_CLOSE(actual[i].at(action_prob.first), action_prob.second, 0.001f);
+        }
+      }
+    }
+  }
+  std::remove(model_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(cb_explore_adf_fused_bag_requires_identity_link)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_explore_adf --bag 3 --fused_bag --link logistic"), VW::vw_exception);
+}
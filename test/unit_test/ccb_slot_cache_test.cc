@@ -0,0 +1,120 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+const std::string model_name = "ccb_slot_cache_test.model";
+
+// The slots inject features into the default namespace, into a namespace of their own and into a namespace that the
+// shared example has too.
+std::vector<std::string> make_lines(size_t i)
+{
+  return {"ccb shared |User u" + std::to_string(i % 3) + " v |Context c" + std::to_string(i % 2),
+      "ccb action |Action a b:0.5 |Other o" + std::to_string(i % 4), "ccb action |Action a c", "ccb action |Action d",
+      "ccb action |Action e f |Other o1", "ccb action |Action f g",
+      "ccb slot " + std::to_string(i % 5) + ":" + std::to_string(i % 3) + ":0.2 |Slot h x" + std::to_string(i % 2),
+      "ccb slot |Slot i |Context k", "ccb slot " + std::to_string((i + 2) % 5) + ":1:0.5 | j"};
+}
+
+using lines_generator = std::vector<std::string> (*)(size_t);
+
+void train_model(const std::string& args, lines_generator make = make_lines)
+{
+  auto& all = *VW::initialize("--quiet --ccb_explore_adf " + args);
+  for (size_t pass = 0; pass < 3; pass++)
+  {
+    for (size_t i = 0; i < 20; i++)
+    {
+      multi_ex examples;
+      for (const auto& line : make(i)) { examples.push_back(VW::read_example(all, line)); }
+      all.learn(examples);
+      all.finish_example(examples);
+    }
+  }
+  VW::save_predictor(all, model_name);
+  VW::finish(all);
+}
+
+// The actions of every slot with their probabilities, in the order of the decision.
+using slot_decision = std::vector<std::pair<uint32_t, float>>;
+
+std::vector<slot_decision> predict(const std::string& args, lines_generator make = make_lines)
+{
+  auto& all = *VW::initialize("--quiet -t -i " + model_name + " " + args);
+  std::vector<slot_decision> decisions;
+  for (size_t i = 0; i < 20; i++)
+  {
+    multi_ex examples;
+    for (const auto& line : make(i)) { examples.push_back(VW::read_example(all, line)); }
+    all.predict(examples);
+    for (const auto& slot : examples[0]->pred.decision_scores)
+    {
+      decisions.emplace_back();
+      for (const auto& a_s : slot) { decisions.back().emplace_back(a_s.action, a_s.score); }
+    }
+    all.finish_example(examples);
+  }
+  VW::finish(all);
+  return decisions;
+}
+
+void check_same_decisions(const std::string& args, lines_generator make = make_lines)
+{
+  train_model(args, make);
+  const auto expected = predict("", make);
+  const auto actual = predict("--cache_slot_scores", make);
+  std::remove(model_name.c_str());
+
+  // The scores are the same bit for bit, so even actions with the same probability keep their order.
+  BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(expected[i].size(), actual[i].size());
+    for (size_t j = 0; j < expected[i].size(); j++)
+    {
+      BOOST_CHECK_EQUAL(expected[i][j].first, actual[i][j].first);
+      BOOST_CHECK_EQUAL(expected[i][j].second, actual[i][j].second);
+    }
+  }
+}
+
+// Actions that only differ in the order of their features, or not at all, so their scores tie exactly or only differ
+// by rounding.
+std::vector<std::string> make_tied_lines(size_t i)
+{
+  return {"ccb shared |User u" + std::to_string(i % 3) + " v:0.1 |Context c" + std::to_string(i % 2),
+      "ccb action |Action a:0.3 b:0.7 c:1.1", "ccb action |Action c:1.1 b:0.7 a:0.3",
+      "ccb action |Action a:0.3 b:0.7 c:1.1", "ccb action |Action d", "ccb action |Action d",
+      "ccb slot " + std::to_string(i % 5) + ":" + std::to_string(i % 3) + ":0.2 |Slot h x" + std::to_string(i % 2),
+      "ccb slot |Slot i:0.3 |Context k", "ccb slot | j"};
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ccb_cache_slot_scores_keeps_decisions)
+{
+  for (const std::string args : {"", "-q UA -q AS --cubic UAC", "-q :: --cb_type mtr", "-q :: --bag 3 --epsilon 0"})
+  { check_same_decisions(args); }
+}
+
+BOOST_AUTO_TEST_CASE(ccb_cache_slot_scores_keeps_ties)
+{
+  for (const std::string args : {"-q UA -q AS", "-q :: --epsilon 0", "-q UA --cubic UAS --softmax --lambda 10"})
+  { check_same_decisions(args, make_tied_lines); }
+}
+
+BOOST_AUTO_TEST_CASE(ccb_cache_slot_scores_rejects_unsupported_setups)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --ccb_explore_adf --rnd 1 --cache_slot_scores"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --ccb_explore_adf --lrq Aa2 --cache_slot_scores"), VW::vw_exception);
+}
@@ -0,0 +1,110 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <vector>
+
+#include "delta_checkpoint.h"
+#include "vw.h"
+
+namespace
+{
+const std::vector<std::string> lines = {"1 |f a b c:2", "-1 |f d e:0.5", "1 |f a e", "-1 |f b d:3"};
+
+void learn_all(vw& all, const std::vector<std::string>& examples)
+{
+  for (const auto& line : examples)
+  {
+    example* ex = VW::read_example(all, line);
+    all.learn(*ex);
+    VW::finish_example(all, *ex);
+  }
+}
+
+std::vector<float> predict_all(vw& all)
+{
+  std::vector<float> predictions;
+  for (const auto& line : lines)
+  {
+    example* ex = VW::read_example(all, line);
+    all.predict(*ex);
+    predictions.push_back(ex->pred.scalar);
+    VW::finish_example(all, *ex);
+  }
+  return predictions;
+}
+
+size_t file_size(const std::string& name) { return static_cast<size_t>(std::ifstream(name, std::ios::ate).tellg()); }
+
+void check_delta_chain(const std::string& args)
+{
+  const std::string base = "delta_checkpoint_test.model";
+  const std::string first = base + ".1.delta";
+  const std::string second = base + ".2.delta";
+
+  // A base model with many more weights than the deltas change.
+  std::string wide = "1 |h";
+  for (size_t i = 0; i < 1000; i++) { wide += " " + std::to_string(i); }
+  auto& trainer = *VW::initialize("--quiet -b 18 --delta_checkpoints " + args);
+  learn_all(trainer, lines);
+  learn_all(trainer, {wide});
+  VW::save_predictor(trainer, base);
+  // Only the features of one namespace change.
+  learn_all(trainer, {"1 |g x y", "-1 |g y z:2"});
+  VW::save_delta(trainer, first);
+  learn_all(trainer, {"1 |g x", "1 |f a"});
+  VW::save_delta(trainer, second);
+  const auto expected = predict_all(trainer);
+  VW::finish(trainer);
+
+  BOOST_CHECK_LT(file_size(first), file_size(base));
+
+  auto& server = *VW::initialize("--quiet -t -i " + base + " --apply_deltas " + first + " --apply_deltas " + second);
+  const auto actual = predict_all(server);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+  VW::finish(server);
+
+  // Deltas only apply onto the model they were made from.
+  auto& skipped = *VW::initialize("--quiet -t -i " + base);
+  BOOST_CHECK_THROW(VW::apply_delta(skipped, second), VW::vw_exception);
+  VW::apply_delta(skipped, first);
+  BOOST_CHECK_THROW(VW::apply_delta(skipped, first), VW::vw_exception);
+  VW::finish(skipped);
+
+  std::remove(base.c_str());
+  std::remove(first.c_str());
+  std::remove(second.c_str());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(delta_checkpoint_dense_chain) { check_delta_chain(""); }
+
+BOOST_AUTO_TEST_CASE(delta_checkpoint_sparse_chain) { check_delta_chain("--sparse_weights"); }
+
+BOOST_AUTO_TEST_CASE(delta_checkpoint_fingerprints_ignore_untouched_blocks)
+{
+  auto& all = *VW::initialize("--quiet -b 16");
+  const auto before = VW::weight_block_fingerprints(all);
+  BOOST_CHECK_EQUAL(before.size(), (1u << 16) / VW::DELTA_BLOCK_WEIGHTS);
+  for (uint64_t fingerprint : before) { BOOST_CHECK_EQUAL(fingerprint, 0u); }
+
+  VW::set_weight(all, 5, 0, 1.f);
+  const auto after = VW::weight_block_fingerprints(all);
+  BOOST_CHECK_NE(after[0], 0u);
+  for (size_t b = 1; b < after.size(); b++) { BOOST_CHECK_EQUAL(after[b], 0u); }
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(delta_checkpoint_requires_a_base)
+{
+  auto& all = *VW::initialize("--quiet --delta_checkpoints");
+  BOOST_CHECK_THROW(VW::save_delta(all, "delta_checkpoint_test_no_base.delta"), VW::vw_exception);
+  VW::finish(all);
+}
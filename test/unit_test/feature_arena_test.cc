@@ -0,0 +1,124 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <string>
+#include <utility>
+
+#include "vw.h"
+#include "feature_arena.h"
+
+namespace
+{
+void add_features(VW::feature_arena& arena, namespace_index ns, size_t count, feature_index first)
+{
+  for (size_t i = 0; i < count; i++) { arena[ns].push_back(0.5f * (first + i), first + i); }
+}
+
+void check_features(const features& fs, size_t count, feature_index first)
+{
+  BOOST_REQUIRE_EQUAL(fs.size(), count);
+  for (size_t i = 0; i < count; i++)
+  {
+    BOOST_CHECK_EQUAL(fs.indicies[i], first + i);
+    BOOST_CHECK_EQUAL(fs.values[i], 0.5f * (first + i));
+  }
+}
+
+std::string make_line(size_t i)
+{
+  std::string line = std::to_string(i % 3 == 0 ? 1 : -1) + " |a";
+  for (size_t f = 0; f < 1 + i % 7; f++) { line += " a" + std::to_string((i + f) % 11); }
+  line += " |b x:" + std::to_string(i % 5) + " y";
+  if (i % 4 == 0) { line += " |c z" + std::to_string(i); }
+  return line;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(feature_arena_adds_groups_on_use)
+{
+  VW::feature_arena arena;
+  const auto& const_arena = arena;
+  BOOST_CHECK(const_arena['a'].empty());
+  BOOST_CHECK(arena.begin() == arena.end());
+
+  features& a = arena['a'];
+  add_features(arena, 'b', 2, 20);
+  add_features(arena, 'a', 3, 10);
+  BOOST_CHECK_EQUAL(&a, &arena['a']);
+  BOOST_CHECK_EQUAL(&a, &const_arena['a']);
+  BOOST_CHECK_EQUAL(std::distance(arena.begin(), arena.end()), 2);
+  check_features(const_arena['a'], 3, 10);
+  check_features(const_arena['b'], 2, 20);
+  BOOST_CHECK(const_arena['c'].empty());
+}
+
+BOOST_AUTO_TEST_CASE(feature_arena_packs_groups)
+{
+  VW::feature_arena arena;
+  add_features(arena, 'a', 3, 10);
+  add_features(arena, 'b', 5, 20);
+  arena.pack();
+
+  BOOST_CHECK(arena.holds('a'));
+  BOOST_CHECK(arena.holds('b'));
+  BOOST_CHECK(!arena.holds('c'));
+  check_features(arena['a'], 3, 10);
+  check_features(arena['b'], 5, 20);
+
+  // Filling a group in place keeps it in its region, so packing again changes nothing.
+  const size_t bytes = arena.capacity_bytes();
+  arena['a'].clear();
+  add_features(arena, 'a', 2, 30);
+  BOOST_CHECK(arena.holds('a'));
+  arena.pack();
+  BOOST_CHECK_EQUAL(arena.capacity_bytes(), bytes);
+  check_features(arena['a'], 2, 30);
+
+  // The groups keep their regions when the arena moves.
+  VW::feature_arena moved(std::move(arena));
+  BOOST_CHECK(moved.holds('a'));
+  BOOST_CHECK(moved.holds('b'));
+  check_features(moved['b'], 5, 20);
+}
+
+BOOST_AUTO_TEST_CASE(feature_arena_grows_regions)
+{
+  VW::feature_arena arena;
+  add_features(arena, 'a', 2, 10);
+  add_features(arena, 'b', 2, 20);
+  arena.pack();
+
+  // Outgrowing the region moves the group out of the block, the next pack takes it back in.
+  add_features(arena, 'a', 3, 12);
+  BOOST_CHECK(!arena.holds('a'));
+  add_features(arena, 'c', 4, 40);
+  arena.pack();
+
+  BOOST_CHECK(arena.holds('a'));
+  BOOST_CHECK(arena.holds('b'));
+  BOOST_CHECK(arena.holds('c'));
+  check_features(arena['a'], 5, 10);
+  check_features(arena['b'], 2, 20);
+  check_features(arena['c'], 4, 40);
+}
+
+BOOST_AUTO_TEST_CASE(feature_arena_holds_recycled_examples)
+{
+  auto& all = *VW::initialize("--quiet --ring_size 2 -q ab");
+  for (size_t i = 0; i < 20; i++)
+  {
+    example* ex = VW::read_example(all, make_line(i));
+    BOOST_CHECK(ex->feature_space.holds('a'));
+    BOOST_CHECK(ex->feature_space.holds('b'));
+    BOOST_CHECK(ex->feature_space.holds(constant_namespace));
+    // Only the namespaces the examples used have a group.
+    BOOST_CHECK_LE(std::distance(ex->feature_space.begin(), ex->feature_space.end()), 4);
+    all.learn(*ex);
+    VW::finish_example(all, *ex);
+  }
+  VW::finish(all);
+}
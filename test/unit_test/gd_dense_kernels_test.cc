@@ -0,0 +1,167 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#  include <xmmintrin.h>
+#endif
+
+#include "gd_dense_kernels.h"
+#include "gd_predict.h"
+
+namespace
+{
+constexpr size_t COUNT = 37;  // not a multiple of the vector width, so the tails are covered
+
+std::vector<float> make_values(size_t count)
+{
+  std::vector<float> values;
+  uint32_t state = 4321;
+  for (size_t i = 0; i < count; i++)
+  {
+    state = state * 1103515245 + 12345;
+    values.push_back(static_cast<float>(state >> 8) / (1 << 24) * 4.f - 2.f);
+  }
+  return values;
+}
+
+std::vector<float> make_weights(size_t count, uint32_t stride)
+{
+  auto weights = make_values(count * stride);
+  for (size_t i = 0; i < count; i++)
+  {
+    // Some untrained weights, which feature_mask_off = false skips.
+    if (i % 5 == 0) { weights[i * stride] = 0.f; }
+    // The adaptive and normalized state is positive.
+    for (uint32_t j = 1; j < stride; j++) { weights[i * stride + j] = std::fabs(weights[i * stride + j]) + 0.1f; }
+  }
+  return weights;
+}
+
+// The kernels add in the order of the per feature loop, so the results are the same bit for bit.
+void check_equal(const std::vector<float>& expected, const std::vector<float>& actual)
+{
+  BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++) { BOOST_CHECK_EQUAL(expected[i], actual[i]); }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(gd_dense_dot_matches_scalar)
+{
+  const auto x = make_values(COUNT);
+  for (uint32_t stride : {1u, 2u, 4u})
+  {
+    const auto w = make_weights(COUNT, stride);
+    float expected = 0.5f;
+    for (size_t i = 0; i < COUNT; i++) { expected += x[i] * w[i * stride]; }
+
+    float sum = 0.5f;
+    if (!GD::dense_dot(x.data(), w.data(), COUNT, stride, sum)) { continue; }
+    BOOST_CHECK_EQUAL(expected, sum);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(gd_dense_update_matches_scalar)
+{
+  const auto x = make_values(COUNT);
+  for (uint32_t stride : {1u, 4u})
+  {
+    for (bool feature_mask_off : {true, false})
+    {
+      const size_t spare = stride == 4 ? 3 : 0;
+      auto expected = make_weights(COUNT, stride);
+      auto actual = expected;
+      const float update = 0.25f;
+      for (size_t i = 0; i < COUNT; i++)
+      {
+        float* w = &expected[i * stride];
+        if (!feature_mask_off && w[0] == 0.f) { continue; }
+        w[0] += update * (spare != 0 ? x[i] * w[spare] : x[i]);
+      }
+
+      if (!GD::dense_update(update, x.data(), actual.data(), COUNT, stride, spare, feature_mask_off)) { continue; }
+      check_equal(expected, actual);
+    }
+  }
+}
+
+// The kernel only runs where InvSqrt in gd.cc uses the rsqrt instruction.
+#if defined(__SSE2__)
+BOOST_AUTO_TEST_CASE(gd_dense_pred_per_update_matches_scalar)
+{
+  auto x = make_values(COUNT);
+  x[3] = 0.f;  // clamped to x_min
+  const float grad_squared = 0.75f;
+  for (bool feature_mask_off : {true, false})
+  {
+    auto expected = make_weights(COUNT, 4);
+    auto actual = expected;
+    float expected_pred_per_update = 0.f;
+    float expected_norm_x = 0.f;
+    for (size_t i = 0; i < COUNT; i++)
+    {
+      float* w = &expected[i * 4];
+      if (!feature_mask_off && w[0] == 0.f) { continue; }
+      float xi = x[i];
+      float x2 = xi * xi;
+      if (x2 < GD::x2_min)
+      {
+        xi = xi > 0 ? GD::x_min : -GD::x_min;
+        x2 = GD::x2_min;
+      }
+      w[1] += grad_squared * x2;
+      const float x_abs = std::fabs(xi);
+      if (x_abs > w[2])
+      {
+        w[0] *= w[2] / x_abs;
+        w[2] = x_abs;
+      }
+      expected_norm_x += x2 / (w[2] * w[2]);
+      w[3] = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(w[1]))) * (1.f / w[2]);
+      expected_pred_per_update += x2 * w[3];
+    }
+
+    float pred_per_update = 0.f;
+    float norm_x = 0.f;
+    if (!GD::dense_pred_per_update_sqrt_rate(
+            grad_squared, x.data(), actual.data(), COUNT, 4, feature_mask_off, pred_per_update, norm_x))
+    { continue; }
+    check_equal(expected, actual);
+    BOOST_CHECK_EQUAL(expected_pred_per_update, pred_per_update);
+    BOOST_CHECK_EQUAL(expected_norm_x, norm_x);
+  }
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(gd_dense_run_detection)
+{
+  dense_parameters weights(64, 2);
+  features fs;
+  for (uint64_t i = 0; i < GD::DENSE_RUN_MIN_LENGTH; i++) { fs.push_back(1.f, (i + 10) << 2); }
+
+  uint64_t first = 0;
+  BOOST_CHECK(GD::is_dense_run(weights, fs, 0, first));
+  BOOST_CHECK_EQUAL(first, 10u << 2);
+  BOOST_CHECK(GD::is_dense_run(weights, fs, 4, first));
+  BOOST_CHECK_EQUAL(first, 11u << 2);
+
+  // Wraps around the end of the table.
+  BOOST_CHECK(!GD::is_dense_run(weights, fs, 40 << 2, first));
+
+  // A gap.
+  features gap;
+  for (uint64_t i = 0; i < GD::DENSE_RUN_MIN_LENGTH; i++) { gap.push_back(1.f, (i + (i > 5 ? 11 : 10)) << 2); }
+  BOOST_CHECK(!GD::is_dense_run(weights, gap, 0, first));
+
+  // Too short.
+  features short_run;
+  for (uint64_t i = 0; i + 1 < GD::DENSE_RUN_MIN_LENGTH; i++) { short_run.push_back(1.f, i << 2); }
+  BOOST_CHECK(!GD::is_dense_run(weights, short_run, 0, first));
+}
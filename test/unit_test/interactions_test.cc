@@ -275,3 +275,54 @@ BOOST_AUTO_TEST_CASE(compile_interactions_cubic_permutations)
   sort_all(result);
   check_vector_of_vectors_exact(result, compare_set);
 }
+
+struct visited_features
+{
+  std::vector<float> values;
+  std::vector<float> weights;
+};
+
+void collect_feature(visited_features& dat, const float fx, float& fw)
+{
+  dat.values.push_back(fx);
+  dat.weights.push_back(fw);
+}
+
+// The kernel hashes and prefetches interacted features in blocks. Features must still reach FuncT one by one, in
+// order, across block boundaries.
+BOOST_AUTO_TEST_CASE(interaction_kernel_visits_features_in_order)
+{
+  constexpr size_t num_bits = 18;
+  dense_parameters weights(static_cast<size_t>(1) << num_bits);
+  auto initializer = [](weight* w, uint64_t index) { w[0] = static_cast<float>(index); };
+  weights.set_default(initializer);
+
+  example_predict ex;
+  ex.ft_offset = 3;
+  ex.indices.push_back('a');
+  ex.indices.push_back('b');
+  for (uint64_t i = 0; i < 3; ++i) { ex.feature_space['a'].push_back(1.f + i, 1000 + i); }
+  for (uint64_t i = 0; i < 2 * INTERACTIONS::INTERACTION_PREFETCH_BLOCK + 5; ++i)
+  { ex.feature_space['b'].push_back(0.5f * (i + 1), 7 * i); }
+
+  std::vector<std::vector<namespace_index>> interactions = {{'a', 'b'}};
+  visited_features dat;
+  size_t num_features = 0;
+  INTERACTIONS::generate_interactions<visited_features, float&, collect_feature, false, nullptr>(
+      interactions, false, ex, dat, weights, num_features);
+
+  const auto& a = ex.feature_space['a'];
+  const auto& b = ex.feature_space['b'];
+  BOOST_REQUIRE_EQUAL(dat.values.size(), a.size() * b.size());
+  BOOST_CHECK_EQUAL(num_features, a.size() * b.size());
+  size_t k = 0;
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    const uint64_t halfhash = FNV_prime * a.indicies[i];
+    for (size_t j = 0; j < b.size(); ++j, ++k)
+    {
+      BOOST_CHECK_EQUAL(dat.values[k], a.values[i] * b.values[j]);
+      BOOST_CHECK_EQUAL(dat.weights[k], weights[(b.indicies[j] ^ halfhash) + ex.ft_offset]);
+    }
+  }
+}
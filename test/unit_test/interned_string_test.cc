@@ -0,0 +1,141 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "vw.h"
+#include "interned_string.h"
+
+BOOST_AUTO_TEST_CASE(interned_string_equal_strings_share_an_entry)
+{
+  VW::string_table table;
+  const std::string name = "interned_string_test_name";
+  VW::interned_string a = table.intern(name);
+  VW::interned_string b = table.intern(name.c_str());
+  VW::interned_string c = table.intern(VW::string_view(name));
+
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(a == c);
+  BOOST_CHECK_EQUAL(&a.str(), &b.str());
+  BOOST_CHECK_EQUAL(a, name);
+  BOOST_CHECK(a != table.intern("interned_string_test_other"));
+  BOOST_CHECK(a != "interned_string_test_other");
+}
+
+BOOST_AUTO_TEST_CASE(interned_string_empty)
+{
+  VW::string_table table;
+  VW::interned_string empty;
+  BOOST_CHECK(empty.empty());
+  BOOST_CHECK(empty == table.intern(""));
+  BOOST_CHECK(empty == table.intern(std::string()));
+  BOOST_CHECK_EQUAL(empty, "");
+}
+
+BOOST_AUTO_TEST_CASE(interned_string_from_threads)
+{
+  VW::string_table table;
+  const size_t num_threads = 4;
+  std::vector<std::vector<VW::interned_string>> interned(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++)
+  {
+    threads.emplace_back([t, &table, &interned]() {
+      for (size_t i = 0; i < 1000; i++)
+      { interned[t].push_back(table.intern("thread_name_" + std::to_string((i + t) % 500))); }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  for (size_t t = 0; t < num_threads; t++)
+  {
+    for (size_t i = 0; i < 1000; i++)
+    {
+      BOOST_CHECK_EQUAL(interned[t][i], "thread_name_" + std::to_string((i + t) % 500));
+      // Every thread gets the one entry of the table.
+      BOOST_CHECK_EQUAL(&interned[t][i].str(), &interned[0][(i + t) % 1000].str());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(interned_string_tables_are_separate)
+{
+  VW::string_table first;
+  VW::interned_string name = first.intern("interned_string_test_name");
+  {
+    VW::string_table second;
+    VW::interned_string other = second.intern("interned_string_test_name");
+    BOOST_CHECK(&name.str() != &other.str());
+    BOOST_CHECK(name == other);
+  }
+  // A table made after one was destroyed, possibly at the same address, doesn't see the entries of the old one.
+  for (int i = 0; i < 3; i++)
+  {
+    auto table = std::unique_ptr<VW::string_table>(new VW::string_table());
+    BOOST_CHECK_EQUAL(table->intern("interned_string_test_name"), "interned_string_test_name");
+    const std::string other = "interned_string_test_" + std::to_string(i);
+    BOOST_CHECK_EQUAL(table->intern(other), other);
+  }
+  BOOST_CHECK_EQUAL(&first.intern("interned_string_test_name").str(), &name.str());
+}
+
+BOOST_AUTO_TEST_CASE(interned_string_table_is_bounded)
+{
+  VW::string_table table(64);
+  std::vector<VW::interned_string> interned;
+  for (size_t i = 0; i < 1000; i++)
+  {
+    interned.push_back(table.intern("bounded_name_" + std::to_string(i)));
+    BOOST_REQUIRE_LE(table.size(), 64);
+  }
+  // Handles keep their strings after the table dropped them.
+  for (size_t i = 0; i < 1000; i++)
+  {
+    BOOST_CHECK_EQUAL(interned[i], "bounded_name_" + std::to_string(i));
+    BOOST_CHECK(interned[i] == table.intern("bounded_name_" + std::to_string(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(interned_string_audit_names)
+{
+  auto& all = *VW::initialize("--quiet --audit");
+  example* ex = VW::read_example(all, "1 |first a b:2 |second a");
+  const auto& first = ex->feature_space['f'].space_names;
+  const auto& second = ex->feature_space['s'].space_names;
+  BOOST_REQUIRE_EQUAL(first.size(), 2);
+  BOOST_REQUIRE_EQUAL(second.size(), 1);
+  BOOST_CHECK_EQUAL(first[0].first, "first");
+  BOOST_CHECK_EQUAL(first[0].second, "a");
+  BOOST_CHECK_EQUAL(first[1].second, "b");
+  BOOST_CHECK_EQUAL(second[0].first, "second");
+  // The feature a of both namespaces is the same entry of the table of the instance.
+  BOOST_CHECK_EQUAL(&first[0].second.str(), &second[0].second.str());
+  BOOST_CHECK_EQUAL(&first[0].second.str(), &all.name_table.intern("a").str());
+  VW::finish_example(all, *ex);
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(interned_string_audit_names_per_instance)
+{
+  auto& first = *VW::initialize("--quiet --audit");
+  auto& second = *VW::initialize("--quiet --audit");
+  example* first_ex = VW::read_example(first, "1 |first a");
+  example* second_ex = VW::read_example(second, "1 |first a");
+  const auto& first_name = first_ex->feature_space['f'].space_names[0].second;
+  const auto& second_name = second_ex->feature_space['f'].space_names[0].second;
+  BOOST_CHECK(first_name == second_name);
+  BOOST_CHECK(&first_name.str() != &second_name.str());
+  VW::finish_example(first, *first_ex);
+  VW::finish(first);
+  // The names of the second instance outlive the first.
+  BOOST_CHECK_EQUAL(second_name, "a");
+  VW::finish_example(second, *second_ex);
+  VW::finish(second);
+}
@@ -0,0 +1,74 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <string>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+constexpr size_t NUM_ACTIONS = 50;
+
+std::vector<std::string> make_lines(size_t round)
+{
+  std::vector<std::string> lines = {"shared |s a" + std::to_string(round % 3) + " b c:2"};
+  for (size_t k = 0; k < NUM_ACTIONS; k++)
+  {
+    const std::string label = k == round % NUM_ACTIONS ? "0:" + std::to_string(round % 2) + ":0.5 " : "";
+    lines.push_back(label + "|a x" + std::to_string(k) + " y" + std::to_string((k + round) % 7) + ":0.5");
+  }
+  return lines;
+}
+
+// Learns a few multi-examples and returns the predictions on the next ones, which are only predicted.
+std::vector<float> run(const std::string& args)
+{
+  auto& all = *VW::initialize(args + " --quiet");
+  std::vector<float> scores;
+  for (size_t round = 0; round < 20; round++)
+  {
+    multi_ex examples;
+    for (const auto& line : make_lines(round)) { examples.push_back(VW::read_example(all, line)); }
+    if (round < 10) { all.learn(examples); }
+    else
+    {
+      all.predict(examples);
+      for (const auto& a_s : examples[0]->pred.a_s)
+      {
+        scores.push_back(static_cast<float>(a_s.action));
+        scores.push_back(a_s.score);
+      }
+    }
+    all.finish_example(examples);
+  }
+  VW::finish(all);
+  return scores;
+}
+
+void check_threads_match_serial(const std::string& args)
+{
+  const auto expected = run(args);
+  const auto actual = run(args + " --ldf_predict_threads 4");
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ldf_predict_threads_match_serial_predictions)
+{
+  check_threads_match_serial("--cb_adf");
+  check_threads_match_serial("--cb_adf -q sa --cb_type dr");
+  check_threads_match_serial("--cb_explore_adf --epsilon 0.1 -q sa");
+  check_threads_match_serial("--cb_adf -q sa --cache_shared_context");
+}
+
+BOOST_AUTO_TEST_CASE(ldf_predict_threads_rejects_unsupported_setups)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_adf --ldf_predict_threads 0"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_adf --ldf_predict_threads 2 --sparse_weights"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_adf --ldf_predict_threads 2 -q s:"), VW::vw_exception);
+}
@@ -0,0 +1,57 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <string>
+#include <vector>
+
+#include "vw.h"
+#include "learner.h"
+
+namespace
+{
+std::vector<example*> read_examples(vw& all)
+{
+  std::vector<example*> examples;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    const std::string label = i % 2 == 0 ? "1" : "-1";
+    const std::string line = label + " |f a:" + std::to_string(i % 7) + " b" + (i % 2 == 0 ? " pos" : " neg");
+    examples.push_back(VW::read_example(all, line));
+  }
+  return examples;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(learn_threads_learns_separable_data)
+{
+  for (const std::string extra : {"", " --learn_thread_local_norm"})
+  {
+    auto& all = *VW::initialize("--quiet --learn_threads 4" + extra);
+    BOOST_CHECK_EQUAL(all.learn_threads, 4);
+    BOOST_REQUIRE(all.learn_pool != nullptr);
+
+    auto examples = read_examples(all);
+    for (size_t pass = 0; pass < 3; ++pass) { VW::LEARNER::hogwild_learn(all, examples); }
+
+    for (auto* ex : examples)
+    {
+      all.predict(*ex);
+      BOOST_CHECK_EQUAL(ex->pred.scalar > 0.f, ex->l.simple.label > 0.f);
+      all.finish_example(*ex);
+    }
+    VW::finish(all);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(learn_threads_rejects_unsupported_setups)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --learn_threads 2 --oaa 3"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --learn_threads 2 --sparse_weights"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --learn_threads 2 --l2 0.1"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --learn_threads 0"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --learn_thread_local_norm"), VW::vw_exception);
+}
@@ -0,0 +1,94 @@
+#ifndef STATIC_LINK_VW
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include "lock_free_queue.h"
+#include "object_pool.h"
+
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(lock_free_queue_single_thread)
+{
+  VW::lock_free_ptr_queue<int> queue(3);
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+
+  std::vector<int> items = {1, 2, 3, 4, 5};
+  for (size_t i = 0; i < 4; ++i) { BOOST_CHECK(queue.try_push(&items[i])); }
+  BOOST_CHECK(!queue.try_push(&items[4]));
+  BOOST_CHECK_EQUAL(queue.size(), 4);
+
+  for (size_t i = 0; i < 4; ++i) { BOOST_CHECK_EQUAL(*queue.pop(), items[i]); }
+  int* item = nullptr;
+  BOOST_CHECK(!queue.try_pop(item));
+
+  queue.set_done();
+  BOOST_CHECK(queue.pop() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(lock_free_queue_keeps_fifo_order_across_threads)
+{
+  const size_t num_items = 100000;
+  std::vector<size_t> items(num_items);
+  for (size_t i = 0; i < num_items; ++i) { items[i] = i; }
+
+  VW::lock_free_ptr_queue<size_t> queue(16);
+  std::thread producer([&] {
+    for (auto& item : items) { queue.push(&item); }
+    queue.set_done();
+  });
+
+  size_t expected = 0;
+  while (auto* item = queue.pop())
+  {
+    BOOST_REQUIRE_EQUAL(*item, expected);
+    expected++;
+  }
+  producer.join();
+  BOOST_CHECK_EQUAL(expected, num_items);
+}
+
+BOOST_AUTO_TEST_CASE(lock_free_queue_many_producers)
+{
+  const size_t num_producers = 4;
+  const size_t items_per_producer = 20000;
+  std::vector<std::vector<int>> items(num_producers, std::vector<int>(items_per_producer, 0));
+
+  VW::lock_free_ptr_queue<int> queue(8);
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < num_producers; ++p)
+  {
+    producers.emplace_back([&, p] {
+      for (auto& item : items[p]) { queue.push(&item); }
+    });
+  }
+
+  for (size_t i = 0; i < num_producers * items_per_producer; ++i) { (*queue.pop())++; }
+  for (auto& producer : producers) { producer.join(); }
+
+  for (const auto& producer_items : items)
+  {
+    for (auto item : producer_items) { BOOST_REQUIRE_EQUAL(item, 1); }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(lock_free_object_pool_grows_and_recycles)
+{
+  VW::lock_free_object_pool<int> pool(2);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  std::vector<int*> taken;
+  for (size_t i = 0; i < 7; ++i) { taken.push_back(pool.get_object()); }
+  BOOST_CHECK_EQUAL(pool.size(), 14);
+  for (auto* obj : taken) { BOOST_CHECK(pool.is_from_pool(obj)); }
+
+  int outside = 0;
+  BOOST_CHECK(!pool.is_from_pool(&outside));
+
+  for (auto* obj : taken) { pool.return_object(obj); }
+  for (size_t i = 0; i < 14; ++i) { pool.get_object(); }
+  BOOST_CHECK_EQUAL(pool.size(), 14);
+}
@@ -0,0 +1,185 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "mapped_cache.h"
+#include "parser.h"
+#include "vw.h"
+#include "test_common.h"
+
+namespace
+{
+void write_mapped_cache(vw& vw, const std::string& file_name, const std::vector<std::string>& lines)
+{
+  io_buf output;
+  output.add_file(VW::io::open_file_writer(file_name));
+
+  const std::string version = VW::version.to_string();
+  const size_t v_length = version.length() + 1;
+  output.bin_write_fixed(reinterpret_cast<const char*>(&v_length), sizeof(v_length));
+  output.bin_write_fixed(version.c_str(), v_length);
+  output.bin_write_fixed(&VW::MAPPED_CACHE_TYPE, 1);
+  output.bin_write_fixed(reinterpret_cast<const char*>(&vw.num_bits), sizeof(vw.num_bits));
+
+  VW::mapped_cache_writer writer(sizeof(v_length) + v_length + 1 + sizeof(vw.num_bits));
+  for (const auto& line : lines)
+  {
+    example ex;
+    VW::read_line(vw, &ex, line.c_str());
+    writer.write_example(output, ex, vw.example_parser->lbl_parser, vw.parse_mask);
+  }
+  writer.finish(output);
+  output.flush();
+  output.close_file();
+}
+
+std::vector<char> read_file(const std::string& file_name)
+{
+  std::ifstream file(file_name, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& file_name, const std::vector<char>& bytes)
+{
+  std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+T get(const std::vector<char>& bytes, size_t at)
+{
+  T value;
+  std::memcpy(&value, bytes.data() + at, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void put(std::vector<char>& bytes, size_t at, T value)
+{
+  std::memcpy(bytes.data() + at, &value, sizeof(T));
+}
+
+void check_same_features(example& expected, example& actual)
+{
+  check_collections_exact(expected.indices, actual.indices);
+  for (auto ns : expected.indices)
+  {
+    check_collections_exact(expected.feature_space[ns].indicies, actual.feature_space[ns].indicies);
+    check_collections_with_float_tolerance(
+        expected.feature_space[ns].values, actual.feature_space[ns].values, FLOAT_TOL);
+    BOOST_CHECK_CLOSE(expected.feature_space[ns].sum_feat_sq, actual.feature_space[ns].sum_feat_sq, FLOAT_TOL);
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(write_and_read_features_from_mapped_cache)
+{
+  auto& vw = *VW::initialize("--quiet");
+  const std::string file_name = "mapped_cache_test.cache";
+  const std::vector<std::string> lines = {
+      "1 |ns1 example value test |ss2 ex:0.5", "-1 2.5 tag_b|ns1 other:-3", "0.5 |ss2 a b c d e f g h i"};
+  write_mapped_cache(vw, file_name, lines);
+
+  VW::mapped_cache_reader reader(file_name);
+  BOOST_CHECK_EQUAL(reader.num_bits(), vw.num_bits);
+  BOOST_CHECK_EQUAL(reader.num_examples(), lines.size());
+
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    example src_ex;
+    VW::read_line(vw, &src_ex, lines[i].c_str());
+
+    example dest_ex;
+    BOOST_CHECK_EQUAL(reader.position(), i);
+    BOOST_CHECK_GT(reader.read_next(dest_ex, vw.example_parser->lbl_parser, vw.example_parser->_shared_data, true), 0);
+    check_same_features(src_ex, dest_ex);
+    BOOST_CHECK_CLOSE(src_ex.l.simple.label, dest_ex.l.simple.label, FLOAT_TOL);
+    check_collections_exact(src_ex.tag, dest_ex.tag);
+  }
+
+  example end_ex;
+  BOOST_CHECK_EQUAL(reader.read_next(end_ex, vw.example_parser->lbl_parser, vw.example_parser->_shared_data, true), 0);
+
+  std::remove(file_name.c_str());
+  VW::finish(vw);
+}
+
+BOOST_AUTO_TEST_CASE(mapped_cache_random_access)
+{
+  auto& vw = *VW::initialize("--quiet");
+  const std::string file_name = "mapped_cache_random_access_test.cache";
+  const std::vector<std::string> lines = {"1 |a x", "2 |b y z", "3 |c w:2"};
+  write_mapped_cache(vw, file_name, lines);
+
+  VW::mapped_cache_reader reader(file_name);
+
+  example last_ex;
+  reader.read_at(2, last_ex, vw.example_parser->lbl_parser, vw.example_parser->_shared_data, true);
+  BOOST_CHECK_CLOSE(last_ex.l.simple.label, 3.f, FLOAT_TOL);
+  BOOST_CHECK_EQUAL(reader.position(), 0);
+
+  reader.seek(1);
+  example middle_ex;
+  reader.read_next(middle_ex, vw.example_parser->lbl_parser, vw.example_parser->_shared_data, true);
+  BOOST_CHECK_CLOSE(middle_ex.l.simple.label, 2.f, FLOAT_TOL);
+  BOOST_CHECK_EQUAL(middle_ex.feature_space['b'].size(), 2);
+  BOOST_CHECK_EQUAL(reader.position(), 2);
+
+  BOOST_CHECK_THROW(reader.seek(4), VW::vw_exception);
+
+  std::remove(file_name.c_str());
+  VW::finish(vw);
+}
+
+BOOST_AUTO_TEST_CASE(mapped_cache_rejects_corrupt_records)
+{
+  auto& vw = *VW::initialize("--quiet");
+  const std::string file_name = "mapped_cache_corrupt_test.cache";
+  write_mapped_cache(vw, file_name, {"1 |a x y", "2 tag|b y z"});
+  const std::vector<char> good = read_file(file_name);
+
+  // The footer ends with the offset of the offset table and the magic, a record starts with its size, the label and
+  // tag sizes, and its first namespace header holds the feature count after 8 bytes.
+  const size_t index_offset = get<uint64_t>(good, good.size() - 2 * sizeof(uint64_t));
+  const size_t record = get<uint64_t>(good, index_offset + sizeof(uint64_t));
+  const size_t labels_end = 24 + get<uint32_t>(good, record + 8) + get<uint32_t>(good, record + 12);
+  const size_t first_namespace = record + (labels_end + 7) / 8 * 8;
+
+  auto check_corrupt = [&](size_t at, uint64_t value) {
+    std::vector<char> bytes = good;
+    put(bytes, at, value);
+    write_file(file_name, bytes);
+    VW::mapped_cache_reader reader(file_name);
+    auto& lbl_parser = vw.example_parser->lbl_parser;
+    example first_ex;
+    BOOST_CHECK_GT(reader.read_at(0, first_ex, lbl_parser, vw.example_parser->_shared_data, true), 0);
+    example ex;
+    BOOST_CHECK_THROW(reader.read_at(1, ex, lbl_parser, vw.example_parser->_shared_data, true), VW::vw_exception);
+  };
+  check_corrupt(index_offset + sizeof(uint64_t), good.size() * 2);  // offset past the end of the file
+  check_corrupt(index_offset + sizeof(uint64_t), index_offset);      // offset into the offset table
+  check_corrupt(record, uint64_t(1) << 40);                          // record size
+  check_corrupt(first_namespace + 8, uint64_t(1) << 61);            // feature count
+
+  std::vector<char> label = good;
+  put(label, record + 8, uint32_t(1) << 30);
+  write_file(file_name, label);
+  VW::mapped_cache_reader reader(file_name);
+  example ex;
+  BOOST_CHECK_THROW(
+      reader.read_at(1, ex, vw.example_parser->lbl_parser, vw.example_parser->_shared_data, true), VW::vw_exception);
+
+  std::remove(file_name.c_str());
+  VW::finish(vw);
+}
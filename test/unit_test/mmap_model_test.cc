@@ -0,0 +1,73 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+const std::vector<std::string> lines = {"1 |f a b c:2", "-1 |f d e:0.5", "1 |f a e", "-1 |f b d:3"};
+
+std::vector<float> predict_all(vw& all)
+{
+  std::vector<float> predictions;
+  for (const auto& line : lines)
+  {
+    example* ex = VW::read_example(all, line);
+    all.predict(*ex);
+    predictions.push_back(ex->pred.scalar);
+    VW::finish_example(all, *ex);
+  }
+  return predictions;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(mmap_model_round_trip)
+{
+  const std::string model_name = "mmap_model_test.model";
+  auto& trainer = *VW::initialize("--quiet -b 12 --mmap_model");
+  for (size_t pass = 0; pass < 5; ++pass)
+  {
+    for (const auto& line : lines)
+    {
+      example* ex = VW::read_example(trainer, line);
+      trainer.learn(*ex);
+      VW::finish_example(trainer, *ex);
+    }
+  }
+  const auto expected = predict_all(trainer);
+  VW::save_predictor(trainer, model_name);
+  VW::finish(trainer);
+
+  // The layout is kept in the model, so neither reader passes --mmap_model.
+  auto& server = *VW::initialize("--quiet -t -i " + model_name);
+  BOOST_CHECK(server.mmap_model);
+#ifndef _WIN32
+  BOOST_CHECK(server.weights.dense_weights.read_only());
+#endif
+  const auto served = predict_all(server);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), served.begin(), served.end());
+  VW::finish(server);
+
+  // A learning process copies the weights so it can update them.
+  auto& learner = *VW::initialize("--quiet -i " + model_name);
+  BOOST_CHECK(!learner.weights.dense_weights.read_only());
+  const auto copied = predict_all(learner);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), copied.begin(), copied.end());
+  VW::finish(learner);
+
+  std::remove(model_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(mmap_model_rejects_unsupported_setups)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --mmap_model --sparse_weights"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --mmap_model --save_resume"), VW::vw_exception);
+}
@@ -0,0 +1,163 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "model_segments.h"
+#include "io/io_adapter.h"
+#include "vw.h"
+#include "vw_exception.h"
+
+namespace
+{
+// More segments than one wave of the writer holds.
+constexpr size_t WEIGHT_COUNT = 16 * VW::MODEL_SEGMENT_WEIGHTS;
+
+// A few untrained weights and weights that repeat, so compression shrinks the segments.
+void fill(dense_parameters& weights, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i % 7 == 0) { continue; }
+    weight* w = &weights.strided_index(i);
+    w[0] = static_cast<float>(i % 13) - 6.5f;
+    w[1] = static_cast<float>(i % 5) + 1.f;
+  }
+}
+
+std::shared_ptr<std::vector<char>> write(dense_parameters& weights, uint32_t floats_per_weight, bool compress)
+{
+  auto buffer = std::make_shared<std::vector<char>>();
+  io_buf writer;
+  writer.add_file(VW::io::create_vector_writer(buffer));
+  VW::write_weight_segments(writer, weights, floats_per_weight, 4, compress);
+  writer.flush();
+  return buffer;
+}
+
+void read(const std::vector<char>& buffer, dense_parameters& weights)
+{
+  io_buf reader;
+  reader.add_file(VW::io::create_buffer_view(buffer.data(), buffer.size()));
+  VW::read_weight_segments(reader, weights, 3);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(model_segments_round_trip)
+{
+  // Also a table smaller than one segment.
+  for (size_t count : {WEIGHT_COUNT, static_cast<size_t>(1024)})
+  {
+    dense_parameters saved(count, 2);
+    fill(saved, count);
+
+    size_t raw_size = 0;
+    for (bool compress : {false, true})
+    {
+      const auto buffer = write(saved, 2, compress);
+      if (!compress) { raw_size = buffer->size(); }
+      else
+      {
+        BOOST_CHECK_LT(buffer->size(), raw_size);
+      }
+
+      dense_parameters loaded(count, 2);
+      read(*buffer, loaded);
+      BOOST_CHECK(std::equal(saved.first(), saved.first() + count * 4, loaded.first()));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(model_segments_change_stride)
+{
+  dense_parameters saved(WEIGHT_COUNT, 2);
+  fill(saved, WEIGHT_COUNT);
+  const auto buffer = write(saved, 1, true);
+
+  // Untrained weights keep their initial state, the others lose the floats that were not saved.
+  dense_parameters loaded(WEIGHT_COUNT, 1);
+  for (size_t i = 0; i < WEIGHT_COUNT * 2; i++) { loaded[i] = 0.5f; }
+  read(*buffer, loaded);
+  for (size_t i = 0; i < WEIGHT_COUNT; i++)
+  {
+    const weight* w = &loaded.strided_index(i);
+    BOOST_REQUIRE_EQUAL(w[0], i % 7 == 0 ? 0.5f : saved.strided_index(i));
+    BOOST_REQUIRE_EQUAL(w[1], i % 7 == 0 ? 0.5f : 0.f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(model_segments_detect_corruption)
+{
+  dense_parameters saved(WEIGHT_COUNT, 1);
+  fill(saved, WEIGHT_COUNT);
+
+  for (bool compress : {false, true})
+  {
+    const auto buffer = write(saved, 1, compress);
+
+    // A flipped bit in the payload of the second segment.
+    auto corrupted = *buffer;
+    corrupted[corrupted.size() / 2] ^= 0x10;
+    dense_parameters loaded(WEIGHT_COUNT, 1);
+    BOOST_CHECK_THROW(read(corrupted, loaded), VW::vw_exception);
+
+    // A truncated manifest.
+    auto truncated = *buffer;
+    truncated.resize(truncated.size() - 4);
+    BOOST_CHECK_THROW(read(truncated, loaded), VW::vw_exception);
+
+    // A table of a different size.
+    dense_parameters smaller(WEIGHT_COUNT / 2, 1);
+    BOOST_CHECK_THROW(read(*buffer, smaller), VW::vw_exception);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(model_segments_save_resume)
+{
+  const std::string model_name = "model_segments_test.model";
+  const std::vector<std::string> lines = {"1 |f a b c:2", "-1 |f d e:0.5", "1 |f a e", "-1 |f b d:3"};
+  auto learn_all = [&](vw& all) {
+    for (const auto& line : lines)
+    {
+      example* ex = VW::read_example(all, line);
+      all.learn(*ex);
+      VW::finish_example(all, *ex);
+    }
+  };
+  auto predict_all = [&](vw& all) {
+    std::vector<float> predictions;
+    for (const auto& line : lines)
+    {
+      example* ex = VW::read_example(all, line);
+      all.predict(*ex);
+      predictions.push_back(ex->pred.scalar);
+      VW::finish_example(all, *ex);
+    }
+    return predictions;
+  };
+
+  auto& trainer = *VW::initialize("--quiet -b 12 --save_resume --chunked_model --compress_model_segments");
+  learn_all(trainer);
+  VW::save_predictor(trainer, model_name);
+  learn_all(trainer);
+  const auto expected = predict_all(trainer);
+  VW::finish(trainer);
+
+  // The adaptive and normalized state is restored, so resuming matches learning without the checkpoint.
+  auto& resumed = *VW::initialize("--quiet --model_threads 2 -i " + model_name);
+  BOOST_CHECK(resumed.chunked_model);
+  learn_all(resumed);
+  const auto actual = predict_all(resumed);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+  VW::finish(resumed);
+
+  std::remove(model_name.c_str());
+}
@@ -0,0 +1,166 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <string>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+constexpr size_t COUNT = 4;
+
+const std::vector<std::string> lines = {
+    "|f a b c:2 |g x", "|f d e:0.5 |g y:3", "|f a e |g x y", "|f b d:3 |g z", "|f a:-1 c |g y"};
+
+// Trains COUNT regressors on every line, either with one multiupdate or with an update per regressor.
+std::vector<float> train(const std::string& args, bool fused)
+{
+  auto& all = *VW::initialize(args + " --quiet -b 14 --noconstant");
+  auto& base = *VW::LEARNER::as_singleline(all.l);
+  const size_t step = static_cast<size_t>(1) << all.weights.stride_shift();
+  std::vector<polyprediction> pred(COUNT);
+  std::vector<float> labels(COUNT);
+  for (size_t pass = 0; pass < 3; pass++)
+  {
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      example* ex = VW::read_example(all, lines[i]);
+      for (size_t c = 0; c < COUNT; c++) { labels[c] = (i + c) % 3 == 0 ? 1.f : -1.f; }
+      ex->l.simple = {labels[0]};
+      base.multipredict(*ex, 0, COUNT, pred.data(), true);
+      if (fused) { base.multiupdate(*ex, 0, COUNT, pred.data(), labels.data()); }
+      else
+      {
+        for (size_t c = 0; c < COUNT; c++)
+        {
+          ex->l.simple.label = labels[c];
+          ex->pred.scalar = pred[c].scalar;
+          base.update(*ex, c);
+        }
+      }
+      VW::finish_example(all, *ex);
+    }
+  }
+
+  std::vector<float> weights;
+  for (uint64_t i = 0; i < all.length(); i++) { weights.push_back(all.weights.dense_weights[i * step]); }
+  VW::finish(all);
+  return weights;
+}
+
+// Updates the hidden units below nn the way its backward pass does: one multiupdate per run of units that are updated,
+// or an update per unit.
+std::vector<float> train_nn_hidden_layer(const std::string& args, bool fused)
+{
+  auto& all = *VW::initialize(args + " --quiet -b 14 --noconstant --nn " + std::to_string(COUNT));
+  auto& base = *VW::LEARNER::as_singleline(all.l->get_learner_by_name_prefix("gd"));
+  const size_t step = static_cast<size_t>(1) << all.weights.stride_shift();
+  std::vector<polyprediction> pred(COUNT);
+  std::vector<float> labels(COUNT);
+  std::vector<bool> skipped(COUNT);
+  for (size_t pass = 0; pass < 3; pass++)
+  {
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      example* ex = VW::read_example(all, lines[i]);
+      ex->l.simple = {1.f};
+      base.multipredict(*ex, 0, COUNT, pred.data(), true);
+      for (size_t c = 0; c < COUNT; c++)
+      {
+        // Like a unit that is dropped out or whose target is its prediction, which nn doesn't update.
+        skipped[c] = (i + c + pass) % 3 == 1;
+        labels[c] = pred[c].scalar + (c % 2 == 0 ? 0.5f : -0.25f);
+      }
+      if (fused)
+      {
+        size_t run_start = 0;
+        for (size_t c = 0; c <= COUNT; c++)
+        {
+          if (c < COUNT && !skipped[c]) { continue; }
+          if (c > run_start)
+          { base.multiupdate(*ex, run_start, c - run_start, pred.data() + run_start, labels.data() + run_start); }
+          run_start = c + 1;
+        }
+      }
+      else
+      {
+        for (size_t c = 0; c < COUNT; c++)
+        {
+          if (skipped[c]) { continue; }
+          ex->l.simple.label = labels[c];
+          ex->pred.scalar = pred[c].scalar;
+          base.update(*ex, c);
+        }
+      }
+      VW::finish_example(all, *ex);
+    }
+  }
+
+  std::vector<float> weights;
+  for (uint64_t i = 0; i < all.length(); i++) { weights.push_back(all.weights.dense_weights[i * step]); }
+  VW::finish(all);
+  return weights;
+}
+
+void check_fused_matches_sequential(const std::string& args)
+{
+  const auto expected = train(args, false);
+  const auto actual = train(args, true);
+  BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++) { BOOST_CHECK_CLOSE(expected[i], actual[i], 0.001f); }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(multiupdate_matches_sequential_updates)
+{
+  check_fused_matches_sequential("");
+  check_fused_matches_sequential("-q fg");
+  check_fused_matches_sequential("--adaptive");
+  check_fused_matches_sequential("--normalized --invariant");
+  check_fused_matches_sequential("--sgd --loss_function logistic");
+}
+
+BOOST_AUTO_TEST_CASE(multiupdate_falls_back_with_regularization)
+{
+  check_fused_matches_sequential("--l2 0.001");
+}
+
+BOOST_AUTO_TEST_CASE(oaa_learns_with_multiupdate)
+{
+  auto& all = *VW::initialize("--quiet --oaa 3 -q fg");
+  const std::vector<std::string> labeled = {"1 |f a b |g x", "2 |f c d |g y", "3 |f e |g z"};
+  for (size_t pass = 0; pass < 10; pass++)
+  {
+    for (const auto& line : labeled)
+    {
+      example* ex = VW::read_example(all, line);
+      all.learn(*ex);
+      VW::finish_example(all, *ex);
+    }
+  }
+  for (size_t i = 0; i < labeled.size(); i++)
+  {
+    example* ex = VW::read_example(all, labeled[i].substr(2));
+    all.predict(*ex);
+    BOOST_CHECK_EQUAL(ex->pred.multiclass, i + 1);
+    VW::finish_example(all, *ex);
+  }
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(nn_hidden_layer_multiupdate_matches_sequential_updates)
+{
+  for (const std::string args : {"", "-q fg", "--sgd", "--inpass"})
+  {
+    // nn relies on the runs giving the same weights bit for bit as updating the units one at a time.
+    const auto expected = train_nn_hidden_layer(args, false);
+    const auto actual = train_nn_hidden_layer(args, true);
+    BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) { BOOST_CHECK_EQUAL(expected[i], actual[i]); }
+  }
+}
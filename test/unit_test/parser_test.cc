@@ -6,6 +6,13 @@
 #include <boost/test/test_tools.hpp>
 
 #include "parse_args.h"
+#include "parse_example.h"
+#include "parser.h"
+#include "vw.h"
+#include "io/io_adapter.h"
+
+#include <string>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(spoof_hex_encoded_namespace_test)
 {
@@ -15,3 +22,51 @@ BOOST_AUTO_TEST_CASE(spoof_hex_encoded_namespace_test)
   BOOST_CHECK_EQUAL(spoof_hex_encoded_namespaces("\\xab"), "\xab");
   BOOST_CHECK_EQUAL(spoof_hex_encoded_namespaces("\\x01 unrelated \\x56"), "\x01 unrelated \x56");
 }
+
+BOOST_AUTO_TEST_CASE(parse_threads_matches_serial_parse)
+{
+  const std::vector<std::string> lines = {"1 |a x y:2 z", "-1 'tag1 |a x |b w:0.5", "|c q r s", "", "0.5 2 |a x:3 |b y",
+      "1 |a z z z"};
+  std::string input;
+  for (const auto& line : lines) { input += line + "\n"; }
+
+  auto* serial = VW::initialize("--quiet --no_stdin");
+  auto* threaded = VW::initialize("--quiet --no_stdin --parse_threads 3");
+  threaded->example_parser->input->add_file(VW::io::create_buffer_view(input.data(), input.size()));
+  threaded->example_parser->reader = read_features_string_threaded;
+  threaded->example_parser->max_examples_per_read = lines.size();
+
+  v_array<example*> examples;
+  examples.push_back(&VW::get_unused_example(threaded));
+  BOOST_CHECK_EQUAL(threaded->example_parser->reader(threaded, examples), static_cast<int>(input.size()));
+  BOOST_REQUIRE_EQUAL(examples.size(), lines.size());
+
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    auto* expected = VW::read_example(*serial, lines[i]);
+    VW::setup_example(*threaded, examples[i]);
+
+    BOOST_CHECK_EQUAL(examples[i]->l.simple.label, expected->l.simple.label);
+    BOOST_CHECK_EQUAL(examples[i]->is_newline, expected->is_newline);
+    BOOST_CHECK_EQUAL(examples[i]->tag.size(), expected->tag.size());
+    BOOST_REQUIRE_EQUAL(examples[i]->indices.size(), expected->indices.size());
+    for (size_t ns = 0; ns < expected->indices.size(); ++ns)
+    {
+      BOOST_REQUIRE_EQUAL(examples[i]->indices[ns], expected->indices[ns]);
+      const auto& actual_fs = examples[i]->feature_space[examples[i]->indices[ns]];
+      const auto& expected_fs = expected->feature_space[expected->indices[ns]];
+      BOOST_REQUIRE_EQUAL(actual_fs.size(), expected_fs.size());
+      for (size_t f = 0; f < expected_fs.size(); ++f)
+      {
+        BOOST_CHECK_EQUAL(actual_fs.indicies[f], expected_fs.indicies[f]);
+        BOOST_CHECK_EQUAL(actual_fs.values[f], expected_fs.values[f]);
+      }
+    }
+
+    VW::finish_example(*serial, *expected);
+    VW::finish_example(*threaded, *examples[i]);
+  }
+
+  VW::finish(*serial);
+  VW::finish(*threaded);
+}
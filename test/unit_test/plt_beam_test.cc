@@ -0,0 +1,87 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+constexpr size_t NUM_LABELS = 60;
+const std::string model_name = "plt_beam_test.model";
+
+// Label l has the features a<l> and b<l / 4>, so labels with close numbers share features.
+std::string make_line(size_t i)
+{
+  const size_t l1 = i % NUM_LABELS;
+  const size_t l2 = (i * 7 + 3) % NUM_LABELS;
+  return std::to_string(l1) + "," + std::to_string(l2) + " |f a" + std::to_string(l1) + " b" + std::to_string(l1 / 4) +
+      " a" + std::to_string(l2) + " c" + std::to_string(i % 5);
+}
+
+void train_model()
+{
+  auto& all = *VW::initialize("--quiet --plt " + std::to_string(NUM_LABELS) + " --kary_tree 3");
+  for (size_t pass = 0; pass < 3; pass++)
+  {
+    for (size_t i = 0; i < 200; i++)
+    {
+      example* ex = VW::read_example(all, make_line(i));
+      all.learn(*ex);
+      VW::finish_example(all, *ex);
+    }
+  }
+  VW::save_predictor(all, model_name);
+  VW::finish(all);
+}
+
+std::vector<std::vector<uint32_t>> predict_top_k(const std::string& args)
+{
+  auto& all = *VW::initialize("--quiet -t -i " + model_name + " --top_k 3 " + args);
+  std::vector<std::vector<uint32_t>> predictions;
+  for (size_t i = 0; i < 100; i++)
+  {
+    example* ex = VW::read_example(all, make_line(i * 3));
+    all.predict(*ex);
+    const auto& labels = ex->pred.multilabels.label_v;
+    predictions.emplace_back(labels.begin(), labels.end());
+    VW::finish_example(all, *ex);
+  }
+  VW::finish(all);
+  return predictions;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(plt_beam_search_finds_top_k)
+{
+  train_model();
+  const auto exact = predict_top_k("");
+  // A beam as wide as a tree level never drops a node, so it finds the same labels as the exact search.
+  const auto wide = predict_top_k("--beam_width " + std::to_string(NUM_LABELS));
+  const auto narrow = predict_top_k("--beam_width 3");
+  std::remove(model_name.c_str());
+
+  BOOST_REQUIRE_EQUAL(exact.size(), wide.size());
+  size_t found = 0;
+  for (size_t i = 0; i < exact.size(); i++)
+  {
+    BOOST_CHECK_EQUAL_COLLECTIONS(exact[i].begin(), exact[i].end(), wide[i].begin(), wide[i].end());
+    BOOST_CHECK_EQUAL(narrow[i].size(), 3);
+    for (auto label : narrow[i]) { found += std::count(exact[i].begin(), exact[i].end(), label); }
+  }
+  // The narrow beam can miss some of the exact labels, but not most of them.
+  BOOST_CHECK_GT(found, exact.size() * 3 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(plt_beam_width_requires_top_k)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --plt 10 --beam_width 4"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --plt 10 --top_k 5 --beam_width 4"), VW::vw_exception);
+}
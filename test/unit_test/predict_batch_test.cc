@@ -0,0 +1,181 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "vw.h"
+#include "parser.h"
+
+namespace
+{
+const std::vector<std::string> lines = {"1 |f a b c:2", "-1 |f d e:0.5", "|f a e", "-1 |f b d:3", "|f"};
+
+vw& train(const std::string& args)
+{
+  auto& all = *VW::initialize(args + " --quiet");
+  for (size_t pass = 0; pass < 5; pass++)
+  {
+    for (const auto& line : {"1 |f a b", "-1 |f c d", "1 |f a e:2"})
+    {
+      example* ex = VW::read_example(all, line);
+      all.learn(*ex);
+      VW::finish_example(all, *ex);
+    }
+  }
+  return all;
+}
+
+std::vector<float> predict_one_at_a_time(vw& all)
+{
+  std::vector<float> predictions;
+  for (const auto& line : lines)
+  {
+    example* ex = VW::read_example(all, line);
+    all.predict(*ex);
+    predictions.push_back(VW::get_prediction(ex));
+    VW::finish_example(all, *ex);
+  }
+  return predictions;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(predict_batch_matches_single_predictions)
+{
+  auto& all = train("-q ff");
+  const auto expected = predict_one_at_a_time(all);
+
+  std::string buffer;
+  for (const auto& line : lines) { buffer += line + "\n"; }
+  std::vector<float> from_lines(lines.size());
+  BOOST_CHECK_EQUAL(VW::predict_batch(all, buffer.data(), buffer.size(), from_lines.data(), from_lines.size()),
+      lines.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), from_lines.begin(), from_lines.end());
+
+  std::vector<example*> examples;
+  for (const auto& line : lines) { examples.push_back(VW::read_example(all, line)); }
+  std::vector<float> from_examples(lines.size());
+  VW::predict_batch(all, examples.data(), examples.size(), from_examples.data());
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), from_examples.begin(), from_examples.end());
+  for (auto* ex : examples) { VW::finish_example(all, *ex); }
+
+  // Without the trailing newline.
+  buffer.pop_back();
+  size_t consumed = 0;
+  BOOST_CHECK_EQUAL(
+      VW::predict_batch(all, buffer.data(), buffer.size(), from_lines.data(), from_lines.size(), &consumed),
+      lines.size());
+  BOOST_CHECK_EQUAL(consumed, buffer.size());
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(predict_batch_stops_at_max_predictions)
+{
+  auto& all = train("");
+  const auto expected = predict_one_at_a_time(all);
+  std::string buffer;
+  for (const auto& line : lines) { buffer += line + "\n"; }
+
+  // The rest of the buffer is left for the next call.
+  std::vector<float> predictions(lines.size());
+  size_t consumed = 0;
+  BOOST_CHECK_EQUAL(VW::predict_batch(all, buffer.data(), buffer.size(), predictions.data(), 2, &consumed), 2);
+  BOOST_CHECK_EQUAL(consumed, lines[0].size() + lines[1].size() + 2);
+  size_t rest = 0;
+  BOOST_CHECK_EQUAL(VW::predict_batch(all, buffer.data() + consumed, buffer.size() - consumed, predictions.data() + 2,
+                        lines.size() - 2, &rest),
+      lines.size() - 2);
+  BOOST_CHECK_EQUAL(consumed + rest, buffer.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), predictions.begin(), predictions.end());
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(predict_batch_counts_the_lines_before_an_error)
+{
+  auto& all = *VW::initialize("--quiet --strict_parse");
+  const std::string buffer = "|f a\n|f b\n|f c:nan\n|f d\n";
+  std::vector<float> predictions(4);
+  size_t consumed = 0;
+  size_t written = 0;
+  BOOST_CHECK_THROW(
+      VW::predict_batch(all, buffer.data(), buffer.size(), predictions.data(), predictions.size(), &consumed, &written),
+      VW::strict_parse_exception);
+  BOOST_CHECK_EQUAL(written, 2);
+  BOOST_CHECK_EQUAL(consumed, buffer.find("|f c"));
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(predict_batch_leaves_the_pass_alone)
+{
+  const std::string data_file = "predict_batch_test.dat";
+  const std::string cache_file = "predict_batch_test.cache";
+  std::ofstream(data_file) << "1 |f a b\n-1 |f c d\n";
+  auto& all = *VW::initialize("--quiet -d " + data_file + " --cache_file " + cache_file);
+  BOOST_REQUIRE(all.example_parser->write_cache);
+  all.example_parser->output->flush();
+  const auto cache_size = [&cache_file] {
+    return static_cast<std::streamoff>(std::ifstream(cache_file + ".writing", std::ios::ate).tellg());
+  };
+  const auto size_before = cache_size();
+  const auto counter_before = all.example_parser->in_pass_counter;
+
+  std::string buffer;
+  for (const auto& line : lines) { buffer += line + "\n"; }
+  std::vector<float> predictions(lines.size());
+  VW::predict_batch(all, buffer.data(), buffer.size(), predictions.data(), predictions.size());
+
+  all.example_parser->output->flush();
+  BOOST_CHECK_EQUAL(cache_size(), size_before);
+  BOOST_CHECK_EQUAL(all.example_parser->in_pass_counter, counter_before);
+  VW::finish(all);
+  std::remove(data_file.c_str());
+  std::remove(cache_file.c_str());
+  std::remove((cache_file + ".writing").c_str());
+}
+
+BOOST_AUTO_TEST_CASE(predict_batch_keeps_test_only)
+{
+  auto& all = train("");
+  example* ex = VW::read_example(all, "1 |f a b");
+  ex->test_only = false;
+  float prediction = 0.f;
+  VW::predict_batch(all, &ex, 1, &prediction);
+  BOOST_CHECK(!ex->test_only);
+  VW::finish_example(all, *ex);
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(predict_batch_writes_multiclass_predictions)
+{
+  auto& all = *VW::initialize("--quiet --oaa 3");
+  for (size_t pass = 0; pass < 10; pass++)
+  {
+    for (const auto& line : {"1 |f a", "2 |f b", "3 |f c"})
+    {
+      example* ex = VW::read_example(all, line);
+      all.learn(*ex);
+      VW::finish_example(all, *ex);
+    }
+  }
+  const std::string buffer = "|f a\n|f b\n|f c\n";
+  std::vector<float> predictions(3);
+  BOOST_CHECK_EQUAL(VW::predict_batch(all, buffer.data(), buffer.size(), predictions.data(), 3), 3u);
+  BOOST_CHECK_EQUAL(predictions[0], 1.f);
+  BOOST_CHECK_EQUAL(predictions[1], 2.f);
+  BOOST_CHECK_EQUAL(predictions[2], 3.f);
+  VW::finish(all);
+}
+
+BOOST_AUTO_TEST_CASE(predict_batch_rejects_multiline_learners)
+{
+  auto& all = *VW::initialize("--quiet --cb_adf");
+  float prediction = 0.f;
+  BOOST_CHECK_THROW(VW::predict_batch(all, "|a x", 4, &prediction, 1), VW::vw_exception);
+  VW::finish(all);
+}
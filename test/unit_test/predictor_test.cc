@@ -0,0 +1,91 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "predictor.h"
+#include "vw.h"
+
+namespace
+{
+std::vector<std::string> make_lines()
+{
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < 200; i++)
+  {
+    lines.push_back(std::to_string(i % 2 == 0 ? 1 : -1) + " 'tag" + std::to_string(i) + " |f a" + std::to_string(i % 7) +
+        " b:" + std::to_string(i % 5) + " |g c" + std::to_string(i % 3));
+  }
+  return lines;
+}
+
+vw& train(const std::string& args, const std::vector<std::string>& lines)
+{
+  auto& all = *VW::initialize(args + " --quiet");
+  for (const auto& line : lines)
+  {
+    example* ex = VW::read_example(all, line);
+    all.learn(*ex);
+    VW::finish_example(all, *ex);
+  }
+  return all;
+}
+
+void check_threads_match_serial(const std::string& args)
+{
+  const auto lines = make_lines();
+  auto& all = train(args, lines);
+  std::vector<float> expected;
+  for (const auto& line : lines)
+  {
+    example* ex = VW::read_example(all, line);
+    all.predict(*ex);
+    expected.push_back(ex->pred.scalar);
+    VW::finish_example(all, *ex);
+  }
+
+  const VW::predictor predictor(all);
+  constexpr size_t NUM_THREADS = 8;
+  std::vector<std::vector<float>> actual(NUM_THREADS);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < NUM_THREADS; t++)
+  {
+    threads.emplace_back([&predictor, &lines, &actual, t] {
+      VW::predictor::scratch scratch;
+      for (size_t pass = 0; pass < 5; pass++)
+      {
+        actual[t].clear();
+        for (const auto& line : lines) { actual[t].push_back(predictor.predict(line, scratch)); }
+      }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+  for (const auto& predictions : actual)
+  { BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), predictions.begin(), predictions.end()); }
+  VW::finish(all);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(predictor_matches_serial_predictions_from_many_threads)
+{
+  check_threads_match_serial("");
+  check_threads_match_serial("-q fg --link logistic --loss_function logistic");
+  check_threads_match_serial("--ignore g --noconstant -b 10");
+  check_threads_match_serial("--l1 0.0001");
+}
+
+BOOST_AUTO_TEST_CASE(predictor_rejects_unsupported_setups)
+{
+  for (const auto& args : {"--oaa 3", "--sparse_weights", "--ngram f2", "--audit"})
+  {
+    auto& all = *VW::initialize(std::string(args) + " --quiet");
+    BOOST_CHECK_THROW(VW::predictor predictor(all), VW::vw_exception);
+    VW::finish(all);
+  }
+}
@@ -0,0 +1,69 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <string>
+#include <vector>
+
+#include "vw.h"
+
+namespace
+{
+using multi_line = std::vector<std::string>;
+
+const std::vector<multi_line> multi_lines = {
+    {"shared |s a b c:2 |t u", "0:1:0.5 |a x y", "|a y z:0.5", "|a x"},
+    {"shared |s b d |t v:3", "|a x", "0:-1:0.5 |a y", "|a z |b w"},
+    {"shared |s a d:0.5", "|a x z", "|a y", "0:0.5:0.5 |b w"},
+    // An action that has a namespace of the shared example falls back to merging.
+    {"shared |s c |t u", "0:1:0.5 |a x |s e", "|a y"},
+};
+
+// Action scores for every multi-example of every pass.
+std::vector<float> run(const std::string& args)
+{
+  auto& all = *VW::initialize(args + " --quiet");
+  std::vector<float> scores;
+  for (size_t pass = 0; pass < 4; pass++)
+  {
+    for (const auto& lines : multi_lines)
+    {
+      multi_ex examples;
+      for (const auto& line : lines) { examples.push_back(VW::read_example(all, line)); }
+      all.learn(examples);
+      for (const auto& a_s : examples[0]->pred.a_s) { scores.push_back(a_s.score); }
+      all.finish_example(examples);
+    }
+  }
+  VW::finish(all);
+  return scores;
+}
+
+void check_cached_matches_merged(const std::string& args)
+{
+  const auto expected = run(args);
+  const auto actual = run(args + " --cache_shared_context");
+  BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++) { BOOST_CHECK_CLOSE(expected[i], actual[i], 0.01f); }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(shared_context_matches_merged_features)
+{
+  check_cached_matches_merged("--cb_adf");
+  check_cached_matches_merged("--cb_adf -q sa -q st");
+  check_cached_matches_merged("--cb_adf --cb_type mtr -q sa --cubic sta");
+  check_cached_matches_merged("--cb_adf --noconstant -q sa --ignore_linear s");
+  check_cached_matches_merged("--cb_explore_adf --bag 3 -q sa -q ss");
+}
+
+BOOST_AUTO_TEST_CASE(shared_context_rejects_unsupported_setups)
+{
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_adf --sgd --cache_shared_context"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_adf --audit --cache_shared_context"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_explore_adf --rnd 1 --cache_shared_context"), VW::vw_exception);
+  BOOST_CHECK_THROW(VW::initialize("--quiet --cb_adf -q s: --cache_shared_context"), VW::vw_exception);
+}
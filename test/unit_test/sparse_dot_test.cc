@@ -0,0 +1,101 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu_features.h"
+#include "rand48.h"
+#include "sparse_dot.h"
+
+namespace
+{
+struct sparse_vector
+{
+  std::vector<uint64_t> indices;
+  std::vector<float> values;
+};
+
+// Every index below range is present with probability density.
+sparse_vector make_sparse(uint64_t& seed, uint64_t range, float density)
+{
+  sparse_vector v;
+  for (uint64_t i = 0; i < range; i++)
+  {
+    if (merand48(seed) < density)
+    {
+      v.indices.push_back(i);
+      v.values.push_back(merand48(seed) * 4.f - 2.f);
+    }
+  }
+  return v;
+}
+
+float merge_dot(const sparse_vector& v1, const sparse_vector& v2, float dot)
+{
+  for (size_t i = 0, j = 0; i < v1.indices.size() && j < v2.indices.size();)
+  {
+    if (v1.indices[i] < v2.indices[j]) { ++i; }
+    else if (v2.indices[j] < v1.indices[i])
+    {
+      ++j;
+    }
+    else
+    {
+      dot += v1.values[i++] * v2.values[j++];
+    }
+  }
+  return dot;
+}
+
+// The vectorized path needs AVX2, elsewhere the test is reported as skipped instead of passing without checking.
+boost::test_tools::assertion_result has_vectorized_sparse_dot(boost::unit_test::test_unit_id)
+{
+  boost::test_tools::assertion_result available(VW::get_cpu_features().avx2);
+  available.message() << "this machine has no vectorized sparse_dot";
+  return available;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(sparse_dot_matches_merge, *boost::unit_test::precondition(has_vectorized_sparse_dot))
+{
+  uint64_t seed = 7;
+  for (uint64_t range : {0, 3, 9, 64, 1000})
+  {
+    for (float density1 : {0.05f, 0.3f, 0.9f})
+    {
+      for (float density2 : {0.05f, 0.5f, 1.f})
+      {
+        const auto v1 = make_sparse(seed, range, density1);
+        const auto v2 = make_sparse(seed, range, density2);
+        float dot = 1.f;
+        BOOST_REQUIRE(VW::sparse_dot(v1.indices.data(), v1.values.data(), v1.indices.size(), v2.indices.data(),
+            v2.values.data(), v2.indices.size(), dot));
+        // The products are added in the same order, so the sums are the same bit for bit.
+        BOOST_CHECK_EQUAL(dot, merge_dot(v1, v2, 1.f));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sparse_dot_falls_back_to_the_merge)
+{
+  uint64_t seed = 11;
+  const auto v1 = make_sparse(seed, 100, 0.5f);
+  const auto v2 = make_sparse(seed, 100, 0.5f);
+  float dot = 1.f;
+  const bool vectorized = VW::sparse_dot(v1.indices.data(), v1.values.data(), v1.indices.size(), v2.indices.data(),
+      v2.values.data(), v2.indices.size(), dot);
+  // Without a vectorized implementation dot is left for the caller's merge loop, which then gives the same sum.
+  BOOST_CHECK_EQUAL(vectorized, VW::get_cpu_features().avx2);
+  if (!vectorized)
+  {
+    BOOST_CHECK_EQUAL(dot, 1.f);
+    dot = merge_dot(v1, v2, dot);
+  }
+  BOOST_CHECK_EQUAL(dot, merge_dot(v1, v2, 1.f));
+}
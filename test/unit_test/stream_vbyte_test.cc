@@ -0,0 +1,64 @@
+#ifndef STATIC_LINK_VW
+#  define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "stream_vbyte.h"
+
+namespace
+{
+std::vector<uint32_t> make_values(size_t count)
+{
+  std::vector<uint32_t> values;
+  uint32_t state = 12345;
+  for (size_t i = 0; i < count; i++)
+  {
+    state = state * 1103515245 + 12345;
+    // Cycle through 1, 2, 3 and 4 byte values.
+    values.push_back(state >> (8 * (3 - i % 4)));
+  }
+  return values;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(stream_vbyte_round_trip)
+{
+  for (size_t count = 0; count < 70; count++)
+  {
+    const auto values = make_values(count);
+    std::vector<char> encoded(VW::svb::max_encoded_size(count));
+    const char* end = VW::svb::encode(values.data(), count, encoded.data());
+
+    std::vector<uint32_t> decoded(count);
+    std::vector<uint32_t> decoded_scalar(count);
+    BOOST_CHECK(VW::svb::decode(encoded.data(), end, count, decoded.data()) == end);
+    BOOST_CHECK(VW::svb::decode_scalar(encoded.data(), end, count, decoded_scalar.data()) == end);
+    BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), decoded.begin(), decoded.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), decoded_scalar.begin(), decoded_scalar.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stream_vbyte_small_values_use_one_byte)
+{
+  const std::vector<uint32_t> values = {0, 1, 2, 255, 7, 9, 100, 3};
+  std::vector<char> encoded(VW::svb::max_encoded_size(values.size()));
+  const char* end = VW::svb::encode(values.data(), values.size(), encoded.data());
+  BOOST_CHECK_EQUAL(end - encoded.data(), VW::svb::control_size(values.size()) + values.size());
+}
+
+BOOST_AUTO_TEST_CASE(stream_vbyte_truncated_input)
+{
+  const auto values = make_values(40);
+  std::vector<char> encoded(VW::svb::max_encoded_size(values.size()));
+  const char* end = VW::svb::encode(values.data(), values.size(), encoded.data());
+
+  std::vector<uint32_t> decoded(values.size());
+  BOOST_CHECK(VW::svb::decode(encoded.data(), end - 1, values.size(), decoded.data()) == nullptr);
+  BOOST_CHECK(VW::svb::decode_scalar(encoded.data(), end - 1, values.size(), decoded.data()) == nullptr);
+  BOOST_CHECK(VW::svb::decode(encoded.data(), encoded.data() + 2, values.size(), decoded.data()) == nullptr);
+}
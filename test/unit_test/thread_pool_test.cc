@@ -0,0 +1,51 @@
+#ifndef STATIC_LINK_VW
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include "thread_pool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(thread_pool_runs_every_index_once)
+{
+  VW::thread_pool pool(4);
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+
+  for (size_t count : {0, 1, 3, 100})
+  {
+    std::vector<std::atomic<int>> hits(count);
+    for (auto& hit : hits) { hit = 0; }
+    pool.parallel_for(count, [&](size_t i) { hits[i]++; });
+    for (auto& hit : hits) { BOOST_CHECK_EQUAL(hit.load(), 1); }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_ranges_cover_input)
+{
+  VW::thread_pool pool(3);
+  std::vector<int> values(10, 0);
+  pool.parallel_for_ranges(values.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) { values[i] += static_cast<int>(i); }
+  });
+  for (size_t i = 0; i < values.size(); ++i) { BOOST_CHECK_EQUAL(values[i], static_cast<int>(i)); }
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_rethrows_task_exception)
+{
+  VW::thread_pool pool(2);
+  BOOST_CHECK_THROW(pool.parallel_for(8,
+                        [](size_t i) {
+                          if (i == 5) { throw std::runtime_error("task failed"); }
+                        }),
+      std::runtime_error);
+
+  // The pool is still usable afterwards.
+  std::atomic<size_t> sum{0};
+  pool.parallel_for(4, [&](size_t i) { sum += i; });
+  BOOST_CHECK_EQUAL(sum.load(), 6);
+}
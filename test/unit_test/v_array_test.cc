@@ -297,3 +297,58 @@ BOOST_AUTO_TEST_CASE(v_array_insert_range_empty_end)
   BOOST_CHECK_EQUAL(1, list[0]);
   BOOST_CHECK_EQUAL(2, list[1]);
 }
+
+BOOST_AUTO_TEST_CASE(v_array_borrow)
+{
+  int buffer[4] = {7, 8, 0, 0};
+  v_array<int> list;
+  list.push_back(1);
+  list.borrow(buffer, 2, 4);
+
+  BOOST_CHECK(list.borrowed());
+  BOOST_CHECK_EQUAL(std::size_t(2), list.size());
+  BOOST_CHECK_EQUAL(std::size_t(4), list.capacity());
+  list.push_back(9);
+  list.push_back(10);
+  BOOST_CHECK_EQUAL(buffer, list.begin());
+  BOOST_CHECK_EQUAL(10, buffer[3]);
+
+  list.shrink_to_fit();
+  BOOST_CHECK(list.borrowed());
+  BOOST_CHECK_EQUAL(std::size_t(4), list.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(v_array_borrow_grow_moves_out)
+{
+  int buffer[2] = {1, 2};
+  v_array<int> list;
+  list.borrow(buffer, 2, 2);
+  list.push_back(3);
+
+  BOOST_CHECK(!list.borrowed());
+  BOOST_CHECK_NE(buffer, list.begin());
+  BOOST_CHECK_EQUAL(std::size_t(3), list.size());
+  BOOST_CHECK_EQUAL(1, list[0]);
+  BOOST_CHECK_EQUAL(2, list[1]);
+  BOOST_CHECK_EQUAL(3, list[2]);
+  // The buffer is left as it was.
+  list[0] = 5;
+  BOOST_CHECK_EQUAL(1, buffer[0]);
+}
+
+BOOST_AUTO_TEST_CASE(v_array_borrow_move_and_copy)
+{
+  int buffer[3] = {4, 5, 6};
+  v_array<int> list;
+  list.borrow(buffer, 3, 3);
+
+  v_array<int> copy(list);
+  BOOST_CHECK(!copy.borrowed());
+  BOOST_CHECK_NE(buffer, copy.begin());
+  BOOST_CHECK_EQUAL(6, copy[2]);
+
+  v_array<int> moved(std::move(list));
+  BOOST_CHECK(moved.borrowed());
+  BOOST_CHECK(!list.borrowed());
+  BOOST_CHECK_EQUAL(buffer, moved.begin());
+}
@@ -5,8 +5,13 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/vector.hpp>
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "array_parameters.h"
 #include "array_parameters_dense.h"
+#include "vw.h"
 
 #include "test_common.h"
 
@@ -26,3 +31,120 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_default_function_weight_initialization_stride
   }
 }
 
+
+BOOST_AUTO_TEST_CASE(test_dense_weights_with_page_options_are_zeroed)
+{
+  for (auto mode : {VW::huge_page_mode::none, VW::huge_page_mode::transparent, VW::huge_page_mode::huge_2mb})
+  {
+    VW::page_options options;
+    options.huge_pages = mode;
+    options.numa = VW::numa_mode::interleave;
+    dense_parameters w(LENGTH, STRIDE_SHIFT, options);
+    BOOST_CHECK(w.pages().data != nullptr);
+    BOOST_CHECK_GE(w.pages().length, (LENGTH << STRIDE_SHIFT) * sizeof(weight));
+    BOOST_CHECK_GT(w.pages().page_size, 0);
+    for (size_t i = 0; i < LENGTH; i++) { BOOST_CHECK_EQUAL(w.strided_index(i), 0.f); }
+    w.strided_index(3) = 2.f;
+    BOOST_CHECK_EQUAL(w.strided_index(3), 2.f);
+  }
+
+  BOOST_CHECK_THROW(VW::parse_huge_page_mode("4k"), VW::vw_exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_page_allocation_failures_are_reported)
+{
+  VW::page_options options;
+  options.huge_pages = VW::huge_page_mode::transparent;
+  VW::page_region region;
+  BOOST_CHECK(VW::try_allocate_pages(size_t(1) << 60, options, false, region) == VW::page_status::out_of_memory);
+  BOOST_CHECK(region.data == nullptr);
+  BOOST_CHECK_THROW(VW::allocate_pages(size_t(1) << 60, options, false), VW::vw_exception);
+
+  BOOST_REQUIRE(VW::try_allocate_pages(LENGTH, options, false, region) == VW::page_status::ok);
+  BOOST_CHECK(region.data != nullptr);
+  VW::free_pages(region);
+}
+
+BOOST_AUTO_TEST_CASE(test_sparse_weights_grow_and_keep_references)
+{
+  constexpr size_t count = 100000;
+  sparse_parameters w(static_cast<size_t>(1) << 20, STRIDE_SHIFT);
+  w.set_default([](weight* weights, uint64_t index) { weights[1] = 1.f * index; });
+
+  // Hashed feature indices are scattered over the table.
+  auto index_of = [](size_t i) { return (i * 2654435761ULL) % (static_cast<size_t>(1) << 20); };
+  weight& first = w.strided_index(index_of(0));
+  first = 7.f;
+  for (size_t i = 1; i < count; i++) { w.strided_index(index_of(i)) = 1.f * i; }
+
+  // References survive the table growing.
+  BOOST_CHECK_EQUAL(first, 7.f);
+  BOOST_CHECK_EQUAL(w.size(), count);
+  for (size_t i = 1; i < count; i++)
+  {
+    BOOST_REQUIRE_EQUAL(w.strided_index(index_of(i)), 1.f * i);
+    BOOST_REQUIRE_EQUAL((&w.strided_index(index_of(i)))[1], 1.f * (index_of(i) << STRIDE_SHIFT));
+  }
+  BOOST_CHECK_EQUAL(w.size(), count);
+
+  // Iteration visits every block once, in insertion order.
+  size_t visited = 0;
+  for (auto it = w.begin(); it != w.end(); ++it, ++visited)
+  {
+    BOOST_REQUIRE_EQUAL(it.index(), index_of(visited) << STRIDE_SHIFT);
+    BOOST_REQUIRE_EQUAL(*it, visited == 0 ? 7.f : 1.f * visited);
+  }
+  BOOST_CHECK_EQUAL(visited, count);
+
+  w.set_zero(1);
+  BOOST_CHECK_EQUAL((&w.strided_index(index_of(5)))[1], 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_seeded_sparse_weights_from_two_threads)
+{
+  auto* seed = VW::initialize("--quiet --sparse_weights -b 18");
+  for (int i = 0; i < 50; i++)
+  {
+    auto* ex = VW::read_example(*seed, std::string(i % 2 ? "1" : "-1") + " |f a b" + std::to_string(i % 5));
+    seed->learn(*ex);
+    VW::finish_example(*seed, *ex);
+  }
+  vw* copies[] = {VW::seed_vw_model(seed, ""), VW::seed_vw_model(seed, "")};
+
+  // Predicting reads unseen weights, which inserts them, so the copies grow their tables at the same time.
+  std::vector<std::vector<example*>> examples(2);
+  for (int t = 0; t < 2; t++)
+  {
+    for (int i = 0; i < 2000; i++)
+    {
+      auto line = "|f a b" + std::to_string(i % 5) + " t" + std::to_string(t) + "_" + std::to_string(i);
+      examples[t].push_back(VW::read_example(*copies[t], line));
+    }
+  }
+  const size_t seed_size = seed->weights.sparse_weights.size();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; t++)
+  {
+    threads.emplace_back([&, t] {
+      for (auto* ex : examples[t]) { copies[t]->predict(*ex); }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+
+  // Unseen features have zero weight, so the copies predict what the seed learned.
+  for (int t = 0; t < 2; t++)
+  {
+    for (int i = 0; i < 2000; i++)
+    {
+      auto* ex = VW::read_example(*seed, "|f a b" + std::to_string(i % 5));
+      seed->predict(*ex);
+      BOOST_REQUIRE_EQUAL(examples[t][i]->pred.scalar, ex->pred.scalar);
+      VW::finish_example(*seed, *ex);
+      VW::finish_example(*copies[t], *examples[t][i]);
+    }
+    BOOST_CHECK_GT(copies[t]->weights.sparse_weights.size(), seed_size);
+    VW::finish(*copies[t]);
+  }
+  BOOST_CHECK_EQUAL(seed->weights.sparse_weights.size(), seed_size);
+  VW::finish(*seed);
+}
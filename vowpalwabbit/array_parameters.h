@@ -4,9 +4,12 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <vector>
 
 #ifndef _WIN32
 #  define NOMINMAX
@@ -22,15 +25,163 @@
 #include "array_parameters_dense.h"
 #include "vw_exception.h"
 
-class sparse_parameters;
-typedef std::unordered_map<uint64_t, weight*> weight_map;
+// Open addressing table from a weight index to its block of stride weights, replacing a node based map with a
+// separate allocation per block. The blocks are carved out of slabs and never move, so a weight reference stays valid
+// while the table grows. A full table is resized incrementally: the entries of the old slots are moved a few at a time
+// by later insertions, and lookups check both sets of slots until the move is done.
+class sparse_weight_table
+{
+public:
+  explicit sparse_weight_table(uint32_t stride) : _stride(stride) {}
+
+  ~sparse_weight_table()
+  {
+    for (weight* slab : _slabs) { free(slab); }
+  }
+
+  // A copy with blocks and slots of its own.
+  sparse_weight_table(const sparse_weight_table& other) : _stride(other._stride)
+  {
+    bool inserted;
+    for (size_t n = 0; n < other.size(); ++n)
+    { std::memcpy(find_or_insert(other.index_of(n), inserted), other.block(n), _stride * sizeof(weight)); }
+  }
+
+  sparse_weight_table& operator=(const sparse_weight_table&) = delete;
+
+  // Weights per block. Only takes effect while the table is empty.
+  void set_stride(uint32_t stride)
+  {
+    if (size() == 0) { _stride = stride; }
+  }
+
+  // The block of index, or nullptr if it was never inserted.
+  weight* find(uint64_t index) const
+  {
+    weight* block = probe(_slots, _shift, index);
+    if (block == nullptr && !_old_slots.empty()) { block = probe(_old_slots, _shift + 1, index); }
+    return block;
+  }
+
+  // The block of index, inserting a zeroed one if it was never inserted.
+  weight* find_or_insert(uint64_t index, bool& inserted)
+  {
+    inserted = false;
+    weight* block = find(index);
+    if (block != nullptr) { return block; }
+
+    if (size() + 1 > _slots.size() / 2) { grow(); }
+    migrate(MIGRATE_STEP);
+
+    inserted = true;
+    block = allocate_block(index);
+    place(_slots, _shift, index, block);
+    return block;
+  }
+
+  size_t size() const { return _block_index.size(); }
+
+  // Blocks are numbered in insertion order.
+  weight* block(size_t n) const { return _slabs[n >> SLAB_SHIFT] + (n & (SLAB_BLOCKS - 1)) * _stride; }
+
+  uint64_t index_of(size_t n) const { return _block_index[n]; }
+
+private:
+  struct slot
+  {
+    uint64_t index;
+    weight* block;  // nullptr for an empty slot
+  };
+
+  static constexpr size_t SLAB_SHIFT = 12;
+  static constexpr size_t SLAB_BLOCKS = static_cast<size_t>(1) << SLAB_SHIFT;
+  static constexpr size_t MIN_SLOTS = 16;
+  // Old slots moved per insertion. The slots double on growth at half load, so the move finishes long before the
+  // next growth.
+  static constexpr size_t MIGRATE_STEP = 8;
+
+  std::vector<slot> _slots;
+  std::vector<slot> _old_slots;  // slots being moved into _slots, with twice as many entries as _slots per bucket
+  size_t _migrated = 0;          // old slots moved so far
+  uint32_t _shift = 64;          // 64 - log2(_slots.size())
+  uint32_t _stride;
+  std::vector<weight*> _slabs;
+  std::vector<uint64_t> _block_index;
+
+  // Fibonacci hashing. Indices are multiples of the stride, so their low bits can't be used directly.
+  static size_t bucket(uint64_t index, uint32_t shift)
+  {
+    return static_cast<size_t>((index * 0x9E3779B97F4A7C15ULL) >> shift);
+  }
+
+  static weight* probe(const std::vector<slot>& slots, uint32_t shift, uint64_t index)
+  {
+    if (slots.empty()) { return nullptr; }
+    const size_t mask = slots.size() - 1;
+    for (size_t i = bucket(index, shift);; i = (i + 1) & mask)
+    {
+      const slot& s = slots[i];
+      if (s.block == nullptr) { return nullptr; }
+      if (s.index == index) { return s.block; }
+    }
+  }
+
+  static void place(std::vector<slot>& slots, uint32_t shift, uint64_t index, weight* block)
+  {
+    const size_t mask = slots.size() - 1;
+    size_t i = bucket(index, shift);
+    while (slots[i].block != nullptr) { i = (i + 1) & mask; }
+    slots[i].index = index;
+    slots[i].block = block;
+  }
+
+  void grow()
+  {
+    // Finish a move that is still in progress, only one old set of slots is kept.
+    migrate(_old_slots.size());
+    if (_slots.empty())
+    {
+      _slots.assign(MIN_SLOTS, slot{0, nullptr});
+      _shift = 64 - 4;
+      return;
+    }
+    _old_slots.swap(_slots);
+    _slots.assign(_old_slots.size() * 2, slot{0, nullptr});
+    _shift -= 1;
+    _migrated = 0;
+  }
+
+  void migrate(size_t count)
+  {
+    if (_old_slots.empty()) { return; }
+    const size_t end = std::min(_old_slots.size(), _migrated + count);
+    for (; _migrated < end; ++_migrated)
+    {
+      const slot& s = _old_slots[_migrated];
+      if (s.block != nullptr) { place(_slots, _shift, s.index, s.block); }
+    }
+    if (_migrated == _old_slots.size())
+    {
+      std::vector<slot>().swap(_old_slots);
+      _migrated = 0;
+    }
+  }
+
+  weight* allocate_block(uint64_t index)
+  {
+    const size_t n = size();
+    if ((n >> SLAB_SHIFT) == _slabs.size()) { _slabs.push_back(calloc_mergable_or_throw<weight>(SLAB_BLOCKS * _stride)); }
+    _block_index.push_back(index);
+    return block(n);
+  }
+};
 
 template <typename T>
 class sparse_iterator
 {
 private:
-  weight_map::iterator _iter;
-  uint32_t _stride;
+  const sparse_weight_table* _table;
+  size_t _block;
 
 public:
   typedef std::forward_iterator_tag iterator_category;
@@ -39,51 +190,45 @@ public:
   typedef T* pointer;
   typedef T& reference;
 
-  sparse_iterator(weight_map::iterator& iter, uint32_t stride) : _iter(iter), _stride(stride) {}
+  sparse_iterator(const sparse_weight_table* table, size_t block) : _table(table), _block(block) {}
 
   sparse_iterator& operator=(const sparse_iterator& other) = default;
   sparse_iterator(const sparse_iterator& other) = default;
   sparse_iterator& operator=(sparse_iterator&& other) = default;
   sparse_iterator(sparse_iterator&& other) = default;
 
-  uint64_t index() { return _iter->first; }
+  uint64_t index() { return _table->index_of(_block); }
 
-  T& operator*() { return *(_iter->second); }
+  T& operator*() { return *(_table->block(_block)); }
 
   sparse_iterator& operator++()
   {
-    _iter++;
+    _block++;
     return *this;
   }
 
-  bool operator==(const sparse_iterator& rhs) const { return _iter == rhs._iter; }
-  bool operator!=(const sparse_iterator& rhs) const { return _iter != rhs._iter; }
+  bool operator==(const sparse_iterator& rhs) const { return _block == rhs._block; }
+  bool operator!=(const sparse_iterator& rhs) const { return _block != rhs._block; }
 };
 
 class sparse_parameters
 {
 private:
-  // This must be mutable because the const operator[] must be able to intialize default weights to return.
-  mutable weight_map _map;
+  // The table itself is not const so the const operator[] can initialize default weights to return.
+  std::unique_ptr<sparse_weight_table> _table;
   uint64_t _weight_mask;  // (stride*(1 << num_bits) -1)
   uint32_t _stride_shift;
-  bool _seeded;  // whether the instance is sharing model state with others
-  bool _delete;
+  bool _seeded;  // whether the instance was seeded from another and shares its shared data
   std::function<void(weight*, uint64_t)> _default_func;
 
   // It is marked const so it can be used from both const and non const operator[]
-  // The map itself is mutable to facilitate this
   inline weight* get_or_default_and_get(size_t i) const
   {
     uint64_t index = i & _weight_mask;
-    weight_map::iterator iter = _map.find(index);
-    if (iter == _map.end())
-    {
-      _map.insert(std::make_pair(index, calloc_mergable_or_throw<weight>(stride())));
-      iter = _map.find(index);
-      if (_default_func != nullptr) { _default_func(iter->second, index); }
-    }
-    return iter->second;
+    bool inserted;
+    weight* block = _table->find_or_insert(index, inserted);
+    if (inserted && _default_func != nullptr) { _default_func(block, index); }
+    return block;
   }
 
 public:
@@ -91,21 +236,24 @@ public:
   typedef sparse_iterator<const weight> const_iterator;
 
   sparse_parameters(size_t length, uint32_t stride_shift = 0)
-      : _map()
+      : _table(new sparse_weight_table(1 << stride_shift))
       , _weight_mask((length << stride_shift) - 1)
       , _stride_shift(stride_shift)
       , _seeded(false)
-      , _delete(false)
       , _default_func(nullptr)
   {
   }
 
   sparse_parameters()
-      : _map(), _weight_mask(0), _stride_shift(0), _seeded(false), _delete(false), _default_func(nullptr)
+      : _table(new sparse_weight_table(1))
+      , _weight_mask(0)
+      , _stride_shift(0)
+      , _seeded(false)
+      , _default_func(nullptr)
   {
   }
 
-  bool not_null() { return (_weight_mask > 0 && !_map.empty()); }
+  bool not_null() { return (_weight_mask > 0 && _table->size() > 0); }
 
   sparse_parameters(const sparse_parameters& other) = delete;
   sparse_parameters& operator=(const sparse_parameters& other) = delete;
@@ -115,28 +263,12 @@ public:
   weight* first() { THROW_OR_RETURN("Allreduce currently not supported in sparse", nullptr); }
 
   // iterator with stride
-  iterator begin()
-  {
-    weight_map::iterator i = _map.begin();
-    return iterator(i, stride());
-  }
-  iterator end()
-  {
-    weight_map::iterator i = _map.end();
-    return iterator(i, stride());
-  }
+  iterator begin() { return iterator(_table.get(), 0); }
+  iterator end() { return iterator(_table.get(), _table->size()); }
 
   // const iterator
-  const_iterator cbegin()
-  {
-    weight_map::iterator i = _map.begin();
-    return const_iterator(i, stride());
-  }
-  const_iterator cend()
-  {
-    weight_map::iterator i = _map.begin();
-    return const_iterator(i, stride());
-  }
+  const_iterator cbegin() { return const_iterator(_table.get(), 0); }
+  const_iterator cend() { return const_iterator(_table.get(), _table->size()); }
 
   inline weight& operator[](size_t i) { return *(get_or_default_and_get(i)); }
 
@@ -144,18 +276,11 @@ public:
 
   inline weight& strided_index(size_t index) { return operator[](index << _stride_shift); }
 
+  // Copies the weights of input. Reading a weight can insert it, so unlike dense weights the table isn't shared: each
+  // seeded instance has its own and can be used from its own thread.
   void shallow_copy(const sparse_parameters& input)
   {
-    // TODO: this is level-1 copy (weight* are stilled shared)
-    if (!_seeded)
-    {
-      for (auto& iter : _map)
-      {
-        auto* weight_ptr = iter.second;
-        free(weight_ptr);
-      }
-    }
-    _map = input._map;
+    _table.reset(new sparse_weight_table(*input._table));
     _weight_mask = input._weight_mask;
     _stride_shift = input._stride_shift;
     _seeded = true;
@@ -169,7 +294,7 @@ public:
 
   void set_zero(size_t offset)
   {
-    for (auto& iter : _map) { (&(*(iter.second)))[offset] = 0; }
+    for (size_t n = 0; n < _table->size(); ++n) { _table->block(n)[offset] = 0; }
   }
 
   uint64_t mask() const { return _weight_mask; }
@@ -180,25 +305,18 @@ public:
 
   uint32_t stride_shift() const { return _stride_shift; }
 
-  void stride_shift(uint32_t stride_shift) { _stride_shift = stride_shift; }
+  void stride_shift(uint32_t stride_shift)
+  {
+    _stride_shift = stride_shift;
+    _table->set_stride(stride());
+  }
+
+  // Number of weight blocks that have been touched.
+  size_t size() const { return _table->size(); }
 
 #ifndef _WIN32
   void share(size_t /* length */) { THROW_OR_RETURN("Operation not supported on Windows"); }
 #endif
-
-  ~sparse_parameters()
-  {
-    if (!_delete && !_seeded)  // don't free weight vector if it is shared with another instance
-    {
-      for (auto& iter : _map)
-      {
-        auto* weight_ptr = iter.second;
-        free(weight_ptr);
-      }
-      _map.clear();
-      _delete = true;
-    }
-  }
 };
 
 class parameters
@@ -210,6 +328,7 @@ public:
   bool sparse;
   dense_parameters dense_weights;
   sparse_parameters sparse_weights;
+  VW::page_options page_options;  // how dense_weights is allocated
 
   inline weight& operator[](size_t i)
   {
@@ -219,6 +338,11 @@ public:
       return dense_weights[i];
   }
 
+  inline void prefetch(size_t i) const
+  {
+    if (!sparse) dense_weights.prefetch(i);
+  }
+
   template <typename Lambda>
   void set_default(Lambda&& default_func)
   {
@@ -8,8 +8,12 @@
 #ifndef _WIN32
 #  include <sys/mman.h>
 #endif
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#  include <xmmintrin.h>
+#endif
 
 #include "memory.h"
+#include "page_allocator.h"
 
 typedef float weight;
 
@@ -51,6 +55,18 @@ private:
   uint64_t _weight_mask;  // (stride*(1 << num_bits) -1)
   uint32_t _stride_shift;
   bool _seeded;  // whether the instance is sharing model state with others
+  VW::page_options _page_options;
+  VW::page_region _region;  // only mapped when the table was allocated with page options or shared
+
+  void release()
+  {
+    if (_region.mapped) { VW::free_pages(_region); }
+    else
+    {
+      free(_begin);
+    }
+    _region = VW::page_region();
+  }
 
 public:
   typedef dense_iterator<weight> iterator;
@@ -63,6 +79,32 @@ public:
   {
   }
 
+  dense_parameters(size_t length, uint32_t stride_shift, const VW::page_options& page_options)
+      : _begin(nullptr)
+      , _weight_mask((length << stride_shift) - 1)
+      , _stride_shift(stride_shift)
+      , _seeded(false)
+      , _page_options(page_options)
+  {
+    if (page_options.is_default()) { _begin = calloc_mergable_or_throw<weight>(length << stride_shift); }
+    else
+    {
+#ifdef VW_NOEXCEPT
+      // vw_slim can't throw, so when the pages can't be allocated it uses the ordinary allocation.
+      if (VW::try_allocate_pages((length << stride_shift) * sizeof(weight), page_options, false, _region) ==
+          VW::page_status::ok)
+      { _begin = static_cast<weight*>(_region.data); }
+      else
+      {
+        _begin = calloc_mergable_or_throw<weight>(length << stride_shift);
+      }
+#else
+      _region = VW::allocate_pages((length << stride_shift) * sizeof(weight), page_options, false);
+      _begin = static_cast<weight*>(_region.data);
+#endif
+    }
+  }
+
   dense_parameters() : _begin(nullptr), _weight_mask(0), _stride_shift(0), _seeded(false) {}
 
   bool not_null() { return (_weight_mask > 0 && _begin != nullptr); }
@@ -87,9 +129,18 @@ public:
   inline const weight& operator[](size_t i) const { return _begin[i & _weight_mask]; }
   inline weight& operator[](size_t i) { return _begin[i & _weight_mask]; }
 
+  inline void prefetch(size_t i) const
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&_begin[i & _weight_mask]);
+#elif defined(_M_X64) || defined(_M_IX86)
+    _mm_prefetch(reinterpret_cast<const char*>(&_begin[i & _weight_mask]), _MM_HINT_T0);
+#endif
+  }
+
   void shallow_copy(const dense_parameters& input)
   {
-    if (!_seeded) free(_begin);
+    if (!_seeded) release();
     _begin = input._begin;
     _weight_mask = input._weight_mask;
     _stride_shift = input._stride_shift;
@@ -124,16 +175,37 @@ public:
 
   void stride_shift(uint32_t stride_shift) { _stride_shift = stride_shift; }
 
+  // Only known when the table was allocated with page options or shared, empty otherwise.
+  const VW::page_region& pages() const { return _region; }
+
+  // Replaces the table with region, e.g. a read only mapping of a model file. region must hold the whole table.
+  void adopt_pages(const VW::page_region& region)
+  {
+    if (!_seeded) { release(); }
+    _region = region;
+    _begin = static_cast<weight*>(region.data);
+    _seeded = false;
+  }
+
+  bool read_only() const { return _region.read_only; }
+
 #ifndef _WIN32
 #  ifndef DISABLE_SHARED_WEIGHTS
   void share(size_t length)
   {
-    float* shared_weights = static_cast<float*>(mmap(
-        nullptr, (length << _stride_shift) * sizeof(float), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
     size_t float_count = length << _stride_shift;
-    weight* dest = shared_weights;
+#  ifdef VW_NOEXCEPT
+    // Without exceptions the weights stay private when no shared pages can be allocated.
+    VW::page_region shared_region;
+    if (VW::try_allocate_pages(float_count * sizeof(float), _page_options, true, shared_region) != VW::page_status::ok)
+    { return; }
+#  else
+    VW::page_region shared_region = VW::allocate_pages(float_count * sizeof(float), _page_options, true);
+#  endif
+    weight* dest = static_cast<weight*>(shared_region.data);
     memcpy(dest, _begin, float_count * sizeof(float));
-    free(_begin);
+    release();
+    _region = shared_region;
     _begin = dest;
   }
 #  endif
@@ -143,7 +215,7 @@ public:
   {
     if (_begin != nullptr && !_seeded)  // don't free weight vector if it is shared with another instance
     {
-      free(_begin);
+      release();
       _begin = nullptr;
     }
   }
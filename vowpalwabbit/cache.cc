@@ -7,6 +7,9 @@
 #include "global_data.h"
 #include "vw.h"
 #include "io/logger.h"
+#include "stream_vbyte.h"
+
+#include <algorithm>
 
 constexpr size_t int_size = 11;
 constexpr size_t char_size = 2;
@@ -15,6 +18,24 @@ constexpr size_t general = 2;
 constexpr unsigned char newline_example = '1';
 constexpr unsigned char non_newline_example = '0';
 
+// The block codec splits each namespace into blocks of up to block_size features. A block starts with a block_header
+// whose payload_size covers everything after the header, so readers can step over a block without decoding it.
+// The payload holds the zigzag coded index deltas, followed by the values.
+constexpr size_t block_size = 128;
+constexpr uint8_t index_deltas_svb32 = 0;  // Stream VByte, used when every delta in the block fits in 32 bits
+constexpr uint8_t index_deltas_raw64 = 1;  // uint64_t per delta
+constexpr uint8_t values_all_one = 0;      // no payload
+constexpr uint8_t values_signs = 1;        // one bit per feature, set for -1
+constexpr uint8_t values_raw = 2;          // float per feature
+
+struct block_header
+{
+  uint32_t payload_size;
+  uint16_t count;
+  uint8_t index_encoding;
+  uint8_t value_encoding;
+};
+
 inline char* run_len_decode(char* p, uint64_t& i)
 {
   // read an int 7 bits at a time.
@@ -38,6 +59,12 @@ inline char* run_len_encode(char* p, uint64_t i)
 
 inline int64_t ZigZagDecode(uint64_t n) { return (n >> 1) ^ -static_cast<int64_t>(n & 1); }
 
+inline uint64_t ZigZagEncode(int64_t n)
+{
+  uint64_t ret = (n << 1) ^ (n >> 63);
+  return ret;
+}
+
 size_t read_cached_tag(io_buf& cache, example* ae)
 {
   char* c;
@@ -62,14 +89,103 @@ __attribute__((packed))
 #endif
 ;
 
-void VW::write_example_to_cache(io_buf& output, example* ae, label_parser& lbl_parser, uint64_t parse_mask)
+// Decodes the blocks in [c, end) into ours. The blocks must fill the range exactly, and a length or encoding that
+// doesn't fit means the file was corrupted or truncated, which throws.
+void read_cached_feature_blocks(const char* c, const char* end, features& ours, bool& sorted)
+{
+  uint32_t num_features;
+  if (end - c < static_cast<std::ptrdiff_t>(sizeof(num_features))) { THROW("corrupted cache file: no feature count"); }
+  memcpy(&num_features, c, sizeof(num_features));
+  c += sizeof(num_features);
+  // Every feature takes at least one byte, which bounds the reservation for corrupt input.
+  if (num_features > static_cast<size_t>(end - c))
+  { THROW("corrupted cache file: " << num_features << " features in " << (end - c) << " bytes"); }
+  ours.values.reserve(ours.values.size() + num_features);
+  ours.indicies.reserve(ours.indicies.size() + num_features);
+
+  uint32_t deltas[block_size];
+  uint64_t wide_deltas[block_size];
+  float values[block_size];
+  uint64_t last = 0;
+  size_t decoded = 0;
+  while (c != end)
+  {
+    block_header header;
+    if (end - c < static_cast<std::ptrdiff_t>(sizeof(header)))
+    { THROW("corrupted cache file: truncated block header"); }
+    memcpy(&header, c, sizeof(header));
+    c += sizeof(header);
+    if (header.payload_size > static_cast<size_t>(end - c))
+    { THROW("corrupted cache file: block of " << header.payload_size << " bytes runs past the namespace"); }
+    if (header.count == 0 || header.count > block_size)
+    { THROW("corrupted cache file: block of " << header.count << " features"); }
+    const char* block_end = c + header.payload_size;
+    const size_t count = header.count;
+
+    if (header.index_encoding == index_deltas_raw64)
+    {
+      if (static_cast<size_t>(block_end - c) < count * sizeof(uint64_t))
+      { THROW("corrupted cache file: index deltas run past the block"); }
+      memcpy(wide_deltas, c, count * sizeof(uint64_t));
+      c += count * sizeof(uint64_t);
+    }
+    else if (header.index_encoding == index_deltas_svb32)
+    {
+      if ((c = VW::svb::decode(c, block_end, count, deltas)) == nullptr)
+      { THROW("corrupted cache file: index deltas run past the block"); }
+    }
+    else
+    {
+      THROW("corrupted cache file: unknown index encoding " << static_cast<int>(header.index_encoding));
+    }
+
+    size_t value_bytes = 0;
+    if (header.value_encoding == values_signs) { value_bytes = (count + 7) / 8; }
+    else if (header.value_encoding == values_raw)
+    {
+      value_bytes = count * sizeof(float);
+    }
+    else if (header.value_encoding != values_all_one)
+    {
+      THROW("corrupted cache file: unknown value encoding " << static_cast<int>(header.value_encoding));
+    }
+    if (static_cast<size_t>(block_end - c) != value_bytes)
+    { THROW("corrupted cache file: values don't fill the rest of the block"); }
+
+    if (header.value_encoding == values_all_one) { std::fill(values, values + count, 1.f); }
+    else if (header.value_encoding == values_signs)
+    {
+      for (size_t j = 0; j < count; ++j) { values[j] = (c[j / 8] >> (j % 8)) & 1 ? -1.f : 1.f; }
+    }
+    else
+    {
+      memcpy(values, c, count * sizeof(float));
+    }
+
+    const bool wide = header.index_encoding == index_deltas_raw64;
+    for (size_t j = 0; j < count; ++j)
+    {
+      const int64_t s_diff = ZigZagDecode(wide ? wide_deltas[j] : deltas[j]);
+      if (s_diff < 0) { sorted = false; }
+      last += s_diff;
+      ours.push_back(values[j], last);
+    }
+    decoded += count;
+    c = block_end;
+  }
+  if (decoded != num_features)
+  { THROW("corrupted cache file: " << decoded << " features in blocks, " << num_features << " expected"); }
+}
+
+void VW::write_example_to_cache(
+    io_buf& output, example* ae, label_parser& lbl_parser, uint64_t parse_mask, bool block_codec)
 {
   lbl_parser.cache_label(&ae->l, ae->_reduction_features, output);
-  cache_features(output, ae, parse_mask);
+  cache_features(output, ae, parse_mask, block_codec);
 }
 
-int VW::read_example_from_cache(
-    io_buf& input, example* ae, label_parser& lbl_parser, bool sorted_cache, shared_data* shared_dat)
+int VW::read_example_from_cache(io_buf& input, example* ae, label_parser& lbl_parser, bool sorted_cache,
+    shared_data* shared_dat, bool block_codec)
 {
   ae->sorted = sorted_cache;
   size_t total = lbl_parser.read_cached_label(shared_dat, &ae->l, ae->_reduction_features, input);
@@ -107,12 +223,21 @@ int VW::read_example_from_cache(
     total += storage;
     if (input.buf_read(c, storage) < storage)
     {
+      if (block_codec)
+      { THROW("corrupted cache file: namespace " << static_cast<int>(index) << " wants " << storage << " bytes"); }
       VW::io::logger::errlog_error("truncated example! wanted: {} bytes ", storage);
       return 0;
     }
 
     char* end = c + storage;
 
+    if (block_codec)
+    {
+      read_cached_feature_blocks(c, end, ours, ae->sorted);
+      input.set(end);
+      continue;
+    }
+
     uint64_t last = 0;
 
     for (; c != end;)
@@ -143,13 +268,7 @@ int VW::read_example_from_cache(
 int read_cached_features(vw* all, v_array<example*>& examples)
 {
   return VW::read_example_from_cache(*all->example_parser->input, examples[0], all->example_parser->lbl_parser,
-      all->example_parser->sorted_cache, all->example_parser->_shared_data);
-}
-
-inline uint64_t ZigZagEncode(int64_t n)
-{
-  uint64_t ret = (n << 1) ^ (n >> 63);
-  return ret;
+      all->example_parser->sorted_cache, all->example_parser->_shared_data, all->example_parser->block_cache);
 }
 
 void output_byte(io_buf& cache, unsigned char s)
@@ -199,6 +318,90 @@ void output_features(io_buf& cache, unsigned char index, features& fs, uint64_t
   *reinterpret_cast<size_t*>(storage_size_loc) = c - storage_size_loc - sizeof(size_t);
 }
 
+void output_features_blocks(io_buf& cache, unsigned char index, features& fs, uint64_t mask)
+{
+  const size_t num_blocks = (fs.size() + block_size - 1) / block_size;
+  const size_t storage = sizeof(uint32_t) + num_blocks * sizeof(block_header) +
+      fs.size() * (sizeof(uint64_t) + sizeof(feature_value)) + VW::svb::control_size(fs.size()) + num_blocks;
+
+  char* c;
+  cache.buf_write(c, sizeof(index) + sizeof(size_t) + storage);
+  *reinterpret_cast<unsigned char*>(c) = index;
+  c += sizeof(index);
+
+  char* storage_size_loc = c;
+  c += sizeof(size_t);
+
+  const uint32_t num_features = VW::convert(fs.size());
+  memcpy(c, &num_features, sizeof(num_features));
+  c += sizeof(num_features);
+
+  uint32_t deltas[block_size];
+  uint64_t wide_deltas[block_size];
+  uint64_t last = 0;
+  for (size_t begin = 0; begin < fs.size(); begin += block_size)
+  {
+    const size_t count = std::min(block_size, fs.size() - begin);
+    const feature_value* values = fs.values.begin() + begin;
+
+    bool fits_32 = true;
+    bool all_one = true;
+    bool all_signs = true;
+    for (size_t j = 0; j < count; ++j)
+    {
+      const feature_index fi = fs.indicies[begin + j] & mask;
+      wide_deltas[j] = ZigZagEncode(fi - last);
+      last = fi;
+      fits_32 = fits_32 && wide_deltas[j] <= UINT32_MAX;
+      deltas[j] = static_cast<uint32_t>(wide_deltas[j]);
+      all_one = all_one && values[j] == 1.f;
+      all_signs = all_signs && (values[j] == 1.f || values[j] == -1.f);
+    }
+
+    block_header header;
+    header.count = static_cast<uint16_t>(count);
+    char* header_loc = c;
+    c += sizeof(header);
+    char* payload = c;
+
+    if (fits_32)
+    {
+      header.index_encoding = index_deltas_svb32;
+      c = VW::svb::encode(deltas, count, c);
+    }
+    else
+    {
+      header.index_encoding = index_deltas_raw64;
+      memcpy(c, wide_deltas, count * sizeof(uint64_t));
+      c += count * sizeof(uint64_t);
+    }
+
+    if (all_one) { header.value_encoding = values_all_one; }
+    else if (all_signs)
+    {
+      header.value_encoding = values_signs;
+      memset(c, 0, (count + 7) / 8);
+      for (size_t j = 0; j < count; ++j)
+      {
+        if (values[j] == -1.f) { c[j / 8] |= static_cast<char>(1 << (j % 8)); }
+      }
+      c += (count + 7) / 8;
+    }
+    else
+    {
+      header.value_encoding = values_raw;
+      memcpy(c, values, count * sizeof(feature_value));
+      c += count * sizeof(feature_value);
+    }
+
+    header.payload_size = static_cast<uint32_t>(c - payload);
+    memcpy(header_loc, &header, sizeof(header));
+  }
+
+  cache.set(c);
+  *reinterpret_cast<size_t*>(storage_size_loc) = c - storage_size_loc - sizeof(size_t);
+}
+
 void cache_tag(io_buf& cache, const v_array<char>& tag)
 {
   char* c;
@@ -210,13 +413,20 @@ void cache_tag(io_buf& cache, const v_array<char>& tag)
   cache.set(c);
 }
 
-void cache_features(io_buf& cache, example* ae, uint64_t mask)
+void cache_features(io_buf& cache, example* ae, uint64_t mask, bool block_codec)
 {
   cache_tag(cache, ae->tag);
 
   cache.write_value<unsigned char>(ae->is_newline ? newline_example : non_newline_example);
   cache.write_value<unsigned char>(static_cast<unsigned char>(ae->indices.size()));
-  for (namespace_index ns : ae->indices) output_features(cache, ns, ae->feature_space[ns], mask);
+  for (namespace_index ns : ae->indices)
+  {
+    if (block_codec) { output_features_blocks(cache, ns, ae->feature_space[ns], mask); }
+    else
+    {
+      output_features(cache, ns, ae->feature_space[ns], mask);
+    }
+  }
 }
 
 uint32_t VW::convert(size_t number)
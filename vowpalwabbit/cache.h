@@ -12,15 +12,22 @@ char* run_len_encode(char* p, size_t i);
 
 int read_cached_features(vw* all, v_array<example*>& examples);
 void cache_tag(io_buf& cache, const v_array<char>& tag);
-void cache_features(io_buf& cache, example* ae, uint64_t mask);
+void cache_features(io_buf& cache, example* ae, uint64_t mask, bool block_codec = false);
 void output_byte(io_buf& cache, unsigned char s);
 void output_features(io_buf& cache, unsigned char index, features& fs, uint64_t mask);
+// Same framing as output_features, but the features are stored as blocks of Stream VByte coded index deltas.
+void output_features_blocks(io_buf& cache, unsigned char index, features& fs, uint64_t mask);
 
 namespace VW
 {
+// Cache type bytes stored in the cache file header.
+constexpr char VARINT_CACHE_TYPE = 'c';
+constexpr char BLOCK_CACHE_TYPE = 'b';
+
 uint32_t convert(size_t number);
-// What is written by write_example_to_cache can be read by read_example_from_cache
-void write_example_to_cache(io_buf& output, example* ae, label_parser& lbl_parser, uint64_t parse_mask);
-int read_example_from_cache(
-    io_buf& input, example* ae, label_parser& lbl_parser, bool sorted_cache, shared_data* shared_dat);
+// What is written by write_example_to_cache can be read by read_example_from_cache with the same block_codec setting
+void write_example_to_cache(
+    io_buf& output, example* ae, label_parser& lbl_parser, uint64_t parse_mask, bool block_codec = false);
+int read_example_from_cache(io_buf& input, example* ae, label_parser& lbl_parser, bool sorted_cache,
+    shared_data* shared_dat, bool block_codec = false);
 }  // namespace VW
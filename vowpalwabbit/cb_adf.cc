@@ -88,6 +88,7 @@ private:
 public:
   void learn(VW::LEARNER::multi_learner& base, multi_ex& ec_seq);
   void predict(VW::LEARNER::multi_learner& base, multi_ex& ec_seq);
+  void multipredict(VW::LEARNER::multi_learner& base, multi_ex& ec_seq, size_t count, polyprediction* pred);
   bool update_statistics(example& ec, multi_ex* ec_seq);
 
   cb_adf(
@@ -334,6 +335,14 @@ void cb_adf::predict(multi_learner& base, multi_ex& ec_seq)
   cs_ldf_learn_or_predict<false>(base, ec_seq, _cb_labels, _cs_labels, _prepped_cs_labels, false, _offset);
 }
 
+void cb_adf::multipredict(multi_learner& base, multi_ex& ec_seq, size_t count, polyprediction* pred)
+{
+  _offset = ec_seq[0]->ft_offset;
+  _gen_cs.known_cost = get_observed_cost_or_default_cb_adf(ec_seq);  // need to set for test case
+  gen_cs_test_example(ec_seq, _cs_labels);                           // create test labels.
+  cs_ldf_multipredict(base, ec_seq, _cb_labels, _cs_labels, _prepped_cs_labels, _offset, count, pred);
+}
+
 void global_print_newline(const std::vector<std::unique_ptr<VW::io::writer>>& final_prediction_sink)
 {
   char temp[1];
@@ -472,6 +481,11 @@ void learn(cb_adf& c, multi_learner& base, multi_ex& ec_seq) { c.learn(base, ec_
 
 void predict(cb_adf& c, multi_learner& base, multi_ex& ec_seq) { c.predict(base, ec_seq); }
 
+void multipredict(cb_adf& c, multi_learner& base, multi_ex& ec_seq, size_t count, size_t, polyprediction* pred, bool)
+{
+  c.multipredict(base, ec_seq, count, pred);
+}
+
 }  // namespace CB_ADF
 using namespace CB_ADF;
 base_learner* cb_adf_setup(options_i& options, vw& all)
@@ -565,6 +579,9 @@ base_learner* cb_adf_setup(options_i& options, vw& all)
                 .set_print_example(CB_ADF::update_and_output)
                 .set_save_load(CB_ADF::save_load)
                 .build();
+  // The regressors of cb_adf are problem_multiplier regressors of csoaa_ldf apart, so a multipredict can only be passed
+  // down when there is one.
+  if (problem_multiplier == 1) { l->set_multipredict(CB_ADF::multipredict); }
 
   bare->set_scorer(all.scorer);
 
@@ -33,17 +33,19 @@ private:
   size_t _bag_size;
   bool _greedify;
   bool _first_only;
+  bool _fused;
   std::shared_ptr<rand_state> _random_state;
 
   v_array<ACTION_SCORE::action_score> _action_probs;
   std::vector<float> _scores;
   std::vector<float> _top_actions;
+  std::vector<polyprediction> _bag_preds;  // the ranking of every policy when fused
 
 public:
   using PredictionT = v_array<ACTION_SCORE::action_score>;
 
-  cb_explore_adf_bag(
-      float epsilon, size_t bag_size, bool greedify, bool first_only, std::shared_ptr<rand_state> random_state);
+  cb_explore_adf_bag(float epsilon, size_t bag_size, bool greedify, bool first_only, bool fused,
+      std::shared_ptr<rand_state> random_state);
 
   // Should be called through cb_explore_adf_base for pre/post-processing
   void predict(VW::LEARNER::multi_learner &base, multi_ex &examples);
@@ -55,9 +57,14 @@ private:
   uint32_t get_bag_learner_update_count(uint32_t learner_index);
 };
 
-cb_explore_adf_bag::cb_explore_adf_bag(
-    float epsilon, size_t bag_size, bool greedify, bool first_only, std::shared_ptr<rand_state> random_state)
-    : _epsilon(epsilon), _bag_size(bag_size), _greedify(greedify), _first_only(first_only), _random_state(random_state)
+cb_explore_adf_bag::cb_explore_adf_bag(float epsilon, size_t bag_size, bool greedify, bool first_only, bool fused,
+    std::shared_ptr<rand_state> random_state)
+    : _epsilon(epsilon)
+    , _bag_size(bag_size)
+    , _greedify(greedify)
+    , _first_only(first_only)
+    , _fused(fused)
+    , _random_state(random_state)
 {
 }
 
@@ -85,20 +92,28 @@ void cb_explore_adf_bag::predict(VW::LEARNER::multi_learner &base, multi_ex &exa
   _scores.assign(num_actions, 0.f);
   _top_actions.assign(num_actions, 0);
 
+  // The policies use consecutive regressors, so a multipredict can score an action for all of them at once.
+  if (_fused)
+  {
+    _bag_preds.resize(_bag_size);
+    base.multipredict(examples, 0, _bag_size, _bag_preds.data(), true);
+  }
+
   for (uint32_t i = 0; i < _bag_size; i++)
   {
-    VW::LEARNER::multiline_learn_or_predict<false>(base, examples, examples[0]->ft_offset, i);
+    if (!_fused) { VW::LEARNER::multiline_learn_or_predict<false>(base, examples, examples[0]->ft_offset, i); }
+    const auto& policy_preds = _fused ? _bag_preds[i].a_s : preds;
 
-    assert(preds.size() == num_actions);
-    for (auto e : preds) _scores[e.action] += e.score;
+    assert(policy_preds.size() == num_actions);
+    for (auto e : policy_preds) _scores[e.action] += e.score;
 
     if (!_first_only)
     {
-      size_t tied_actions = fill_tied(preds);
-      for (size_t j = 0; j < tied_actions; ++j) _top_actions[preds[j].action] += 1.f / tied_actions;
+      size_t tied_actions = fill_tied(policy_preds);
+      for (size_t j = 0; j < tied_actions; ++j) _top_actions[policy_preds[j].action] += 1.f / tied_actions;
     }
     else
-      _top_actions[preds[0].action] += 1.f;
+      _top_actions[policy_preds[0].action] += 1.f;
   }
 
   _action_probs.clear();
@@ -110,7 +125,8 @@ void cb_explore_adf_bag::predict(VW::LEARNER::multi_learner &base, multi_ex &exa
 
   exploration::enforce_minimum_probability(_epsilon, true, begin_scores(_action_probs), end_scores(_action_probs));
   sort_action_probs(_action_probs, _scores);
-  std::copy(std::begin(_action_probs), std::end(_action_probs), std::begin(preds));
+  preds.clear();
+  for (const auto& action_prob : _action_probs) { preds.push_back(action_prob); }
 }
 
 void cb_explore_adf_bag::learn(VW::LEARNER::multi_learner &base, multi_ex &examples)
@@ -151,6 +167,7 @@ VW::LEARNER::base_learner* setup(VW::config::options_i& options, vw& all)
   size_t bag_size = 0;
   bool greedify = false;
   bool first_only = false;
+  bool fused = false;
   config::option_group_definition new_options("Contextual Bandit Exploration with ADF (bagging)");
   new_options
       .add(make_option("cb_explore_adf", cb_explore_adf_option)
@@ -160,7 +177,10 @@ VW::LEARNER::base_learner* setup(VW::config::options_i& options, vw& all)
       .add(make_option("epsilon", epsilon).keep().allow_override().help("epsilon-greedy exploration"))
       .add(make_option("bag", bag_size).keep().necessary().help("bagging-based exploration"))
       .add(make_option("greedify", greedify).keep().help("always update first policy once in bagging"))
-      .add(make_option("first_only", first_only).keep().help("Only explore the first action in a tie-breaking event"));
+      .add(make_option("first_only", first_only).keep().help("Only explore the first action in a tie-breaking event"))
+      .add(make_option("fused_bag", fused)
+               .help("Predict all bagged policies with one pass over the features of each action. The actions are "
+                     "scored on --ldf_predict_threads threads"));
 
   if (!options.add_parse_and_check_necessary(new_options)) return nullptr;
 
@@ -176,11 +196,15 @@ VW::LEARNER::base_learner* setup(VW::config::options_i& options, vw& all)
   VW::LEARNER::multi_learner* base = as_multiline(setup_base(options, all));
   all.example_parser->lbl_parser = CB::cb_label;
 
+  // The ranking of a policy comes from the scores that the multipredict of the scorer passes through its link.
+  if (fused && options.get_typed_option<std::string>("link").value() != "identity")
+    THROW("fused_bag requires the identity link");
+
   bool with_metrics = options.was_supplied("extra_metrics");
 
   using explore_type = cb_explore_adf_base<cb_explore_adf_bag>;
-  auto data =
-      VW::make_unique<explore_type>(with_metrics, epsilon, bag_size, greedify, first_only, all.get_random_state());
+  auto data = VW::make_unique<explore_type>(
+      with_metrics, epsilon, bag_size, greedify, first_only, fused, all.get_random_state());
   auto* l = make_reduction_learner(
       std::move(data), base, explore_type::learn, explore_type::predict, all.get_setupfn_name(setup) + "-bag")
                 .set_params_per_weight(problem_multiplier)
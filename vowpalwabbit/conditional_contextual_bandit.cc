@@ -90,6 +90,13 @@ struct ccb
   VW::v_array_pool<CB::cb_class> cb_label_pool;
   VW::v_array_pool<ACTION_SCORE::action_score> action_score_pool;
 
+  // When every reduction below supports it, gd scores the part of an action that doesn't depend on the slot apart from
+  // the rest. --cache_slot_scores keeps that part from one slot to the next instead of scoring it for every slot.
+  bool split_slot_scores = false;
+  bool cache_slot_scores = false;
+  // The namespaces that the slots of the current multi-example inject into the shared example.
+  std::array<bool, NUM_NAMESPACES> slot_namespaces;
+
   VW::version_struct model_file_version;
   // If the reduction has not yet seen a multi slot example, it will behave the same as if it were CB.
   // This means the interactions aren't added and the slot feature is not added.
@@ -104,6 +111,13 @@ namespace CCB
 static constexpr uint32_t SHARED_EX_INDEX = 0;
 static constexpr uint32_t TOP_ACTION_INDEX = 0;
 
+// The reductions that may run below split slot scores. gd keeps the part of the score of an action that doesn't depend
+// on the slot, so every reduction below must leave the features of the actions to gd.
+static const std::vector<std::string> slot_cache_reductions = {"gd", "scorer", "generate_interactions", "csoaa_ldf",
+    "cb_adf", "cb_explore_adf_greedy", "cb_explore_adf_softmax", "cb_explore_adf_first", "cb_explore_adf_bag",
+    "cb_explore_adf_cover", "cb_explore_adf_regcb", "cb_explore_adf_squarecb", "cb_explore_adf_synthcover", "cb_dro",
+    "cb_sample", "shared_feature_merger"};
+
 void clear_all(ccb& data)
 {
   // data.include_list and data.exclude_list aren't cleared here but are assigned in the predict/learn function
@@ -249,8 +263,9 @@ void inject_slot_id(ccb& data, example* shared, size_t id)
   if (audit)
   {
     auto current_index_str = "index" + std::to_string(id);
+    auto& names = data.all->name_table;
     shared->feature_space[ccb_id_namespace].space_names.push_back(
-        audit_strings(data.id_namespace_str, current_index_str));
+        audit_strings(names.intern(data.id_namespace_str), names.intern(current_index_str)));
   }
 }
 
@@ -281,6 +296,36 @@ void remove_slot_features(example* shared, example* slot)
   }
 }
 
+// Every namespace that a slot of the multi-example injects into the shared example changes from one slot to the next,
+// the rest of the features of an action stay the same. gd scores that rest apart, and adds it last.
+void attach_slot_namespaces(ccb& data)
+{
+  data.slot_namespaces.fill(false);
+  data.slot_namespaces[ccb_id_namespace] = true;
+  for (const auto* slot : data.slots)
+  {
+    for (auto index : slot->indices)
+    {
+      if (index == constant_namespace) { continue; }
+      data.slot_namespaces[index == default_namespace ? ccb_slot_namespace : index] = true;
+    }
+  }
+  for (auto* action : data.actions)
+  {
+    action->varying_namespaces = &data.slot_namespaces;
+    action->stable_scores.clear();
+  }
+}
+
+void detach_slot_namespaces(ccb& data)
+{
+  for (auto* action : data.actions)
+  {
+    action->varying_namespaces = nullptr;
+    action->stable_scores.clear();
+  }
+}
+
 // build a cb example from the ccb example
 template <bool is_learn>
 void build_cb_example(multi_ex& cb_ex, example* slot, const CCB::label& ccb_label, ccb& data)
@@ -415,6 +460,13 @@ void learn_or_predict(ccb& data, multi_learner& base, multi_ex& examples)
   create_cb_labels(data);
   auto delete_cb_labels_guard = VW::scope_exit([&data] { delete_cb_labels(data); });
 
+  // Learning changes the weights between the slots, so the cached scores are only valid when predicting.
+  const bool split_slot_scores = !is_learn && data.split_slot_scores;
+  if (split_slot_scores) { attach_slot_namespaces(data); }
+  auto detach_slot_namespaces_guard = VW::scope_exit([&data, split_slot_scores] {
+    if (split_slot_scores) { detach_slot_namespaces(data); }
+  });
+
   // this is temporary only so we can get some logging of what's going on
   try
   {
@@ -442,6 +494,13 @@ void learn_or_predict(ccb& data, multi_learner& base, multi_ex& examples)
         }
       }
 
+      // Without --cache_slot_scores every slot scores the part of the actions that doesn't depend on it again. It is
+      // summed the same way either way, so the option doesn't change any score.
+      if (split_slot_scores && !data.cache_slot_scores)
+      {
+        for (auto* action : data.actions) { action->stable_scores.clear(); }
+      }
+
       // the cb example contains at least 1 action
       if (has_action(data.cb_ex))
       {
@@ -613,6 +672,7 @@ base_learner* ccb_explore_adf_setup(options_i& options, vw& all)
   auto data = VW::make_unique<ccb>();
   bool ccb_explore_adf_option = false;
   bool all_slots_loss_report = false;
+  bool cache_slot_scores = false;
 
   data->is_ccb_input_model = all.is_ccb_input_model;
 
@@ -623,10 +683,14 @@ base_learner* ccb_explore_adf_setup(options_i& options, vw& all)
                .necessary()
                .help(
                    "EXPERIMENTAL: Do Conditional Contextual Bandit learning with multiline action dependent features."))
-      .add(make_option("all_slots_loss", all_slots_loss_report).help("Report average loss from all slots"));
+      .add(make_option("all_slots_loss", all_slots_loss_report).help("Report average loss from all slots"))
+      .add(make_option("cache_slot_scores", cache_slot_scores)
+               .help("When predicting, score the features of each action that don't depend on the slot once per "
+                     "multi-example instead of once per slot"));
 
   if (!options.add_parse_and_check_necessary(new_options)) { return nullptr; }
   data->all_slots_loss_report = all_slots_loss_report;
+  data->cache_slot_scores = cache_slot_scores;
   if (!options.was_supplied("cb_explore_adf"))
   {
     options.insert("cb_explore_adf", "");
@@ -642,6 +706,16 @@ base_learner* ccb_explore_adf_setup(options_i& options, vw& all)
   auto* base = as_multiline(setup_base(options, all));
   all.example_parser->lbl_parser = CCB::ccb_label_parser;
 
+  data->split_slot_scores = true;
+  for (const auto& name : all.enabled_reductions)
+  {
+    if (std::find(slot_cache_reductions.begin(), slot_cache_reductions.end(), name) == slot_cache_reductions.end())
+    {
+      if (cache_slot_scores) { THROW("cache_slot_scores cannot be used with " << name); }
+      data->split_slot_scores = false;
+    }
+  }
+
   // Stash the base learners stride_shift so we can properly add a feature
   // later.
   data->base_learner_stride_shift = all.weights.stride_shift();
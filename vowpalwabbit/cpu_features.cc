@@ -0,0 +1,52 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "cpu_features.h"
+
+#include <cstdint>
+
+#if defined(VW_HAVE_X86_DISPATCH) && defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#endif
+
+namespace
+{
+VW::cpu_features detect_cpu_features()
+{
+  VW::cpu_features features;
+#if defined(VW_HAVE_X86_DISPATCH)
+#  if defined(_MSC_VER) && !defined(__clang__)
+  int regs[4];
+  __cpuid(regs, 0);
+  const int max_leaf = regs[0];
+  __cpuid(regs, 1);
+  features.ssse3 = (regs[2] & (1 << 9)) != 0;
+  const bool fma = (regs[2] & (1 << 12)) != 0;
+  const bool osxsave = (regs[2] & (1 << 27)) != 0;
+  if (osxsave && max_leaf >= 7)
+  {
+    const uint64_t xcr0 = _xgetbv(0);
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+    __cpuidex(regs, 7, 0);
+    features.avx2 = ymm_state && fma && (regs[1] & (1 << 5)) != 0;
+    features.avx512f = zmm_state && (regs[1] & (1 << 16)) != 0;
+  }
+#  else
+  // The builtins also check that the OS saves the extended register state.
+  __builtin_cpu_init();
+  features.ssse3 = __builtin_cpu_supports("ssse3") != 0;
+  features.avx2 = __builtin_cpu_supports("avx2") != 0 && __builtin_cpu_supports("fma") != 0;
+  features.avx512f = __builtin_cpu_supports("avx512f") != 0;
+#  endif
+#endif
+  return features;
+}
+}  // namespace
+
+const VW::cpu_features& VW::get_cpu_features()
+{
+  static const cpu_features features = detect_cpu_features();
+  return features;
+}
@@ -0,0 +1,33 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+// Kernels that need instructions beyond the SSE2 baseline are compiled with per-function target attributes and only
+// called after checking get_cpu_features() at runtime.
+#if !defined(VW_NO_INLINE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#  define VW_HAVE_X86_DISPATCH
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define VW_TARGET_SSSE3
+#    define VW_TARGET_AVX2
+#    define VW_TARGET_AVX512
+#  else
+#    define VW_TARGET_SSSE3 __attribute__((target("ssse3")))
+#    define VW_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#    define VW_TARGET_AVX512 __attribute__((target("avx512f")))
+#  endif
+#endif
+
+namespace VW
+{
+struct cpu_features
+{
+  bool ssse3 = false;
+  bool avx2 = false;     // AVX2 and FMA, with OS support for the ymm state
+  bool avx512f = false;  // with OS support for the zmm state
+};
+
+/// Instruction sets usable on this machine. Detected once, always false when VW_NO_INLINE_SIMD is defined.
+const cpu_features& get_cpu_features();
+}  // namespace VW
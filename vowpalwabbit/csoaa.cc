@@ -15,6 +15,7 @@
 #include "csoaa.h"
 #include "scope_exit.h"
 #include "shared_data.h"
+#include "thread_pool.h"
 
 #include "io/logger.h"
 
@@ -174,6 +175,9 @@ struct ldf
   uint64_t ft_offset;
 
   std::vector<action_scores> stored_preds;
+
+  std::unique_ptr<VW::thread_pool> predict_pool;  // set when ldf_predict_threads > 1
+  std::vector<polyprediction> action_preds;       // a multipredict of every action, one row per action
 };
 
 bool ec_is_label_definition(example& ec)  // label defs look like "0:___" or just "label:___"
@@ -253,7 +257,8 @@ void unsubtract_example(example* ec)
   ec->indices.pop_back();
 }
 
-void make_single_prediction(ldf& data, single_learner& base, example& ec)
+template <class PredictFn>
+void make_single_prediction(ldf& data, example& ec, const PredictFn& predict)
 {
   uint64_t old_offset = ec.ft_offset;
 
@@ -273,7 +278,35 @@ void make_single_prediction(ldf& data, single_learner& base, example& ec)
   ec._reduction_features.template get<simple_label_reduction_features>().reset_to_default();
 
   ec.ft_offset = data.ft_offset;
-  base.predict(ec);  // make a prediction
+  predict(ec);  // make a prediction
+}
+
+void make_single_prediction(ldf& data, single_learner& base, example& ec)
+{
+  make_single_prediction(data, ec, [&base](example& e) { base.predict(e); });
+}
+
+// Calls score_action for every action of ec_seq. With --ldf_predict_threads the actions after the first are scored by
+// the pool. The first is scored on this thread, so state that the base fills on first use, like the shared_context
+// scores of gd, is complete before the workers read it.
+template <class ScoreFn>
+void score_actions(ldf& data, multi_ex& ec_seq, const ScoreFn& score_action)
+{
+  if (ec_seq.empty()) { return; }
+  score_action(0);
+  if (data.predict_pool == nullptr)
+  {
+    for (size_t k = 1; k < ec_seq.size(); k++) { score_action(k); }
+    return;
+  }
+  data.predict_pool->parallel_for_ranges(ec_seq.size() - 1, [&score_action](size_t begin, size_t end) {
+    for (size_t k = begin + 1; k <= end; k++) { score_action(k); }
+  });
+}
+
+void predict_actions(ldf& data, single_learner& base, multi_ex& ec_seq)
+{
+  score_actions(data, ec_seq, [&data, &base, &ec_seq](size_t k) { make_single_prediction(data, base, *ec_seq[k]); });
 }
 
 bool test_ldf_sequence(ldf& data, multi_ex& ec_seq)
@@ -506,11 +539,11 @@ void predict_csoaa_ldf(ldf& data, single_learner& base, multi_ex& ec_seq_all)
   });
 
   /////////////////////// do prediction
+  predict_actions(data, base, ec_seq);
   float min_score = FLT_MAX;
   for (uint32_t k = 0; k < K; k++)
   {
     example* ec = ec_seq[k];
-    make_single_prediction(data, base, *ec);
     if (ec->partial_prediction < min_score)
     {
       min_score = ec->partial_prediction;
@@ -551,11 +584,11 @@ void predict_csoaa_ldf_rank(ldf& data, single_learner& base, multi_ex& ec_seq_al
     if (data.is_probabilities) { convert_to_probabilities(ec_seq); }
   });
 
+  for (uint32_t k = 0; k < K; k++) { data.stored_preds.emplace_back(std::move(ec_seq[k]->pred.a_s)); }
+  predict_actions(data, base, ec_seq);
   for (uint32_t k = 0; k < K; k++)
   {
     example* ec = ec_seq[k];
-    data.stored_preds.emplace_back(std::move(ec->pred.a_s));
-    make_single_prediction(data, base, *ec);
     action_score s;
     s.score = ec->partial_prediction;
     s.action = k;
@@ -563,6 +596,38 @@ void predict_csoaa_ldf_rank(ldf& data, single_learner& base, multi_ex& ec_seq_al
   }
 }
 
+// The ranking of every regressor of a multipredict. Each action is scored for all of them with one multipredict of the
+// base, which walks its features once, and pred[c].a_s gets the ranking of regressor c like predict_csoaa_ldf_rank.
+void multipredict_csoaa_ldf_rank(
+    ldf& data, single_learner& base, multi_ex& ec_seq_all, size_t count, size_t, polyprediction* pred, bool)
+{
+  data.ft_offset = ec_seq_all[0]->ft_offset;
+  auto ec_seq = process_labels(data, ec_seq_all);
+  for (size_t c = 0; c < count; c++) { pred[c].a_s.clear(); }
+  if (ec_seq.empty()) return;
+
+  const size_t K = ec_seq.size();
+  if (data.action_preds.size() < K * count) { data.action_preds.resize(K * count); }
+  polyprediction* action_preds = data.action_preds.data();
+  score_actions(data, ec_seq, [&data, &base, &ec_seq, count, action_preds](size_t k) {
+    make_single_prediction(data, *ec_seq[k], [&base, count, action_preds, k](example& ec) {
+      base.multipredict(ec, 0, count, action_preds + k * count, false);
+    });
+  });
+
+  for (size_t c = 0; c < count; c++)
+  {
+    for (uint32_t k = 0; k < K; k++)
+    {
+      action_score s;
+      s.score = action_preds[k * count + c].scalar;
+      s.action = k;
+      pred[c].a_s.push_back(s);
+    }
+    qsort((void*)pred[c].a_s.begin(), pred[c].a_s.size(), sizeof(action_score), score_comp);
+  }
+}
+
 void global_print_newline(vw& all)
 {
   char temp[1];
@@ -836,6 +901,11 @@ base_learner* csldf_setup(options_i& options, vw& all)
   csldf_outer_options.add(make_option("csoaa_rank", ld->rank).keep().help("Return actions sorted by score order"));
   csldf_outer_options.add(
       make_option("probabilities", ld->is_probabilities).keep().help("predict probabilites of all classes"));
+  int predict_threads = 1;
+  csldf_outer_options.add(make_option("ldf_predict_threads", predict_threads)
+                              .default_value(1)
+                              .help("Number of threads that score the actions of a multiline example when predicting. "
+                                    "Requires dense weights and only gd and the scorer below."));
 
   option_group_definition csldf_inner_options("Cost Sensitive weighted all-pairs with Label Dependent Features");
   csldf_inner_options.add(make_option("wap_ldf", wap_ldf)
@@ -902,8 +972,29 @@ base_learner* csldf_setup(options_i& options, vw& all)
   single_learner* pbase = as_singleline(setup_base(*all.options, all));
   learner<ldf, multi_ex>* pl = nullptr;
 
+  if (predict_threads < 1) { THROW("ldf_predict_threads must be positive"); }
+  if (predict_threads > 1)
+  {
+    // The actions are scored concurrently, so the reductions below must not keep state across a predict call.
+    for (const auto& reduction : all.enabled_reductions)
+    {
+      if (reduction != "gd" && reduction != "scorer")
+      { THROW("ldf_predict_threads only supports gd, but the " << reduction << " reduction is enabled"); }
+    }
+    // A lookup in sparse weights inserts the missing weight.
+    if (all.weights.sparse) THROW("ldf_predict_threads requires dense weights, it can't be used with --sparse_weights");
+    if (all.audit || all.hash_inv) THROW("ldf_predict_threads can't be used with audit or invert_hash");
+    ld->predict_pool = VW::make_unique<VW::thread_pool>(static_cast<size_t>(predict_threads));
+  }
+
   std::string name = all.get_setupfn_name(csldf_setup);
-  if (ld->rank)
+  if (ld->rank && !ld->is_probabilities)
+  {
+    pl = &init_learner(
+        ld, pbase, learn_csoaa_ldf, predict_csoaa_ldf_rank, 1, prediction_type_t::action_scores, name + "-ldf_rank");
+    pl->set_multipredict(multipredict_csoaa_ldf_rank);
+  }
+  else if (ld->rank)
     pl = &init_learner(
         ld, pbase, learn_csoaa_ldf, predict_csoaa_ldf_rank, 1, prediction_type_t::action_scores, name + "-ldf_rank");
   else if (ld->is_probabilities)
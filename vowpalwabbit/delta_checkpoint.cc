@@ -0,0 +1,261 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "delta_checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "io/io_adapter.h"
+#include "shared_data.h"
+#include "vw.h"
+#include "vw_exception.h"
+
+namespace
+{
+constexpr uint32_t DELTA_MAGIC = 0x41544c44;  // "DLTA"
+constexpr uint32_t DELTA_VERSION = 1;
+
+// The finalizer of splitmix64.
+uint64_t mix(uint64_t h)
+{
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+// Weights that are all 0 don't count, so a weight that a sparse table never allocated fingerprints like a 0 weight of
+// a dense table. Block fingerprints are sums, because sparse tables are not iterated in index order.
+uint64_t weight_fingerprint(uint64_t index, const weight* w, uint32_t floats)
+{
+  uint64_t h = mix(index + 1);
+  bool trained = false;
+  for (uint32_t j = 0; j < floats; ++j)
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &w[j], sizeof(bits));
+    h = mix(h ^ bits);
+    trained = trained || w[j] != 0.f;
+  }
+  return trained ? h : 0;
+}
+
+uint64_t table_fingerprint(const std::vector<uint64_t>& blocks)
+{
+  uint64_t h = mix(blocks.size());
+  for (uint64_t fingerprint : blocks) { h = mix(h ^ fingerprint); }
+  return h;
+}
+
+void check_baseline(vw& all)
+{
+  if (all.checkpoint_fingerprints.empty())
+    THROW("There is no checkpoint to save a delta against, save a full model with --delta_checkpoints first");
+}
+
+// The floats of every weight that a model saves.
+uint32_t saved_floats(vw& all) { return all.save_resume ? (1 << all.weights.stride_shift()) : 1; }
+
+uint64_t block_count(vw& all)
+{
+  const uint64_t length = static_cast<uint64_t>(1) << all.num_bits;
+  return (length + VW::DELTA_BLOCK_WEIGHTS - 1) >> VW::DELTA_BLOCK_SHIFT;
+}
+
+template <class T>
+void fingerprint_blocks(T& weights, uint32_t floats, std::vector<uint64_t>& blocks)
+{
+  const uint32_t shift = weights.stride_shift();
+  for (auto it = weights.begin(); it != weights.end(); ++it)
+  {
+    const uint64_t i = it.index() >> shift;
+    blocks[i >> VW::DELTA_BLOCK_SHIFT] += weight_fingerprint(i, &(*it), floats);
+  }
+}
+
+// Indices of the trained weights in the given blocks, in index order.
+template <class T>
+std::vector<uint64_t> trained_weights(T& weights, uint32_t floats, const std::vector<bool>& changed)
+{
+  const uint32_t shift = weights.stride_shift();
+  std::vector<uint64_t> indices;
+  for (auto it = weights.begin(); it != weights.end(); ++it)
+  {
+    const uint64_t i = it.index() >> shift;
+    const weight* w = &(*it);
+    if (changed[i >> VW::DELTA_BLOCK_SHIFT] && std::any_of(w, w + floats, [](weight f) { return f != 0.f; }))
+    { indices.push_back(i); }
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+template <class T>
+void clear_blocks(T& weights, uint32_t floats, const std::vector<bool>& changed)
+{
+  const uint32_t shift = weights.stride_shift();
+  for (auto it = weights.begin(); it != weights.end(); ++it)
+  {
+    if (changed[(it.index() >> shift) >> VW::DELTA_BLOCK_SHIFT]) { std::fill(&(*it), &(*it) + floats, 0.f); }
+  }
+}
+
+template <typename U>
+void write_value(io_buf& buf, U value)
+{
+  buf.bin_write_fixed(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename U>
+U read_value(io_buf& buf)
+{
+  U value{};
+  if (buf.bin_read_fixed(reinterpret_cast<char*>(&value), sizeof(value), "") != sizeof(value))
+    THROW("Delta checkpoint is truncated");
+  return value;
+}
+}  // namespace
+
+std::vector<uint64_t> VW::weight_block_fingerprints(vw& all)
+{
+  std::vector<uint64_t> blocks(block_count(all), 0);
+  if (all.weights.sparse)
+    fingerprint_blocks(all.weights.sparse_weights, saved_floats(all), blocks);
+  else
+    fingerprint_blocks(all.weights.dense_weights, saved_floats(all), blocks);
+  return blocks;
+}
+
+void VW::reset_delta_baseline(vw& all) { all.checkpoint_fingerprints = weight_block_fingerprints(all); }
+
+void VW::save_delta(vw& all, io_buf& buf)
+{
+  check_baseline(all);
+
+  auto fingerprints = weight_block_fingerprints(all);
+  if (fingerprints.size() != all.checkpoint_fingerprints.size())
+    THROW("The weight table changed size since the last checkpoint");
+  std::vector<bool> changed(fingerprints.size());
+  uint64_t changed_count = 0;
+  for (size_t b = 0; b < fingerprints.size(); ++b)
+  {
+    changed[b] = fingerprints[b] != all.checkpoint_fingerprints[b];
+    changed_count += changed[b] ? 1 : 0;
+  }
+
+  const uint32_t floats = saved_floats(all);
+  const auto indices = all.weights.sparse ? trained_weights(all.weights.sparse_weights, floats, changed)
+                                          : trained_weights(all.weights.dense_weights, floats, changed);
+
+  write_value(buf, DELTA_MAGIC);
+  write_value(buf, DELTA_VERSION);
+  write_value(buf, floats);
+  write_value(buf, static_cast<uint64_t>(1) << all.num_bits);
+  write_value(buf, table_fingerprint(all.checkpoint_fingerprints));
+  write_value(buf, table_fingerprint(fingerprints));
+  write_value(buf, all.sd->min_label);
+  write_value(buf, all.sd->max_label);
+  write_value(buf, changed_count);
+
+  // Every changed block with the weights of it that are not 0, the others are 0 after the delta is applied.
+  auto next = indices.begin();
+  for (uint64_t b = 0; b < fingerprints.size(); ++b)
+  {
+    if (!changed[b]) { continue; }
+    const auto end = std::lower_bound(next, indices.end(), (b + 1) << DELTA_BLOCK_SHIFT);
+    write_value(buf, b);
+    write_value(buf, static_cast<uint64_t>(end - next));
+    for (; next != end; ++next)
+    {
+      write_value(buf, *next);
+      buf.bin_write_fixed(reinterpret_cast<const char*>(&all.weights.strided_index(*next)), floats * sizeof(weight));
+    }
+  }
+  all.checkpoint_fingerprints = std::move(fingerprints);
+}
+
+void VW::apply_delta(vw& all, io_buf& buf)
+{
+  if (!all.weights.sparse && all.weights.dense_weights.read_only())
+    THROW("Deltas can't be applied to a memory mapped model");
+  if (read_value<uint32_t>(buf) != DELTA_MAGIC) THROW("Not a delta checkpoint");
+  const auto version = read_value<uint32_t>(buf);
+  if (version != DELTA_VERSION) THROW("Unsupported delta checkpoint version " << version);
+
+  const auto floats = read_value<uint32_t>(buf);
+  const auto length = read_value<uint64_t>(buf);
+  const auto parent = read_value<uint64_t>(buf);
+  const auto result = read_value<uint64_t>(buf);
+  const auto min_label = read_value<float>(buf);
+  const auto max_label = read_value<float>(buf);
+  const auto changed_count = read_value<uint64_t>(buf);
+  if (length != static_cast<uint64_t>(1) << all.num_bits)
+    THROW("The delta checkpoint is for " << length << " weights, but the model has " << (1ULL << all.num_bits));
+  if (floats != saved_floats(all))
+    THROW("The delta checkpoint holds " << floats << " floats per weight, but the model saves " << saved_floats(all)
+                                        << ", use the same --save_resume setting as the model that made it");
+  if (table_fingerprint(weight_block_fingerprints(all)) != parent)
+    THROW("The delta checkpoint was not made from this model, deltas must be applied in order onto their base model");
+
+  struct entry
+  {
+    uint64_t index;
+    std::vector<weight> values;
+  };
+  const uint64_t blocks = block_count(all);
+  std::vector<bool> changed(blocks);
+  std::vector<entry> entries;
+  for (uint64_t n = 0; n < changed_count; ++n)
+  {
+    const auto b = read_value<uint64_t>(buf);
+    const auto count = read_value<uint64_t>(buf);
+    if (b >= blocks || count > DELTA_BLOCK_WEIGHTS) THROW("Delta checkpoint is corrupted, invalid block " << b);
+    changed[b] = true;
+    for (uint64_t k = 0; k < count; ++k)
+    {
+      entries.push_back(entry{read_value<uint64_t>(buf), std::vector<weight>(floats)});
+      if ((entries.back().index >> DELTA_BLOCK_SHIFT) != b) THROW("Delta checkpoint is corrupted, invalid weight");
+      const size_t bytes = floats * sizeof(weight);
+      if (buf.bin_read_fixed(reinterpret_cast<char*>(entries.back().values.data()), bytes, "") != bytes)
+        THROW("Delta checkpoint is truncated");
+    }
+  }
+
+  if (all.weights.sparse)
+    clear_blocks(all.weights.sparse_weights, floats, changed);
+  else
+    clear_blocks(all.weights.dense_weights, floats, changed);
+  for (const auto& e : entries) { std::copy(e.values.begin(), e.values.end(), &all.weights.strided_index(e.index)); }
+  all.sd->min_label = min_label;
+  all.sd->max_label = max_label;
+
+  auto fingerprints = weight_block_fingerprints(all);
+  if (table_fingerprint(fingerprints) != result) THROW("Delta checkpoint is corrupted, the weights don't match it");
+  if (all.delta_checkpoints) { all.checkpoint_fingerprints = std::move(fingerprints); }
+}
+
+void VW::save_delta(vw& all, const std::string& delta_name)
+{
+  check_baseline(all);
+
+  const std::string start_name = delta_name + ".writing";
+  {
+    io_buf buf;
+    buf.add_file(VW::io::open_file_writer(start_name));
+    save_delta(all, buf);
+    buf.flush();
+    buf.close_file();
+  }
+  remove(delta_name.c_str());
+  if (0 != rename(start_name.c_str(), delta_name.c_str()))
+    THROW("save_delta: cannot rename " << start_name << " to " << delta_name);
+}
+
+void VW::apply_delta(vw& all, const std::string& delta_name)
+{
+  io_buf buf;
+  buf.add_file(VW::io::open_file_reader(delta_name));
+  apply_delta(all, buf);
+}
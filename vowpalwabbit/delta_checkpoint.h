@@ -0,0 +1,40 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "global_data.h"
+#include "io_buf.h"
+
+// Delta checkpoints hold only the blocks of the weight table that changed since the previous checkpoint, so a model
+// that is shipped often doesn't have to be rewritten every time. A checkpoint is a full model or a delta. Changes are
+// found by fingerprinting every block of DELTA_BLOCK_WEIGHTS weights at each checkpoint and comparing the fingerprints
+// with the ones of the previous checkpoint, which costs one pass over the table but no work in the learning path and
+// no copy of the weights.
+//
+// A delta records the fingerprint of the table it applies to and of the table it produces, so a chain of deltas can
+// only be applied in order onto the model it was made from. It covers the weights as a model saves them, the first
+// float of every weight or all of them with --save_resume, and the label range. Everything else, e.g. the state of
+// the reductions, comes from the base model.
+namespace VW
+{
+constexpr uint32_t DELTA_BLOCK_SHIFT = 10;
+constexpr uint64_t DELTA_BLOCK_WEIGHTS = static_cast<uint64_t>(1) << DELTA_BLOCK_SHIFT;
+
+/// Fingerprint of every block of the weight table, 0 for a block whose weights are all 0.
+std::vector<uint64_t> weight_block_fingerprints(vw& all);
+
+/// Makes the current weights the checkpoint that the next delta is relative to.
+void reset_delta_baseline(vw& all);
+
+/// Writes the blocks that changed since the last checkpoint and makes the current weights the new checkpoint.
+void save_delta(vw& all, io_buf& buf);
+
+/// Applies a delta made from exactly the current weights.
+void apply_delta(vw& all, io_buf& buf);
+}  // namespace VW
@@ -33,6 +33,7 @@ namespace VW
 {
 void copy_example_data(example* dst, const example* src);
 void setup_example(vw& all, example* ae);
+void setup_example_features(vw& all, example* ae);
 }  // namespace VW
 
 struct polylabel
@@ -144,6 +145,7 @@ struct example : public example_predict  // core example datatype.
 
   friend void VW::copy_example_data(example* dst, const example* src);
   friend void VW::setup_example(vw& all, example* ae);
+  friend void VW::setup_example_features(vw& all, example* ae);
 
 private:
   bool total_sum_feat_sq_calculated = false;
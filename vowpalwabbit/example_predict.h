@@ -8,6 +8,7 @@ typedef unsigned char namespace_index;
 #include "constant.h"
 #include "future_compat.h"
 #include "reduction_features.h"
+#include "feature_arena.h"
 #include "feature_group.h"
 #include "v_array.h"
 
@@ -27,15 +28,25 @@ typedef unsigned char namespace_index;
 #  include <mutex>
 #endif
 
+// A part of the prediction of an example that gd computed once for an ft_offset and set of interactions, see
+// shared_context_scores and stable_scores.
+struct partial_score
+{
+  uint64_t ft_offset;
+  const std::vector<std::vector<namespace_index>>* interactions;
+  float score;
+  size_t num_interacted_features;
+};
+
 struct example_predict
 {
   class iterator
   {
-    features* _feature_space;
+    VW::feature_arena* _feature_space;
     v_array<namespace_index>::iterator _index;
 
   public:
-    iterator(features* feature_space, namespace_index* index);
+    iterator(VW::feature_arena* feature_space, namespace_index* index);
     features& operator*();
     iterator& operator++();
     namespace_index index();
@@ -56,14 +67,26 @@ struct example_predict
   iterator end();
 
   v_array<namespace_index> indices;
-  std::array<features, NUM_NAMESPACES> feature_space;  // Groups of feature values.
-  uint64_t ft_offset = 0;                              // An offset for all feature values.
+  VW::feature_arena feature_space;  // Groups of feature values, by namespace.
+  uint64_t ft_offset = 0;           // An offset for all feature values.
 
   // Interactions are specified by this struct's interactions vector of vectors of unsigned characters, where each
   // vector is an interaction and each char is a namespace.
   std::vector<std::vector<namespace_index>>* interactions = nullptr;
   reduction_features _reduction_features;
 
+  // Set by shared_feature_merger instead of copying the namespaces of the shared example into this example. gd then
+  // treats them as part of this example, except for the constant namespace of the shared example.
+  example_predict* shared_context = nullptr;
+  // Only used on a shared_context: its part of the predictions, cached by gd until it changes the weights.
+  std::vector<partial_score> shared_context_scores;
+
+  // Set by ccb on its actions while predicting: the namespaces that change from one slot to the next. gd keeps the part
+  // of the prediction that doesn't involve them in stable_scores until ccb clears it. Must not be set while gd changes
+  // the weights.
+  const std::array<bool, NUM_NAMESPACES>* varying_namespaces = nullptr;
+  std::vector<partial_score> stable_scores;
+
   // Used for debugging reductions.  Keeps track of current reduction level.
   uint32_t _debug_current_reduction_depth = 0;
 };
@@ -0,0 +1,126 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "feature_arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+// The values of a region take half a word each, rounded up so that the next region starts on a word.
+size_t region_words(size_t capacity) { return capacity + (capacity + 1) / 2; }
+
+// Only groups with an index for every value can be packed.
+bool packable(const features& fs) { return fs.values.size() == fs.indicies.size(); }
+
+// Moves the elements of v out of a borrowed buffer into memory of its own.
+template <class T>
+void own(v_array<T>& v)
+{
+  if (v.borrowed())
+  {
+    v_array<T> copy(v);
+    v = std::move(copy);
+  }
+}
+}  // namespace
+
+namespace VW
+{
+constexpr uint16_t feature_arena::NO_GROUP;
+const features feature_arena::EMPTY_GROUP;
+
+feature_arena::feature_arena() { _directory.fill(NO_GROUP); }
+
+// The groups borrow from the block, which moves along with them.
+feature_arena::feature_arena(feature_arena&& other) : feature_arena() { *this = std::move(other); }
+
+feature_arena& feature_arena::operator=(feature_arena&& other)
+{
+  std::swap(_directory, other._directory);
+  std::swap(_groups, other._groups);
+  std::swap(_regions, other._regions);
+  std::swap(_next_regions, other._next_regions);
+  std::swap(_block, other._block);
+  std::swap(_block_words, other._block_words);
+  return *this;
+}
+
+features& feature_arena::add_group(size_t ns)
+{
+  _directory[ns] = static_cast<uint16_t>(_groups.size());
+  _groups.emplace_back();
+  return _groups.back();
+}
+
+bool feature_arena::in_region(const features& fs, const region& r) const
+{
+  return r.capacity > 0 && fs.indicies.borrowed() && fs.values.borrowed() && fs.indicies.data() == indices_of(r) &&
+      fs.values.data() == values_of(r);
+}
+
+bool feature_arena::holds(size_t ns) const
+{
+  const uint16_t group = _directory[ns];
+  return group != NO_GROUP && group < _regions.size() && in_region(_groups[group], _regions[group]);
+}
+
+void feature_arena::pack()
+{
+  for (size_t group = 0; group < _groups.size(); ++group)
+  {
+    const features& fs = _groups[group];
+    if (fs.empty() || !packable(fs)) { continue; }
+    if (group >= _regions.size() || !in_region(fs, _regions[group]))
+    {
+      layout();
+      return;
+    }
+  }
+}
+
+// Lays the block out again, with a region for every group. A region that is too small for its group at least doubles,
+// so each group is laid out a logarithmic number of times. The new block is filled from the groups before the old one
+// is freed, wherever their features are.
+void feature_arena::layout()
+{
+  _next_regions.clear();
+  size_t words = 0;
+  for (size_t group = 0; group < _groups.size(); ++group)
+  {
+    const features& fs = _groups[group];
+    size_t capacity = group < _regions.size() ? _regions[group].capacity : 0;
+    if (packable(fs) && fs.size() > capacity) { capacity = std::max(fs.size(), 2 * capacity); }
+    _next_regions.push_back({words, capacity});
+    words += region_words(capacity);
+  }
+
+  std::unique_ptr<uint64_t[]> block(new uint64_t[words]);
+  std::swap(_block, block);
+  _block_words = words;
+  for (size_t group = 0; group < _groups.size(); ++group)
+  {
+    features& fs = _groups[group];
+    const region& r = _next_regions[group];
+    // A group without a region or without an index for some values leaves the old block, which is freed below.
+    if (r.capacity == 0 || !packable(fs))
+    {
+      own(fs.indicies);
+      own(fs.values);
+      continue;
+    }
+    const size_t size = fs.size();
+    if (size > 0)
+    {
+      memcpy(indices_of(r), fs.indicies.data(), size * sizeof(feature_index));
+      memcpy(values_of(r), fs.values.data(), size * sizeof(feature_value));
+    }
+    fs.indicies.borrow(indices_of(r), size, r.capacity);
+    fs.values.borrow(values_of(r), size, r.capacity);
+  }
+  std::swap(_regions, _next_regions);
+}
+}  // namespace VW
@@ -0,0 +1,97 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "constant.h"
+#include "feature_group.h"
+
+namespace VW
+{
+// The feature groups of an example. Only the namespaces an example uses have a group, found through a small directory
+// by namespace, and the indices and values of all groups live in one contiguous block: every group borrows a region of
+// it, its indices followed by its values (see v_array::borrow).
+//
+// An example recycled through the example pool keeps its groups and its block, so the next example parsed into it
+// fills the regions in place. A group that outgrows its region moves to memory of its own until the next pack() lays
+// the block out again. A group may be swapped with the group of another example, as reductions do for the duration of
+// a call, but must be swapped back before either example is packed or destroyed.
+class feature_arena
+{
+public:
+  using iterator = std::deque<features>::iterator;
+  using const_iterator = std::deque<features>::const_iterator;
+
+  feature_arena();
+  feature_arena(const feature_arena&) = delete;
+  feature_arena& operator=(const feature_arena&) = delete;
+  feature_arena(feature_arena&& other);
+  feature_arena& operator=(feature_arena&& other);
+
+  /// The group of namespace ns, added the first time it is asked for. References to groups stay valid while others
+  /// are added.
+  features& operator[](size_t ns)
+  {
+    const uint16_t group = _directory[ns];
+    return group != NO_GROUP ? _groups[group] : add_group(ns);
+  }
+
+  /// The group of namespace ns, or an empty group if the example never used ns.
+  const features& operator[](size_t ns) const
+  {
+    const uint16_t group = _directory[ns];
+    return group != NO_GROUP ? _groups[group] : EMPTY_GROUP;
+  }
+
+  /// The groups, in the order their namespaces were first used.
+  iterator begin() { return _groups.begin(); }
+  iterator end() { return _groups.end(); }
+  const_iterator begin() const { return _groups.begin(); }
+  const_iterator end() const { return _groups.end(); }
+
+  /// Moves the groups that are not in their region into the block. Nothing is copied when every group already is,
+  /// which is the common case for a recycled example. Must be called when no one else holds a group of the example.
+  void pack();
+
+  /// Whether the group of namespace ns is in its region of the block.
+  bool holds(size_t ns) const;
+
+  /// The size of the block in bytes.
+  size_t capacity_bytes() const { return _block_words * sizeof(uint64_t); }
+
+private:
+  static constexpr uint16_t NO_GROUP = UINT16_MAX;
+  static const features EMPTY_GROUP;
+
+  struct region
+  {
+    size_t offset;    // in words of the block
+    size_t capacity;  // in features
+  };
+
+  features& add_group(size_t ns);
+  feature_index* indices_of(const region& r) const { return reinterpret_cast<feature_index*>(_block.get() + r.offset); }
+  feature_value* values_of(const region& r) const
+  {
+    return reinterpret_cast<feature_value*>(_block.get() + r.offset + r.capacity);
+  }
+  bool in_region(const features& fs, const region& r) const;
+  void layout();
+
+  std::unique_ptr<uint64_t[]> _block;
+  size_t _block_words = 0;
+  std::array<uint16_t, NUM_NAMESPACES> _directory;
+  std::vector<region> _regions;       // of the groups, in the same order
+  std::vector<region> _next_regions;  // scratch of layout
+  // Declared after the block, so the groups borrowing from it go first.
+  std::deque<features> _groups;
+};
+}  // namespace VW
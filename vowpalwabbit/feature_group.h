@@ -7,6 +7,7 @@
 #include "v_array.h"
 #include "future_compat.h"
 #include "generic_range.h"
+#include "interned_string.h"
 
 #include <utility>
 #include <memory>
@@ -18,7 +19,17 @@
 
 using feature_value = float;
 using feature_index = uint64_t;
-using audit_strings = std::pair<std::string, std::string>;
+
+// The namespace and feature name of a feature in audit mode. Both are interned, so pushing them for every feature of
+// an example doesn't copy any strings.
+struct audit_strings
+{
+  VW::interned_string first;   // namespace
+  VW::interned_string second;  // feature
+
+  audit_strings() = default;
+  audit_strings(VW::interned_string ns, VW::interned_string feature) : first(ns), second(feature) {}
+};
 
 struct features;
 struct features_value_index_audit_range;
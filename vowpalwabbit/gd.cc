@@ -20,6 +20,7 @@
 #include "accumulate.h"
 #include "debug_log.h"
 #include "gd.h"
+#include "model_segments.h"
 #include "reductions.h"
 #include "vw.h"
 #include "shared_data.h"
@@ -40,6 +41,30 @@ namespace logger = VW::io::logger;
 // 4. Factor various state out of vw&
 namespace GD
 {
+// Normalization state of one --learn_threads worker. The padding keeps workers off each other's cache lines.
+struct learn_thread_state
+{
+  double total_weight = 0.;
+  double normalized_sum_norm_x = 0.;
+  float update_multiplier = 0.f;
+  char padding[64];
+};
+
+struct power_data
+{
+  float minus_power_t;
+  float neg_norm_power;
+};
+
+struct norm_data
+{
+  float grad_squared;
+  float pred_per_update;
+  float norm_x;
+  power_data pd;
+  float extra_state[4];
+};
+
 struct gd
 {
   //  double normalized_sum_norm_x;
@@ -54,14 +79,37 @@ struct gd
   void (*predict)(gd&, base_learner&, example&);
   void (*learn)(gd&, base_learner&, example&);
   void (*update)(gd&, base_learner&, example&);
+  void (*multiupdate)(gd&, base_learner&, example&, size_t, size_t, polyprediction*, const float*);
   float (*sensitivity)(gd&, base_learner&, example&);
   void (*multipredict)(gd&, base_learner&, example&, size_t, size_t, polyprediction*, bool);
   bool adaptive_input;
   bool normalized_input;
   bool adax;
   vw* all;  // parallel, features, parameters
+
+  // Only used with --learn_threads. The update multiplier is computed and consumed within one update so every worker
+  // keeps its own. With thread_local_norm the normalization totals are also accumulated per worker and folded into
+  // total_weight and normalized_sum_norm_x at the end of each pass and before saving.
+  std::vector<learn_thread_state> thread_states;
+  bool thread_local_norm;
+
+  // Per regressor state of multiupdate.
+  std::vector<norm_data> multi_norms;
+  std::vector<float> multi_updates;
+  std::vector<bool> multi_has_loss;
 };
 
+void merge_thread_states(gd& g)
+{
+  for (auto& state : g.thread_states)
+  {
+    g.total_weight += state.total_weight;
+    g.all->normalized_sum_norm_x += state.normalized_sum_norm_x;
+    state.total_weight = 0.;
+    state.normalized_sum_norm_x = 0.;
+  }
+}
+
 void sync_weights(vw& all);
 
 inline float quake_InvSqrt(float x)
@@ -117,6 +165,42 @@ inline void update_feature(float& update, float x, float& fw)
   }
 }
 
+template <bool feature_mask_off, size_t spare>
+struct update_run_kernel
+{
+  static constexpr bool available = true;
+  static bool run(float& update, const float* x, float* w, size_t count, uint32_t stride)
+  {
+    return dense_update(update, x, w, count, stride, spare, feature_mask_off);
+  }
+};
+
+// The default adaptive, normalized update and plain sgd. Other combinations use the per feature loop.
+template <>
+struct dense_run_kernel<float, update_feature<true, true, 1, 2, 3> > : update_run_kernel<true, 3>
+{
+};
+template <>
+struct dense_run_kernel<float, update_feature<true, false, 1, 2, 3> > : update_run_kernel<false, 3>
+{
+};
+template <>
+struct dense_run_kernel<float, update_feature<true, true, 0, 0, 0> > : update_run_kernel<true, 0>
+{
+};
+template <>
+struct dense_run_kernel<float, update_feature<true, false, 0, 0, 0> > : update_run_kernel<false, 0>
+{
+};
+template <>
+struct dense_run_kernel<float, update_feature<false, true, 0, 0, 0> > : update_run_kernel<true, 0>
+{
+};
+template <>
+struct dense_run_kernel<float, update_feature<false, false, 0, 0, 0> > : update_run_kernel<false, 0>
+{
+};
+
 // this deals with few nonzero features vs. all nonzero features issues.
 template <bool sqrt_rate, size_t adaptive, size_t normalized>
 float average_update(float total_weight, float normalized_sum_norm_x, float neg_norm_power)
@@ -140,7 +224,11 @@ float average_update(float total_weight, float normalized_sum_norm_x, float neg_
 template <bool sqrt_rate, bool feature_mask_off, size_t adaptive, size_t normalized, size_t spare>
 void train(gd& g, example& ec, float update)
 {
-  if VW_STD17_CONSTEXPR (normalized != 0) { update *= g.update_multiplier; }
+  if VW_STD17_CONSTEXPR (normalized != 0)
+  {
+    update *= g.thread_states.empty() ? g.update_multiplier
+                                      : g.thread_states[VW::LEARNER::learn_thread_index()].update_multiplier;
+  }
   VW_DBG(ec) << "gd: train() spare=" << spare << std::endl;
   foreach_feature<float, update_feature<sqrt_rate, feature_mask_off, adaptive, normalized, spare> >(*g.all, ec, update);
 }
@@ -148,6 +236,7 @@ void train(gd& g, example& ec, float update)
 void end_pass(gd& g)
 {
   vw& all = *g.all;
+  merge_thread_states(g);
   if (all.save_resume)
   {
     // TODO work out a better system to update state that will be saved in the model.
@@ -198,8 +287,9 @@ struct audit_results
 {
   vw& all;
   const uint64_t offset;
-  std::vector<std::string> ns_pre;
+  std::vector<const audit_strings*> ns_pre;  // the names of the features being interacted, rendered by audit_feature
   std::vector<string_value> results;
+  std::string name;  // scratch of render_name
   audit_results(vw& p_all, const size_t p_offset) : all(p_all), offset(p_offset) {}
 };
 
@@ -208,22 +298,26 @@ inline void audit_interaction(audit_results& dat, const audit_strings* f)
   if (f == nullptr)
   {
     if (!dat.ns_pre.empty()) { dat.ns_pre.pop_back(); }
-
     return;
   }
+  dat.ns_pre.push_back(f);
+}
 
-  std::string ns_pre;
-  if (!dat.ns_pre.empty()) ns_pre += '*';
-
-  if (f->first != "" && ((f->first) != " "))
+// Renders the name of the current feature into dat.name, like ns^a*ns^b for an interaction. Names are only rendered
+// when they are printed or new to the invert hash map, not for every feature.
+void render_name(audit_results& dat)
+{
+  dat.name.clear();
+  for (const audit_strings* f : dat.ns_pre)
   {
-    ns_pre.append(f->first);
-    ns_pre += '^';
+    if (!dat.name.empty()) { dat.name += '*'; }
+    if (!f->first.empty() && f->first != " ")
+    {
+      dat.name += f->first.str();
+      dat.name += '^';
+    }
+    dat.name += f->second.str();
   }
-
-  if (f->second != "") { ns_pre.append(f->second); }
-
-  if (!ns_pre.empty()) { dat.ns_pre.push_back(ns_pre); }
 }
 
 inline void audit_feature(audit_results& dat, const float ft_weight, const uint64_t ft_idx)
@@ -231,9 +325,12 @@ inline void audit_feature(audit_results& dat, const float ft_weight, const uint6
   parameters& weights = dat.all.weights;
   uint64_t index = ft_idx & weights.mask();
   size_t stride_shift = weights.stride_shift();
+  const auto strided_index = index >> stride_shift;
 
-  std::string ns_pre;
-  for (std::string& s : dat.ns_pre) ns_pre += s;
+  const bool invert_hash = (dat.all.current_pass == 0 || dat.all.training == false) && dat.all.hash_inv &&
+      dat.all.index_name_map.count(strided_index) == 0;
+  if (!dat.all.audit && !invert_hash) { return; }
+  render_name(dat);
 
   if (dat.all.audit)
   {
@@ -245,11 +342,11 @@ inline void audit_feature(audit_results& dat, const float ft_weight, const uint6
     if (weights.adaptive)  // adaptive
       tempstream << '@' << (&weights[index])[1];
 
-    string_value sv = {weights[index] * ft_weight, ns_pre + tempstream.str()};
+    string_value sv = {weights[index] * ft_weight, dat.name + tempstream.str()};
     dat.results.push_back(sv);
   }
 
-  if ((dat.all.current_pass == 0 || dat.all.training == false) && dat.all.hash_inv)
+  if (invert_hash)
   {
     // for invert_hash
 
@@ -258,11 +355,9 @@ inline void audit_feature(audit_results& dat, const float ft_weight, const uint6
       // otherwise --oaa output no features for class > 0.
       std::ostringstream tempstream;
       tempstream << '[' << (dat.offset >> stride_shift) << ']';
-      ns_pre += tempstream.str();
+      dat.name += tempstream.str();
     }
-    const auto strided_index = index >> stride_shift;
-    if (!dat.all.index_name_map.count(strided_index))
-      dat.all.index_name_map.insert(std::make_pair(strided_index, ns_pre));
+    dat.all.index_name_map.insert(std::make_pair(strided_index, dat.name));
   }
 }
 
@@ -447,12 +542,6 @@ void multipredict(
   }
 }
 
-struct power_data
-{
-  float minus_power_t;
-  float neg_norm_power;
-};
-
 template <bool sqrt_rate, size_t adaptive, size_t normalized>
 inline float compute_rate_decay(power_data& s, float& fw)
 {
@@ -481,19 +570,6 @@ inline float compute_rate_decay(power_data& s, float& fw)
   return rate_decay;
 }
 
-struct norm_data
-{
-  float grad_squared;
-  float pred_per_update;
-  float norm_x;
-  power_data pd;
-  float extra_state[4];
-};
-
-constexpr float x_min = 1.084202e-19f;
-constexpr float x2_min = x_min * x_min;
-constexpr float x2_max = FLT_MAX;
-
 template <bool sqrt_rate, bool feature_mask_off, size_t adaptive, size_t normalized, size_t spare, bool stateless>
 inline void pred_per_update_feature(norm_data& nd, float x, float& fw)
 {
@@ -549,6 +625,28 @@ inline void pred_per_update_feature(norm_data& nd, float x, float& fw)
   }
 }
 
+template <bool feature_mask_off>
+struct pred_per_update_run_kernel
+{
+  static constexpr bool available = true;
+  static bool run(norm_data& nd, const float* x, float* w, size_t count, uint32_t stride)
+  {
+    return dense_pred_per_update_sqrt_rate(
+        nd.grad_squared, x, w, count, stride, feature_mask_off, nd.pred_per_update, nd.norm_x);
+  }
+};
+
+template <>
+struct dense_run_kernel<norm_data, pred_per_update_feature<true, true, 1, 2, 3, false> >
+    : pred_per_update_run_kernel<true>
+{
+};
+template <>
+struct dense_run_kernel<norm_data, pred_per_update_feature<true, false, 1, 2, 3, false> >
+    : pred_per_update_run_kernel<false>
+{
+};
+
 bool global_print_features = false;
 template <bool sqrt_rate, bool feature_mask_off, bool adax, size_t adaptive, size_t normalized, size_t spare,
     bool stateless>
@@ -568,7 +666,21 @@ float get_pred_per_update(gd& g, example& ec)
       pred_per_update_feature<sqrt_rate, feature_mask_off, adaptive, normalized, spare, stateless> >(all, ec, nd);
   if VW_STD17_CONSTEXPR (normalized != 0)
   {
-    if (!stateless)
+    if (!stateless && !g.thread_states.empty())
+    {
+      learn_thread_state& state = g.thread_states[VW::LEARNER::learn_thread_index()];
+      // Without thread_local_norm the shared totals are updated without synchronization, like the weights.
+      double& total_weight = g.thread_local_norm ? state.total_weight : g.total_weight;
+      double& sum_norm_x = g.thread_local_norm ? state.normalized_sum_norm_x : g.all->normalized_sum_norm_x;
+      sum_norm_x += (static_cast<double>(ec.weight)) * nd.norm_x;
+      total_weight += ec.weight;
+      state.update_multiplier = average_update<sqrt_rate, adaptive, normalized>(
+          static_cast<float>(g.total_weight + (g.thread_local_norm ? state.total_weight : 0.)),
+          static_cast<float>(g.all->normalized_sum_norm_x + (g.thread_local_norm ? state.normalized_sum_norm_x : 0.)),
+          g.neg_norm_power);
+      return nd.pred_per_update * state.update_multiplier;
+    }
+    else if (!stateless)
     {
       g.all->normalized_sum_norm_x += (static_cast<double>(ec.weight)) * nd.norm_x;
       g.total_weight += ec.weight;
@@ -674,8 +786,179 @@ void update(gd& g, base_learner&, example& ec)
 
   if (g.all->sd->contraction < 1e-9 || g.all->sd->gravity > 1e3)  // updating weights now to avoid numerical instability
     sync_weights(*g.all);
+
+  if (ec.shared_context != nullptr) { ec.shared_context->shared_context_scores.clear(); }
+}
+
+template <class T>
+struct multi_norm_data
+{
+  size_t count;
+  size_t step;
+  T& weights;
+  norm_data* norms;  // grad_squared is 0 for the regressors that are not updated
+};
+
+template <class T>
+struct multi_update_data
+{
+  size_t count;
+  size_t step;
+  T& weights;
+  const float* updates;
+};
+
+VW_WARNING_STATE_PUSH
+VW_WARNING_DISABLE_CPP_17_LANG_EXT
+template <class T, bool sqrt_rate, bool feature_mask_off, size_t adaptive, size_t normalized, size_t spare>
+inline void multi_pred_per_update_feature(multi_norm_data<T>& d, float x, uint64_t fi)
+{
+  for (size_t c = 0; c < d.count; ++c, fi += d.step)
+  {
+    if (d.norms[c].grad_squared != 0.f)
+    {
+      pred_per_update_feature<sqrt_rate, feature_mask_off, adaptive, normalized, spare, false>(
+          d.norms[c], x, d.weights[fi]);
+    }
+  }
+}
+
+template <class T, bool sqrt_rate, bool feature_mask_off, size_t adaptive, size_t normalized, size_t spare>
+inline void multi_update_feature(multi_update_data<T>& d, float x, uint64_t fi)
+{
+  for (size_t c = 0; c < d.count; ++c, fi += d.step)
+  {
+    float update = d.updates[c];
+    if (update != 0.f)
+    { update_feature<sqrt_rate, feature_mask_off, adaptive, normalized, spare>(update, x, d.weights[fi]); }
+  }
+}
+
+template <bool sqrt_rate, bool feature_mask_off, size_t adaptive, size_t normalized, size_t spare, class T>
+void multi_pred_per_update(gd& g, example& ec, size_t count, size_t step, T& weights)
+{
+  multi_norm_data<T> d = {count, step, weights, g.multi_norms.data()};
+  foreach_feature<multi_norm_data<T>, uint64_t,
+      multi_pred_per_update_feature<T, sqrt_rate, feature_mask_off, adaptive, normalized, spare> >(*g.all, ec, d);
+}
+
+template <bool sqrt_rate, bool feature_mask_off, size_t adaptive, size_t normalized, size_t spare, class T>
+void multi_train(gd& g, example& ec, size_t count, size_t step, T& weights)
+{
+  multi_update_data<T> d = {count, step, weights, g.multi_updates.data()};
+  foreach_feature<multi_update_data<T>, uint64_t,
+      multi_update_feature<T, sqrt_rate, feature_mask_off, adaptive, normalized, spare> >(*g.all, ec, d);
 }
 
+// Updates count regressors step apart like calling update for each in order, but walks the features and interactions
+// twice in total instead of twice per regressor. The regressors use disjoint weights, so only the normalization totals
+// depend on the order, and they are accumulated in order between the two walks.
+template <bool sparse_l2, bool invariant, bool sqrt_rate, bool feature_mask_off, bool adax, size_t adaptive,
+    size_t normalized, size_t spare>
+void multiupdate(
+    gd& g, base_learner& base, example& ec, size_t count, size_t step, polyprediction* pred, const float* labels)
+{
+  vw& all = *g.all;
+  if (count == 0) { return; }
+  // Regularization and --learn_threads change shared state after every update, so they keep the sequential order.
+  if (all.reg_mode != 0 || !g.thread_states.empty())
+  {
+    for (size_t c = 0; c < count; c++, ec.ft_offset += step)
+    {
+      ec.l.simple.label = labels[c];
+      ec.pred.scalar = pred[c].scalar;
+      update<sparse_l2, invariant, sqrt_rate, feature_mask_off, adax, adaptive, normalized, spare>(g, base, ec);
+    }
+    ec.ft_offset -= step * count;
+    return;
+  }
+
+  g.multi_norms.resize(count);
+  g.multi_updates.resize(count);
+  g.multi_has_loss.resize(count);
+  bool walk = false;
+  for (size_t c = 0; c < count; c++)
+  {
+    norm_data& nd = g.multi_norms[c];
+    nd = {0.f, 0.f, 0.f, {g.neg_power_t, g.neg_norm_power}, {0}};
+    g.multi_has_loss[c] = all.loss->getLoss(all.sd, pred[c].scalar, labels[c]) > 0.;
+    if (g.multi_has_loss[c])
+    {
+      nd.grad_squared = ec.weight;
+      if (!adax) nd.grad_squared *= all.loss->getSquareGrad(pred[c].scalar, labels[c]);
+      walk = walk || nd.grad_squared != 0.f;
+    }
+  }
+  if VW_STD17_CONSTEXPR (adaptive || normalized)
+  {
+    if (walk)
+    {
+      if (all.weights.sparse)
+        multi_pred_per_update<sqrt_rate, feature_mask_off, adaptive, normalized, spare>(
+            g, ec, count, step, all.weights.sparse_weights);
+      else
+        multi_pred_per_update<sqrt_rate, feature_mask_off, adaptive, normalized, spare>(
+            g, ec, count, step, all.weights.dense_weights);
+    }
+  }
+
+  const float update_scale = get_scale<adaptive>(g, ec, ec.weight);
+  bool train = false;
+  for (size_t c = 0; c < count; c++)
+  {
+    const float prediction = pred[c].scalar;
+    const float label = labels[c];
+    const norm_data& nd = g.multi_norms[c];
+    float update = 0.f;
+    ec.updated_prediction = prediction;
+    if (g.multi_has_loss[c])
+    {
+      float pred_per_update = 1.f;
+      if VW_STD17_CONSTEXPR (!adaptive && !normalized) { pred_per_update = ec.get_total_sum_feat_sq(); }
+      else if (nd.grad_squared != 0.f)
+      {
+        pred_per_update = nd.pred_per_update;
+        if VW_STD17_CONSTEXPR (normalized != 0)
+        {
+          all.normalized_sum_norm_x += (static_cast<double>(ec.weight)) * nd.norm_x;
+          g.total_weight += ec.weight;
+          g.update_multiplier = average_update<sqrt_rate, adaptive, normalized>(
+              static_cast<float>(g.total_weight), static_cast<float>(all.normalized_sum_norm_x), g.neg_norm_power);
+          pred_per_update *= g.update_multiplier;
+        }
+      }
+      if (invariant)
+        update = all.loss->getUpdate(prediction, label, update_scale, pred_per_update);
+      else
+        update = all.loss->getUnsafeUpdate(prediction, label, update_scale);
+      ec.updated_prediction += pred_per_update * update;
+    }
+    if (sparse_l2) update -= g.sparse_l2 * prediction;
+    if (std::isnan(update))
+    {
+      logger::errlog_warn("update is NAN, replacing with 0");
+      update = 0.;
+    }
+    if VW_STD17_CONSTEXPR (normalized != 0) { update *= g.update_multiplier; }
+    g.multi_updates[c] = update;
+    train = train || update != 0.f;
+  }
+
+  if (train)
+  {
+    if (all.weights.sparse)
+      multi_train<sqrt_rate, feature_mask_off, adaptive, normalized, spare>(
+          g, ec, count, step, all.weights.sparse_weights);
+    else
+      multi_train<sqrt_rate, feature_mask_off, adaptive, normalized, spare>(
+          g, ec, count, step, all.weights.dense_weights);
+  }
+  if (train && ec.shared_context != nullptr) { ec.shared_context->shared_context_scores.clear(); }
+  ec.l.simple.label = labels[count - 1];
+  ec.pred.scalar = pred[count - 1].scalar;
+}
+VW_WARNING_STATE_POP
+
 template <bool sparse_l2, bool invariant, bool sqrt_rate, bool feature_mask_off, bool adax, size_t adaptive,
     size_t normalized, size_t spare>
 void learn(gd& g, base_learner& base, example& ec)
@@ -787,9 +1070,104 @@ void save_load_regressor(vw& all, io_buf& model_file, bool read, bool text, T& w
       }
 }
 
+// With --mmap_model the weights are saved as one block holding one float per weight, without their update state.
+// The block starts at a multiple of MODEL_BLOCK_ALIGNMENT in the file, so a test only process, whose table has one
+// float per weight, can map it straight into dense_parameters and share its pages with every other process serving the
+// same model. It is always the last section of a model file.
+constexpr uint64_t MODEL_BLOCK_ALIGNMENT = static_cast<uint64_t>(1) << 16;  // a multiple of all common page sizes
+constexpr uint64_t MODEL_BLOCK_CHUNK = static_cast<uint64_t>(1) << 18;      // weights copied at a time
+
+void write_weight_block(io_buf& model_file, dense_parameters& weights)
+{
+  const uint32_t stride_shift = weights.stride_shift();
+  uint64_t weight_count = (weights.mask() + 1) >> stride_shift;
+  const uint64_t header_end = model_file.output_offset() + 2 * sizeof(uint64_t);
+  uint64_t block_offset = (header_end + MODEL_BLOCK_ALIGNMENT - 1) / MODEL_BLOCK_ALIGNMENT * MODEL_BLOCK_ALIGNMENT;
+  model_file.bin_write_fixed(reinterpret_cast<const char*>(&weight_count), sizeof(weight_count));
+  model_file.bin_write_fixed(reinterpret_cast<const char*>(&block_offset), sizeof(block_offset));
+  std::vector<char> padding(block_offset - header_end, 0);
+  model_file.bin_write_fixed(padding.data(), padding.size());
+
+  std::vector<weight> chunk;
+  for (uint64_t begin = 0; begin < weight_count; begin += MODEL_BLOCK_CHUNK)
+  {
+    const uint64_t end = std::min(weight_count, begin + MODEL_BLOCK_CHUNK);
+    chunk.resize(end - begin);
+    for (uint64_t i = begin; i < end; i++) { chunk[i - begin] = weights[i << stride_shift]; }
+    model_file.bin_write_fixed(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(weight));
+  }
+}
+
+// Copies the weights of the block into weights, whose stride may hold update state as well.
+void copy_weight_block(io_buf& model_file, dense_parameters& weights, uint64_t weight_count)
+{
+  std::vector<weight> chunk;
+  for (uint64_t begin = 0; begin < weight_count; begin += MODEL_BLOCK_CHUNK)
+  {
+    chunk.resize(static_cast<size_t>(std::min(weight_count - begin, MODEL_BLOCK_CHUNK)));
+    const size_t bytes = chunk.size() * sizeof(weight);
+    if (model_file.bin_read_fixed(reinterpret_cast<char*>(chunk.data()), bytes, "") != bytes)
+      THROW("Model content is corrupted, the weight block is truncated");
+    for (uint64_t i = 0; i < chunk.size(); i++)
+    {
+      if (chunk[i] != 0.f) { weights.strided_index(begin + i) = chunk[i]; }
+    }
+  }
+}
+
+void read_weight_block(vw& all, io_buf& model_file, dense_parameters& weights)
+{
+  uint64_t weight_count = 0;
+  uint64_t block_offset = 0;
+  size_t brw = model_file.bin_read_fixed(reinterpret_cast<char*>(&weight_count), sizeof(weight_count), "");
+  brw += model_file.bin_read_fixed(reinterpret_cast<char*>(&block_offset), sizeof(block_offset), "");
+  const uint64_t length = static_cast<uint64_t>(1) << all.num_bits;
+  const uint64_t position = model_file.input_offset();
+  if (brw != 2 * sizeof(uint64_t) || block_offset < position || block_offset - position >= MODEL_BLOCK_ALIGNMENT ||
+      weight_count != length)
+    THROW("Model content is corrupted, the weight block does not hold " << length << " weights");
+
+  // Mapped weights are read only, so they can only be used when nothing is learned or written into them.
+  if (!all.training && all.feature_mask.empty() && weights.stride_shift() == 0 && !weights.seeded() &&
+      model_file.current < model_file.num_input_files())
+  {
+    VW::page_region region;
+    const int fd = model_file.get_input_files()[model_file.current]->file_descriptor();
+    if (VW::map_file_pages(fd, block_offset, weight_count * sizeof(weight), region))
+    {
+      weights.adopt_pages(region);
+      return;
+    }
+  }
+
+  std::vector<char> padding(static_cast<size_t>(block_offset - position));
+  if (model_file.bin_read_fixed(padding.data(), padding.size(), "") != padding.size())
+    THROW("Model content is corrupted, the weight block is truncated");
+  copy_weight_block(model_file, weights, weight_count);
+}
+
+// Saves or loads the first floats_per_weight floats of every weight as a chunked container, see model_segments.h.
+void save_load_weight_segments(vw& all, io_buf& model_file, bool read, uint32_t floats_per_weight)
+{
+  if (read)
+    VW::read_weight_segments(model_file, all.weights.dense_weights, all.model_threads);
+  else
+    VW::write_weight_segments(
+        model_file, all.weights.dense_weights, floats_per_weight, all.model_threads, all.compress_model_segments);
+}
+
 void save_load_regressor(vw& all, io_buf& model_file, bool read, bool text)
 {
-  if (all.weights.sparse)
+  if (all.mmap_model && !text && !all.weights.sparse)
+  {
+    if (read)
+      read_weight_block(all, model_file, all.weights.dense_weights);
+    else
+      write_weight_block(model_file, all.weights.dense_weights);
+  }
+  else if (all.chunked_model && !text && !all.print_invert && !all.weights.sparse)
+    save_load_weight_segments(all, model_file, read, 1);
+  else if (all.weights.sparse)
     save_load_regressor(all, model_file, read, text, all.weights.sparse_weights);
   else
     save_load_regressor(all, model_file, read, text, all.weights.dense_weights);
@@ -1014,7 +1392,17 @@ void save_load_online_state(
     all.sd->total_features = 0;
     all.current_pass = 0;
   }
-  if (all.weights.sparse)
+  if (all.chunked_model && !text && !all.print_invert && !all.weights.sparse)
+  {
+    // The same number of floats per weight as the sequential format saves.
+    uint32_t floats_per_weight = 1;
+    if (ftrl_size > 0)
+      floats_per_weight = ftrl_size;
+    else if (g != nullptr)
+      floats_per_weight += (all.weights.adaptive ? 1 : 0) + (all.weights.normalized ? 1 : 0);
+    save_load_weight_segments(all, model_file, read, floats_per_weight);
+  }
+  else if (all.weights.sparse)
     save_load_online_state(all, model_file, read, text, g, msg, ftrl_size, all.weights.sparse_weights);
   else
     save_load_online_state(all, model_file, read, text, g, msg, ftrl_size, all.weights.dense_weights);
@@ -1062,6 +1450,7 @@ void save_load(gd& g, io_buf& model_file, bool read, bool text)
             << "WARNING: --save_resume functionality is known to have inaccuracy in model files version less than "
             << VERSION_SAVE_RESUME_FIX << std::endl
             << std::endl;
+      if (!read) { merge_thread_states(g); }
       save_load_online_state(all, model_file, read, text, g.total_weight, &g);
     }
     else
@@ -1081,6 +1470,7 @@ uint64_t set_learn(vw& all, gd& g)
   {
     g.learn = learn<sparse_l2, invariant, sqrt_rate, feature_mask_off, true, adaptive, normalized, spare>;
     g.update = update<sparse_l2, invariant, sqrt_rate, feature_mask_off, true, adaptive, normalized, spare>;
+    g.multiupdate = multiupdate<sparse_l2, invariant, sqrt_rate, feature_mask_off, true, adaptive, normalized, spare>;
     g.sensitivity = sensitivity<sqrt_rate, feature_mask_off, true, adaptive, normalized, spare>;
     return next;
   }
@@ -1088,6 +1478,7 @@ uint64_t set_learn(vw& all, gd& g)
   {
     g.learn = learn<sparse_l2, invariant, sqrt_rate, feature_mask_off, false, adaptive, normalized, spare>;
     g.update = update<sparse_l2, invariant, sqrt_rate, feature_mask_off, false, adaptive, normalized, spare>;
+    g.multiupdate = multiupdate<sparse_l2, invariant, sqrt_rate, feature_mask_off, false, adaptive, normalized, spare>;
     g.sensitivity = sensitivity<sqrt_rate, feature_mask_off, false, adaptive, normalized, spare>;
     return next;
   }
@@ -1173,9 +1564,18 @@ base_learner* setup(options_i& options, vw& all)
       .add(make_option("l2_state", all.sd->contraction)
                .keep(all.save_resume)
                .default_value(1.)
-               .help("use per feature normalized updates"));
+               .help("use per feature normalized updates"))
+      .add(make_option("learn_thread_local_norm", g->thread_local_norm)
+               .help("with --learn_threads, accumulate the normalized update totals per thread instead of sharing "
+                     "them between threads"));
   options.add_and_parse(new_options);
 
+  if (all.learn_threads > 1) { g->thread_states.resize(all.learn_threads); }
+  else if (g->thread_local_norm)
+  {
+    THROW("--learn_thread_local_norm requires --learn_threads");
+  }
+
   g->all = &all;
   g->all->normalized_sum_norm_x = 0;
   g->no_win_counter = 0;
@@ -1280,6 +1680,7 @@ base_learner* setup(options_i& options, vw& all)
   ret.set_sensitivity(bare->sensitivity);
   ret.set_multipredict(bare->multipredict);
   ret.set_update(bare->update);
+  ret.set_multiupdate(bare->multiupdate);
   ret.set_save_load(save_load);
   ret.set_end_pass(end_pass);
   return make_base(ret);
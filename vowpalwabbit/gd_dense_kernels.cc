@@ -0,0 +1,270 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "gd_dense_kernels.h"
+
+#include <cfloat>
+#include <cmath>
+
+#include "cpu_features.h"
+
+#if defined(VW_HAVE_X86_DISPATCH)
+#  include <immintrin.h>
+#endif
+
+#if defined(VW_HAVE_X86_DISPATCH)
+namespace
+{
+VW_TARGET_AVX2 inline __m256 load_strided_avx2(const float* w, __m256i lanes, uint32_t stride)
+{
+  return stride == 1 ? _mm256_loadu_ps(w) : _mm256_i32gather_ps(w, lanes, 4);
+}
+
+// Adds the lanes to sum one at a time, in the order of the per feature loop. Together with products that are rounded
+// before they are added, this keeps the sums the same bit for bit as the loop's.
+VW_TARGET_AVX2 inline void add_in_order_avx2(__m256 v, float& sum)
+{
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, v);
+  for (float lane : lanes) { sum += lane; }
+}
+
+// The sum is a chain of dependent adds either way, the gain is in loading and multiplying eight features at once.
+VW_TARGET_AVX2 void dot_avx2(const float* x, const float* w, size_t count, uint32_t stride, float& sum)
+{
+  const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  { add_in_order_avx2(_mm256_mul_ps(load_strided_avx2(w + i * stride, lanes, stride), _mm256_loadu_ps(x + i)), sum); }
+  for (; i < count; ++i)
+  {
+    // A separate statement, so that the product isn't fused into the add.
+    const float product = w[i * stride] * x[i];
+    sum += product;
+  }
+}
+
+// Lanes where x is finite and, unless the feature mask is off, the weight is not 0. NaN weights count as not 0.
+VW_TARGET_AVX2 inline __m256 update_mask_avx2(__m256 x, __m256 w0, bool feature_mask_off)
+{
+  __m256 modify = _mm256_and_ps(
+      _mm256_cmp_ps(x, _mm256_set1_ps(FLT_MAX), _CMP_LT_OQ), _mm256_cmp_ps(x, _mm256_set1_ps(-FLT_MAX), _CMP_GT_OQ));
+  if (!feature_mask_off) { modify = _mm256_and_ps(modify, _mm256_cmp_ps(w0, _mm256_setzero_ps(), _CMP_NEQ_UQ)); }
+  return modify;
+}
+
+VW_TARGET_AVX2 void update_avx2(
+    float update, const float* x, float* w, size_t count, uint32_t stride, size_t spare, bool feature_mask_off)
+{
+  const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+  const __m256 update_v = _mm256_set1_ps(update);
+  alignas(32) float result[8];
+  alignas(32) float modified[8];
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    float* base = w + i * stride;
+    __m256 xv = _mm256_loadu_ps(x + i);
+    const __m256 w0 = load_strided_avx2(base, lanes, stride);
+    const __m256 modify = update_mask_avx2(xv, w0, feature_mask_off);
+    if (spare != 0) { xv = _mm256_mul_ps(xv, _mm256_i32gather_ps(base + spare, lanes, 4)); }
+    const __m256 updated = _mm256_blendv_ps(w0, _mm256_add_ps(w0, _mm256_mul_ps(update_v, xv)), modify);
+    if (stride == 1) { _mm256_storeu_ps(base, updated); }
+    else
+    {
+      // AVX2 has no scatter.
+      _mm256_store_ps(result, updated);
+      _mm256_store_ps(modified, modify);
+      for (size_t k = 0; k < 8; ++k)
+      {
+        if (modified[k] != 0.f) { base[k * stride] = result[k]; }
+      }
+    }
+  }
+  for (; i < count; ++i)
+  {
+    float* fw = w + i * stride;
+    float xi = x[i];
+    if (xi < FLT_MAX && xi > -FLT_MAX && (feature_mask_off || fw[0] != 0.))
+    {
+      if (spare != 0) { xi *= fw[spare]; }
+      const float step = update * xi;
+      fw[0] += step;
+    }
+  }
+}
+
+// Gathers into a zeroed vector. The plain gather leaves its source undefined, which GCC warns about.
+VW_TARGET_AVX512 inline __m512 gather_avx512(const float* w, __m512i lanes)
+{
+  return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), static_cast<__mmask16>(0xffff), lanes, w, 4);
+}
+
+VW_TARGET_AVX512 void update_avx512(
+    float update, const float* x, float* w, size_t count, uint32_t stride, size_t spare, bool feature_mask_off)
+{
+  const __m512i lanes = _mm512_mullo_epi32(
+      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(stride));
+  const __m512 update_v = _mm512_set1_ps(update);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    float* base = w + i * stride;
+    __m512 xv = _mm512_loadu_ps(x + i);
+    const __m512 w0 = stride == 1 ? _mm512_loadu_ps(base) : gather_avx512(base, lanes);
+    __mmask16 modify = _mm512_cmp_ps_mask(xv, _mm512_set1_ps(FLT_MAX), _CMP_LT_OQ) &
+        _mm512_cmp_ps_mask(xv, _mm512_set1_ps(-FLT_MAX), _CMP_GT_OQ);
+    if (!feature_mask_off) { modify &= _mm512_cmp_ps_mask(w0, _mm512_setzero_ps(), _CMP_NEQ_UQ); }
+    if (spare != 0) { xv = _mm512_mul_ps(xv, gather_avx512(base + spare, lanes)); }
+    const __m512 updated = _mm512_add_ps(w0, _mm512_mul_ps(update_v, xv));
+    if (stride == 1) { _mm512_mask_storeu_ps(base, modify, updated); }
+    else
+    {
+      _mm512_mask_i32scatter_ps(base, modify, lanes, updated, 4);
+    }
+  }
+  if (i < count) { update_avx2(update, x + i, w + i * stride, count - i, stride, spare, feature_mask_off); }
+}
+
+// Mirrors pred_per_update_feature<true, feature_mask_off, 1, 2, 3, false> in gd.cc lane by lane. _mm256_rsqrt_ps gives
+// the same estimate as the _mm_rsqrt_ss used by InvSqrt there. AVX-512 only has a more precise estimate, so this
+// kernel stays on AVX2 to keep the learned weights the same as the per feature loop.
+VW_TARGET_AVX2 void pred_per_update_sqrt_rate_avx2(float grad_squared, const float* x, float* w, size_t count,
+    uint32_t stride, bool feature_mask_off, float& pred_per_update, float& norm_x)
+{
+  const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 x_min_v = _mm256_set1_ps(GD::x_min);
+  const __m256 x2_min_v = _mm256_set1_ps(GD::x2_min);
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 grad_squared_v = _mm256_set1_ps(grad_squared);
+  alignas(32) float out[6][8];
+  alignas(32) float modified[8];
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    float* base = w + i * stride;
+    __m256 xv = _mm256_loadu_ps(x + i);
+    __m256 w0 = _mm256_i32gather_ps(base, lanes, 4);
+    __m256 w1 = _mm256_i32gather_ps(base + 1, lanes, 4);
+    __m256 w2 = _mm256_i32gather_ps(base + 2, lanes, 4);
+    const __m256 modify =
+        feature_mask_off ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : _mm256_cmp_ps(w0, zero, _CMP_NEQ_UQ);
+
+    __m256 x2 = _mm256_mul_ps(xv, xv);
+    const __m256 tiny = _mm256_cmp_ps(x2, x2_min_v, _CMP_LT_OQ);
+    const __m256 signed_min =
+        _mm256_blendv_ps(_mm256_sub_ps(zero, x_min_v), x_min_v, _mm256_cmp_ps(xv, zero, _CMP_GT_OQ));
+    xv = _mm256_blendv_ps(xv, signed_min, tiny);
+    x2 = _mm256_blendv_ps(x2, x2_min_v, tiny);
+
+    w1 = _mm256_add_ps(w1, _mm256_mul_ps(grad_squared_v, x2));
+    const __m256 x_abs = _mm256_and_ps(xv, abs_mask);
+    const __m256 new_scale = _mm256_cmp_ps(x_abs, w2, _CMP_GT_OQ);
+    const __m256 rescale = _mm256_and_ps(new_scale, _mm256_cmp_ps(w2, zero, _CMP_GT_OQ));
+    w0 = _mm256_blendv_ps(w0, _mm256_mul_ps(w0, _mm256_div_ps(w2, x_abs)), rescale);
+    w2 = _mm256_blendv_ps(w2, x_abs, new_scale);
+
+    const __m256 norm_x2 = _mm256_div_ps(x2, _mm256_mul_ps(w2, w2));
+    const __m256 w3 = _mm256_mul_ps(_mm256_rsqrt_ps(w1), _mm256_div_ps(one, w2));
+
+    _mm256_store_ps(out[0], w0);
+    _mm256_store_ps(out[1], w1);
+    _mm256_store_ps(out[2], w2);
+    _mm256_store_ps(out[3], w3);
+    _mm256_store_ps(out[4], norm_x2);
+    _mm256_store_ps(out[5], _mm256_mul_ps(x2, w3));
+    _mm256_store_ps(modified, modify);
+    for (size_t k = 0; k < 8; ++k)
+    {
+      if (modified[k] == 0.f) { continue; }
+      float* fw = base + k * stride;
+      fw[0] = out[0][k];
+      fw[1] = out[1][k];
+      fw[2] = out[2][k];
+      fw[3] = out[3][k];
+      // In the order of the per feature loop, see add_in_order_avx2.
+      norm_x += out[4][k];
+      pred_per_update += out[5][k];
+    }
+  }
+
+  for (; i < count; ++i)
+  {
+    float* fw = w + i * stride;
+    if (!feature_mask_off && fw[0] == 0.f) { continue; }
+    float xi = x[i];
+    float x2 = xi * xi;
+    if (x2 < GD::x2_min)
+    {
+      xi = (xi > 0) ? GD::x_min : -GD::x_min;
+      x2 = GD::x2_min;
+    }
+    const float grad_x2 = grad_squared * x2;
+    fw[1] += grad_x2;
+    const float x_abs = std::fabs(xi);
+    if (x_abs > fw[2])
+    {
+      if (fw[2] > 0.) { fw[0] *= fw[2] / x_abs; }
+      fw[2] = x_abs;
+    }
+    norm_x += x2 / (fw[2] * fw[2]);
+    fw[3] = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(fw[1]))) * (1.f / fw[2]);
+    const float pred = x2 * fw[3];
+    pred_per_update += pred;
+  }
+}
+}  // namespace
+#endif
+
+bool GD::dense_dot(const float* x, const float* w, size_t count, uint32_t stride, float& sum)
+{
+#if defined(VW_HAVE_X86_DISPATCH)
+  // AVX-512 would only widen the multiplies, the adds stay in order.
+  if (VW::get_cpu_features().avx2)
+  {
+    dot_avx2(x, w, count, stride, sum);
+    return true;
+  }
+#endif
+  return false;
+}
+
+bool GD::dense_update(
+    float update, const float* x, float* w, size_t count, uint32_t stride, size_t spare, bool feature_mask_off)
+{
+#if defined(VW_HAVE_X86_DISPATCH)
+  const auto& cpu = VW::get_cpu_features();
+  if (cpu.avx512f)
+  {
+    update_avx512(update, x, w, count, stride, spare, feature_mask_off);
+    return true;
+  }
+  if (cpu.avx2)
+  {
+    update_avx2(update, x, w, count, stride, spare, feature_mask_off);
+    return true;
+  }
+#endif
+  return false;
+}
+
+bool GD::dense_pred_per_update_sqrt_rate(float grad_squared, const float* x, float* w, size_t count,
+    uint32_t stride, bool feature_mask_off, float& pred_per_update, float& norm_x)
+{
+  // InvSqrt in gd.cc only uses the rsqrt instruction when SSE2 is enabled at compile time.
+#if defined(VW_HAVE_X86_DISPATCH) && defined(__SSE2__)
+  if (!VW::get_cpu_features().avx2 || stride < 4) { return false; }
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!(x[i] * x[i] <= GD::x2_max)) { return false; }
+  }
+  pred_per_update_sqrt_rate_avx2(grad_squared, x, w, count, stride, feature_mask_off, pred_per_update, norm_x);
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,35 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized gd kernels for a namespace whose features map to consecutive weights, e.g. an embedding namespace with
+// the features 0 to n - 1. Feature k of the run has the value x[k] and the weight w[k * stride]. The instruction set is
+// chosen at runtime, and every kernel gives the same result bit for bit as the per feature loop on any machine, so the
+// kernels can be on by default. Each kernel returns false without touching its arguments when there is no vectorized
+// implementation for this machine, in which case the caller falls back to the per feature loop.
+namespace GD
+{
+// Bounds of the squared feature values used by the normalized update.
+constexpr float x_min = 1.084202e-19f;
+constexpr float x2_min = x_min * x_min;
+constexpr float x2_max = FLT_MAX;
+
+/// sum += x[k] * w[k * stride], added in the order of the per feature loop, so the sum is the same bit for bit.
+bool dense_dot(const float* x, const float* w, size_t count, uint32_t stride, float& sum);
+
+/// update_feature for every feature of the run. spare is the offset of the per feature rate, 0 if there is none.
+bool dense_update(float update, const float* x, float* w, size_t count, uint32_t stride, size_t spare,
+    bool feature_mask_off);
+
+/// pred_per_update_feature with sqrt_rate, adaptive = 1, normalized = 2 and spare = 3, the default gd update. Adds
+/// to pred_per_update and norm_x. Also returns false if a feature is too large to be squared, which the per feature
+/// loop reports.
+bool dense_pred_per_update_sqrt_rate(float grad_squared, const float* x, float* w, size_t count, uint32_t stride,
+    bool feature_mask_off, float& pred_per_update, float& norm_x);
+}  // namespace GD
@@ -7,12 +7,82 @@
 #include "interactions_predict.h"
 #include "v_array.h"
 #include "example_predict.h"
+#include "array_parameters_dense.h"
+#include "gd_dense_kernels.h"
 
 #undef VW_DEBUG_LOG
 #define VW_DEBUG_LOG vw_dbg::gd_predict
 
 namespace GD
 {
+// A FuncT with a vectorized implementation for a namespace whose features map to consecutive weights specializes
+// these. run() gets the feature values, the weight of the first feature and the distance between weights, and returns
+// false if it can't handle the run, in which case FuncT is called per feature.
+template <class DataT, void (*FuncT)(DataT&, const float, float&)>
+struct dense_run_kernel
+{
+  static constexpr bool available = false;
+  static bool run(DataT&, const float*, float*, size_t, uint32_t) { return false; }
+};
+
+template <class DataT, void (*FuncT)(DataT&, float, float)>
+struct const_dense_run_kernel
+{
+  static constexpr bool available = false;
+  static bool run(DataT&, const float*, const float*, size_t, uint32_t) { return false; }
+};
+
+// Shorter namespaces aren't worth checking.
+constexpr size_t DENSE_RUN_MIN_LENGTH = 16;
+
+// True if the features of fs map to consecutive weights, without wrapping around the end of the table. first is set
+// to the index of the first weight.
+inline bool is_dense_run(const dense_parameters& weights, const features& fs, uint64_t offset, uint64_t& first)
+{
+  const size_t count = fs.size();
+  if (count < DENSE_RUN_MIN_LENGTH) { return false; }
+  const uint64_t stride = weights.stride();
+  const auto& indices = fs.indicies;
+  if (indices[count - 1] - indices[0] != (count - 1) * stride) { return false; }
+  for (size_t i = 1; i < count; ++i)
+  {
+    if (indices[i] - indices[i - 1] != stride) { return false; }
+  }
+  first = (indices[0] + offset) & weights.mask();
+  return first + (count - 1) * stride <= weights.mask();
+}
+
+// Only dense weights have runs. The overloads keep other weights, e.g. the lazy weights of cb_explore_adf_rnd, from
+// having to provide the dense_parameters interface.
+template <class DataT, void (*FuncT)(DataT&, const float, float&), class WeightsT>
+inline bool run_dense_kernel(WeightsT& /*weights*/, const features& /*fs*/, DataT& /*dat*/, uint64_t /*offset*/)
+{
+  return false;
+}
+
+template <class DataT, void (*FuncT)(DataT&, const float, float&)>
+inline bool run_dense_kernel(dense_parameters& weights, const features& fs, DataT& dat, uint64_t offset)
+{
+  uint64_t first;
+  return dense_run_kernel<DataT, FuncT>::available && is_dense_run(weights, fs, offset, first) &&
+      dense_run_kernel<DataT, FuncT>::run(dat, fs.values.begin(), &weights[first], fs.size(), weights.stride());
+}
+
+template <class DataT, void (*FuncT)(DataT&, float, float), class WeightsT>
+inline bool run_const_dense_kernel(
+    const WeightsT& /*weights*/, const features& /*fs*/, DataT& /*dat*/, uint64_t /*offset*/)
+{
+  return false;
+}
+
+template <class DataT, void (*FuncT)(DataT&, float, float)>
+inline bool run_const_dense_kernel(const dense_parameters& weights, const features& fs, DataT& dat, uint64_t offset)
+{
+  uint64_t first;
+  return const_dense_run_kernel<DataT, FuncT>::available && is_dense_run(weights, fs, offset, first) &&
+      const_dense_run_kernel<DataT, FuncT>::run(dat, fs.values.begin(), &weights[first], fs.size(), weights.stride());
+}
+
 // iterate through one namespace (or its part), callback function FuncT(some_data_R, feature_value_x, feature_index)
 template <class DataT, void (*FuncT)(DataT&, float feature_value, uint64_t feature_index), class WeightsT>
 void foreach_feature(WeightsT& /*weights*/, const features& fs, DataT& dat, uint64_t offset = 0, float mult = 1.)
@@ -24,6 +94,7 @@ void foreach_feature(WeightsT& /*weights*/, const features& fs, DataT& dat, uint
 template <class DataT, void (*FuncT)(DataT&, const float feature_value, float& weight_reference), class WeightsT>
 inline void foreach_feature(WeightsT& weights, const features& fs, DataT& dat, uint64_t offset = 0, float mult = 1.)
 {
+  if (mult == 1.f && run_dense_kernel<DataT, FuncT>(weights, fs, dat, offset)) { return; }
   for (const auto& f : fs)
   {
     weight& w = weights[(f.index() + offset)];
@@ -36,6 +107,7 @@ template <class DataT, void (*FuncT)(DataT&, float, float), class WeightsT>
 inline void foreach_feature(
     const WeightsT& weights, const features& fs, DataT& dat, uint64_t offset = 0, float mult = 1.)
 {
+  if (mult == 1.f && run_const_dense_kernel<DataT, FuncT>(weights, fs, dat, offset)) { return; }
   for (const auto& f : fs) { FuncT(dat, mult * f.value(), weights[(f.index() + offset)]); }
 }
 
@@ -57,12 +129,10 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
       interactions, permutations, ec, dat, weights, num_interacted_features);
 }
 
-// iterate through all namespaces and quadratic&cubic features, callback function FuncT(some_data_R, feature_value_x,
-// WeightOrIndexT) where WeightOrIndexT is EITHER float& feature_weight OR uint64_t feature_index
+// iterate through the linear features of ec
 template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), class WeightsT>
-inline void foreach_feature(WeightsT& weights, bool ignore_some_linear, std::array<bool, NUM_NAMESPACES>& ignore_linear,
-    const std::vector<std::vector<namespace_index>>& interactions, bool permutations, example_predict& ec, DataT& dat,
-    size_t& num_interacted_features)
+inline void foreach_linear_feature(WeightsT& weights, bool ignore_some_linear,
+    std::array<bool, NUM_NAMESPACES>& ignore_linear, example_predict& ec, DataT& dat)
 {
   uint64_t offset = ec.ft_offset;
   if (ignore_some_linear)
@@ -76,9 +146,45 @@ inline void foreach_feature(WeightsT& weights, bool ignore_some_linear, std::arr
     }
   else
     for (features& f : ec) foreach_feature<DataT, FuncT, WeightsT>(weights, f, dat, offset);
+}
 
-  generate_interactions<DataT, WeightOrIndexT, FuncT, WeightsT>(
-      interactions, permutations, ec, dat, weights, num_interacted_features);
+// iterate through the features that ec gets from its shared_context: the linear features of the shared example, unless
+// only the cross interactions are asked for, and the given part of the interactions
+template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), class WeightsT>
+inline void foreach_shared_context_feature(WeightsT& weights, bool ignore_some_linear,
+    std::array<bool, NUM_NAMESPACES>& ignore_linear, const std::vector<std::vector<namespace_index>>& interactions,
+    bool permutations, example_predict& ec, DataT& dat, size_t& num_interacted_features,
+    INTERACTIONS::interaction_part part)
+{
+  example_predict& shared = *ec.shared_context;
+  if (part != INTERACTIONS::interaction_part::cross)
+  {
+    for (example_predict::iterator i = shared.begin(); i != shared.end(); ++i)
+    {
+      if (i.index() == constant_namespace || (ignore_some_linear && ignore_linear[i.index()])) { continue; }
+      foreach_feature<DataT, FuncT, WeightsT>(weights, *i, dat, ec.ft_offset);
+    }
+  }
+  const INTERACTIONS::shared_context_features features_data = {&ec.feature_space, &shared.feature_space, part};
+  INTERACTIONS::generate_interactions<DataT, WeightOrIndexT, FuncT, false, dummy_func<DataT>, WeightsT>(
+      interactions, permutations, features_data, ec.ft_offset, dat, weights, num_interacted_features);
+}
+
+// iterate through all namespaces and quadratic&cubic features, callback function FuncT(some_data_R, feature_value_x,
+// WeightOrIndexT) where WeightOrIndexT is EITHER float& feature_weight OR uint64_t feature_index
+template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), class WeightsT>
+inline void foreach_feature(WeightsT& weights, bool ignore_some_linear, std::array<bool, NUM_NAMESPACES>& ignore_linear,
+    const std::vector<std::vector<namespace_index>>& interactions, bool permutations, example_predict& ec, DataT& dat,
+    size_t& num_interacted_features)
+{
+  foreach_linear_feature<DataT, WeightOrIndexT, FuncT, WeightsT>(weights, ignore_some_linear, ignore_linear, ec, dat);
+
+  if (ec.shared_context == nullptr)
+    generate_interactions<DataT, WeightOrIndexT, FuncT, WeightsT>(
+        interactions, permutations, ec, dat, weights, num_interacted_features);
+  else
+    foreach_shared_context_feature<DataT, WeightOrIndexT, FuncT, WeightsT>(weights, ignore_some_linear, ignore_linear,
+        interactions, permutations, ec, dat, num_interacted_features, INTERACTIONS::interaction_part::all);
 }
 
 template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), class WeightsT>
@@ -92,14 +198,88 @@ inline void foreach_feature(WeightsT& weights, bool ignore_some_linear, std::arr
 
 inline void vec_add(float& p, float fx, float fw) { p += fw * fx; }
 
+template <>
+struct const_dense_run_kernel<float, vec_add>
+{
+  static constexpr bool available = true;
+  static bool run(float& p, const float* x, const float* w, size_t count, uint32_t stride)
+  {
+    return dense_dot(x, w, count, stride, p);
+  }
+};
+
+// Predicts an example with a shared_context. The part of the prediction that only depends on the shared example is
+// computed once per ft_offset and set of interactions and kept in the shared example until gd changes the weights.
 template <class WeightsT>
-inline float inline_predict(WeightsT& weights, bool ignore_some_linear, std::array<bool, NUM_NAMESPACES>& ignore_linear,
-    const std::vector<std::vector<namespace_index>>& interactions, bool permutations, example_predict& ec,
-    float initial = 0.f)
+inline float shared_context_predict(WeightsT& weights, bool ignore_some_linear,
+    std::array<bool, NUM_NAMESPACES>& ignore_linear, const std::vector<std::vector<namespace_index>>& interactions,
+    bool permutations, example_predict& ec, size_t& num_interacted_features, float initial)
 {
-  foreach_feature<float, float, vec_add, WeightsT>(
-      weights, ignore_some_linear, ignore_linear, interactions, permutations, ec, initial);
-  return initial;
+  auto& scores = ec.shared_context->shared_context_scores;
+  auto cached = std::find_if(scores.begin(), scores.end(), [&ec, &interactions](const partial_score& score) {
+    return score.ft_offset == ec.ft_offset && score.interactions == &interactions;
+  });
+  if (cached == scores.end())
+  {
+    partial_score score = {ec.ft_offset, &interactions, 0.f, 0};
+    foreach_shared_context_feature<float, float, vec_add, WeightsT>(weights, ignore_some_linear, ignore_linear,
+        interactions, permutations, ec, score.score, score.num_interacted_features,
+        INTERACTIONS::interaction_part::shared);
+    scores.push_back(score);
+    cached = scores.end() - 1;
+  }
+
+  foreach_linear_feature<float, float, vec_add, WeightsT>(weights, ignore_some_linear, ignore_linear, ec, initial);
+  foreach_shared_context_feature<float, float, vec_add, WeightsT>(weights, ignore_some_linear, ignore_linear,
+      interactions, permutations, ec, initial, num_interacted_features, INTERACTIONS::interaction_part::cross);
+  num_interacted_features += cached->num_interacted_features;
+  return initial + cached->score;
+}
+
+// iterate through the linear features and interactions of ec that have one of its varying_namespaces, or only through
+// those that don't
+template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), class WeightsT>
+inline void foreach_varying_part_feature(WeightsT& weights, bool ignore_some_linear,
+    std::array<bool, NUM_NAMESPACES>& ignore_linear, const std::vector<std::vector<namespace_index>>& interactions,
+    bool permutations, example_predict& ec, DataT& dat, size_t& num_interacted_features, bool varying_part)
+{
+  const auto& varying = *ec.varying_namespaces;
+  for (example_predict::iterator i = ec.begin(); i != ec.end(); ++i)
+  {
+    if (varying[i.index()] != varying_part || (ignore_some_linear && ignore_linear[i.index()])) { continue; }
+    foreach_feature<DataT, FuncT, WeightsT>(weights, *i, dat, ec.ft_offset);
+  }
+  const INTERACTIONS::varying_namespace_features features_data = {&ec.feature_space, &varying, varying_part};
+  INTERACTIONS::generate_interactions<DataT, WeightOrIndexT, FuncT, false, dummy_func<DataT>, WeightsT>(
+      interactions, permutations, features_data, ec.ft_offset, dat, weights, num_interacted_features);
+}
+
+// Predicts an example with varying_namespaces. The part of the prediction that doesn't involve them is computed once
+// per ft_offset and set of interactions and kept in the example, so that only the varying part is computed again when
+// the example is predicted with other features in the varying namespaces. The kept part is always added last, so the
+// prediction is the same bit for bit whether it was kept or just computed.
+template <class WeightsT>
+inline float varying_namespaces_predict(WeightsT& weights, bool ignore_some_linear,
+    std::array<bool, NUM_NAMESPACES>& ignore_linear, const std::vector<std::vector<namespace_index>>& interactions,
+    bool permutations, example_predict& ec, size_t& num_interacted_features, float initial)
+{
+  auto& scores = ec.stable_scores;
+  auto cached = std::find_if(scores.begin(), scores.end(), [&ec, &interactions](const partial_score& score) {
+    return score.ft_offset == ec.ft_offset && score.interactions == &interactions;
+  });
+  if (cached == scores.end())
+  {
+    partial_score score = {ec.ft_offset, &interactions, 0.f, 0};
+    foreach_varying_part_feature<float, float, vec_add, WeightsT>(weights, ignore_some_linear, ignore_linear,
+        interactions, permutations, ec, score.score, score.num_interacted_features, false);
+    scores.push_back(score);
+    cached = scores.end() - 1;
+  }
+
+  foreach_varying_part_feature<float, float, vec_add, WeightsT>(weights, ignore_some_linear, ignore_linear,
+      interactions, permutations, ec, initial, num_interacted_features, true);
+  num_interacted_features += cached->num_interacted_features;
+  return initial + cached->score;
 }
 
 template <class WeightsT>
@@ -107,8 +287,28 @@ inline float inline_predict(WeightsT& weights, bool ignore_some_linear, std::arr
     const std::vector<std::vector<namespace_index>>& interactions, bool permutations, example_predict& ec,
     size_t& num_interacted_features, float initial = 0.f)
 {
+  if (ec.shared_context != nullptr)
+  {
+    return shared_context_predict<WeightsT>(weights, ignore_some_linear, ignore_linear, interactions, permutations, ec,
+        num_interacted_features, initial);
+  }
+  if (ec.varying_namespaces != nullptr)
+  {
+    return varying_namespaces_predict<WeightsT>(weights, ignore_some_linear, ignore_linear, interactions, permutations,
+        ec, num_interacted_features, initial);
+  }
   foreach_feature<float, float, vec_add, WeightsT>(
       weights, ignore_some_linear, ignore_linear, interactions, permutations, ec, initial, num_interacted_features);
   return initial;
 }
+
+template <class WeightsT>
+inline float inline_predict(WeightsT& weights, bool ignore_some_linear, std::array<bool, NUM_NAMESPACES>& ignore_linear,
+    const std::vector<std::vector<namespace_index>>& interactions, bool permutations, example_predict& ec,
+    float initial = 0.f)
+{
+  size_t num_interacted_features_ignored = 0;
+  return inline_predict<WeightsT>(weights, ignore_some_linear, ignore_linear, interactions, permutations, ec,
+      num_interacted_features_ignored, initial);
+}
 }  // namespace GD
@@ -250,14 +250,12 @@ void gen_cs_example(cb_to_cs_adf& c, multi_ex& ec_seq, COST_SENSITIVE::label& cs
 void cs_prep_labels(multi_ex& examples, std::vector<CB::label>& cb_labels, COST_SENSITIVE::label& cs_labels,
     std::vector<COST_SENSITIVE::label>& prepped_cs_labels, uint64_t offset);
 
-template <bool is_learn>
-void cs_ldf_learn_or_predict(VW::LEARNER::multi_learner& base, multi_ex& examples, std::vector<CB::label>& cb_labels,
-    COST_SENSITIVE::label& cs_labels, std::vector<COST_SENSITIVE::label>& prepped_cs_labels, bool predict_first,
-    uint64_t offset, size_t id = 0)
+// Calls base_call with the cs labels of the examples in place of their cb labels, then restores the cb labels and the
+// offsets.
+template <class BaseCallT>
+void cs_ldf_call(multi_ex& examples, std::vector<CB::label>& cb_labels, COST_SENSITIVE::label& cs_labels,
+    std::vector<COST_SENSITIVE::label>& prepped_cs_labels, uint64_t offset, const BaseCallT& base_call)
 {
-  VW_DBG(*examples[0]) << "cs_ldf_" << (is_learn ? "<learn>" : "<predict>") << ": ex=" << examples[0]->example_counter
-                       << ", offset=" << offset << ", id=" << id << std::endl;
-
   cs_prep_labels(examples, cb_labels, cs_labels, prepped_cs_labels, offset);
 
   // 1st: save cb_label (into mydata) and store cs_label for each example, which will be passed into base.learn.
@@ -278,13 +276,38 @@ void cs_ldf_learn_or_predict(VW::LEARNER::multi_learner& base, multi_ex& example
     }
   });
 
-  if (is_learn)
-  {
-    if (predict_first) { base.predict(examples, static_cast<int32_t>(id)); }
-    base.learn(examples, static_cast<int32_t>(id));
-  }
-  else
-    base.predict(examples, static_cast<int32_t>(id));
+  base_call();
+}
+
+template <bool is_learn>
+void cs_ldf_learn_or_predict(VW::LEARNER::multi_learner& base, multi_ex& examples, std::vector<CB::label>& cb_labels,
+    COST_SENSITIVE::label& cs_labels, std::vector<COST_SENSITIVE::label>& prepped_cs_labels, bool predict_first,
+    uint64_t offset, size_t id = 0)
+{
+  VW_DBG(*examples[0]) << "cs_ldf_" << (is_learn ? "<learn>" : "<predict>") << ": ex=" << examples[0]->example_counter
+                       << ", offset=" << offset << ", id=" << id << std::endl;
+
+  cs_ldf_call(examples, cb_labels, cs_labels, prepped_cs_labels, offset, [&base, &examples, predict_first, id] {
+    if (is_learn)
+    {
+      if (predict_first) { base.predict(examples, static_cast<int32_t>(id)); }
+      base.learn(examples, static_cast<int32_t>(id));
+    }
+    else
+      base.predict(examples, static_cast<int32_t>(id));
+  });
+}
+
+// Predicts count consecutive regressors like a cs_ldf_learn_or_predict<false> for each, see learner::multipredict.
+inline void cs_ldf_multipredict(VW::LEARNER::multi_learner& base, multi_ex& examples,
+    std::vector<CB::label>& cb_labels, COST_SENSITIVE::label& cs_labels,
+    std::vector<COST_SENSITIVE::label>& prepped_cs_labels, uint64_t offset, size_t count, polyprediction* pred)
+{
+  VW_DBG(*examples[0]) << "cs_ldf_<multipredict>: ex=" << examples[0]->example_counter << ", offset=" << offset
+                       << ", count=" << count << std::endl;
+
+  cs_ldf_call(examples, cb_labels, cs_labels, prepped_cs_labels, offset,
+      [&base, &examples, count, pred] { base.multipredict(examples, 0, count, pred, true); });
 }
 
 }  // namespace GEN_CS
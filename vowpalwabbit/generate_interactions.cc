@@ -61,6 +61,20 @@ inline void multipredict(INTERACTIONS::interactions_generator& data, VW::LEARNER
   ec.interactions = saved_interactions;
 }
 
+template <INTERACTIONS::generate_func_t generate_func, bool leave_duplicate_interactions>
+inline void multiupdate(INTERACTIONS::interactions_generator& data, VW::LEARNER::single_learner& base, example& ec,
+    size_t count, size_t, polyprediction* pred, const float* labels)
+{
+  // We pass *ec.interactions here BUT the contract is that this does not change...
+  data.update_interactions_if_new_namespace_seen<generate_func, leave_duplicate_interactions>(
+      *ec.interactions, ec.indices);
+
+  auto* saved_interactions = ec.interactions;
+  ec.interactions = &data.generated_interactions;
+  base.multiupdate(ec, 0, count, pred, labels);
+  ec.interactions = saved_interactions;
+}
+
 VW::LEARNER::base_learner* generate_interactions_setup(options_i& options, vw& all)
 {
   bool leave_duplicate_interactions;
@@ -87,10 +101,13 @@ VW::LEARNER::base_learner* generate_interactions_setup(options_i& options, vw& a
   using learn_pred_func_t = void (*)(INTERACTIONS::interactions_generator&, VW::LEARNER::single_learner&, example&);
   using multipredict_func_t = void (*)(INTERACTIONS::interactions_generator&, VW::LEARNER::single_learner&, example&,
       size_t, size_t, polyprediction*, bool);
+  using multiupdate_func_t = void (*)(INTERACTIONS::interactions_generator&, VW::LEARNER::single_learner&, example&,
+      size_t, size_t, polyprediction*, const float*);
   learn_pred_func_t learn_func;
   learn_pred_func_t pred_func;
   learn_pred_func_t update_func;
   multipredict_func_t multipredict_func;
+  multiupdate_func_t multiupdate_func;
 
   if (leave_duplicate_interactions)
   {
@@ -98,6 +115,7 @@ VW::LEARNER::base_learner* generate_interactions_setup(options_i& options, vw& a
     pred_func = transform_single_ex<false, INTERACTIONS::generate_namespace_permutations_with_repetition, true>;
     update_func = update<INTERACTIONS::generate_namespace_permutations_with_repetition, true>;
     multipredict_func = multipredict<INTERACTIONS::generate_namespace_permutations_with_repetition, true>;
+    multiupdate_func = multiupdate<INTERACTIONS::generate_namespace_permutations_with_repetition, true>;
   }
   else
   {
@@ -105,6 +123,7 @@ VW::LEARNER::base_learner* generate_interactions_setup(options_i& options, vw& a
     pred_func = transform_single_ex<false, INTERACTIONS::generate_namespace_combinations_with_repetition, false>;
     update_func = update<INTERACTIONS::generate_namespace_combinations_with_repetition, false>;
     multipredict_func = multipredict<INTERACTIONS::generate_namespace_combinations_with_repetition, false>;
+    multiupdate_func = multiupdate<INTERACTIONS::generate_namespace_combinations_with_repetition, false>;
   }
 
   auto data = VW::make_unique<INTERACTIONS::interactions_generator>();
@@ -114,6 +133,7 @@ VW::LEARNER::base_learner* generate_interactions_setup(options_i& options, vw& a
                 .set_learn_returns_prediction(base->learn_returns_prediction)
                 .set_update(update_func)
                 .set_multipredict(multipredict_func)
+                .set_multiupdate(multiupdate_func)
                 .build();
   return VW::LEARNER::make_base(*l);
 }
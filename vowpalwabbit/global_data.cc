@@ -282,6 +282,11 @@ vw::vw() : options(nullptr, nullptr)
   daemon = false;
   num_children = 10;
   save_resume = false;
+  mmap_model = false;
+  chunked_model = false;
+  compress_model_segments = false;
+  model_threads = 0;
+  delta_checkpoints = false;
   preserve_performance_counters = false;
 
   random_positive_weights = false;
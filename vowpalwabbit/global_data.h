@@ -51,6 +51,7 @@
 #include "options.h"
 #include "version.h"
 #include "kskip_ngram_transformer.h"
+#include "thread_pool.h"
 
 typedef float weight;
 
@@ -136,6 +137,9 @@ public:
   AllReduceType all_reduce_type;
   AllReduce* all_reduce;
 
+  size_t learn_threads = 1;                     // number of Hogwild workers used by the driver
+  std::unique_ptr<VW::thread_pool> learn_pool;  // set when learn_threads > 1
+
   bool chain_hash_json = false;
 
   VW::LEARNER::base_learner* l;         // the top level learner
@@ -179,6 +183,12 @@ public:
   bool hessian_on;
 
   bool save_resume;
+  bool mmap_model;  // write and read the dense weights of -f and -i as one page aligned block
+  bool chunked_model;            // write the weights of -f as checksummed segments, see model_segments.h
+  bool compress_model_segments;  // zlib compress the segments of a chunked model
+  size_t model_threads;          // threads that encode and decode the segments, 0 for one per core
+  bool delta_checkpoints;  // save passes after the first as deltas, see delta_checkpoint.h
+  std::vector<uint64_t> checkpoint_fingerprints;  // block fingerprints of the last checkpoint, empty if there is none
   bool preserve_performance_counters;
   std::string id;
 
@@ -199,6 +209,7 @@ public:
   std::unique_ptr<VW::io::writer> stdout_adapter;
 
   std::vector<std::string> initial_regressors;
+  std::vector<std::string> delta_files;  // applied in order after the initial regressor is loaded
 
   std::string feature_mask;
 
@@ -249,6 +260,8 @@ public:
 
   vw_logger logger;
   bool audit;     // should I print lots of debugging information?
+  // The namespace and feature names of audit mode, valid as long as this instance.
+  VW::string_table name_table;
   bool training;  // Should I train if lable data is available?
   bool active;
   bool invariant_updates;  // Should we use importance aware/safe updates
@@ -318,7 +331,7 @@ public:
   bool progress_add;   // additive (rather than multiplicative) progress dumps
   float progress_arg;  // next update progress dump multiplier
 
-  std::map<uint64_t, std::string> index_name_map;
+  std::unordered_map<uint64_t, std::string> index_name_map;
 
   // hack to support cb model loading into ccb reduction
   bool is_ccb_input_model = false;
@@ -3,6 +3,7 @@
 // license as described in the file LICENSE.
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include "constant.h"
 #include "feature_group.h"
@@ -11,7 +12,7 @@
 #include <vector>
 #include <string>
 
-const static std::pair<std::string, std::string> EMPTY_AUDIT_STRINGS = std::make_pair("", "");
+const static audit_strings EMPTY_AUDIT_STRINGS{};
 
 namespace INTERACTIONS
 {
@@ -43,6 +44,22 @@ inline void call_FuncT(DataT& dat, WeightsT& /*weights*/, const float ft_value,
   FuncT(dat, ft_value, ft_idx);
 }
 
+// Weight containers that can cheaply compute the address of a weight provide prefetch(index). Others, such as
+// sparse_parameters which would have to insert the weight, are left alone.
+template <class WeightsT>
+inline auto prefetch_weight(WeightsT& weights, const uint64_t ft_idx, int) -> decltype(weights.prefetch(ft_idx), void())
+{
+  weights.prefetch(ft_idx);
+}
+
+template <class WeightsT>
+inline void prefetch_weight(WeightsT& /*weights*/, const uint64_t /*ft_idx*/, long)
+{
+}
+
+// Number of interaction indices hashed and prefetched ahead of calling FuncT on them.
+constexpr size_t INTERACTION_PREFETCH_BLOCK = 16;
+
 // state data used in non-recursive feature generation algorithm
 // contains N feature_gen_data records (where N is length of interaction)
 struct feature_gen_data
@@ -53,7 +70,7 @@ struct feature_gen_data
   size_t loop_end;  // last feature id. May be less than number of features if namespace involved in interaction more
                     // than once calculated at preprocessing together with same_ns
   size_t self_interaction;  // namespace interacting with itself
-  features* ft_arr;
+  const features* ft_arr;
   //    feature_gen_data(): loop_idx(0), x(1.), loop_end(0), self_interaction(false) {}
 };
 
@@ -85,28 +102,88 @@ inline void inner_kernel(DataT& dat, features::const_audit_iterator& begin, feat
   }
   else
   {
-    for (; begin != end; ++begin)
-      call_FuncT<DataT, FuncT>(
-          dat, weights, INTERACTION_VALUE(ft_value, begin.value()), (begin.index() ^ halfhash) + offset);
+    // Interacted indices hash to random weights. Hashing a block of them and prefetching their weights first lets the
+    // cache misses overlap instead of stalling on each one. FuncT still sees the features in their original order.
+    uint64_t indices[INTERACTION_PREFETCH_BLOCK];
+    while (begin != end)
+    {
+      const size_t block_size = std::min(static_cast<size_t>(end - begin), INTERACTION_PREFETCH_BLOCK);
+      auto block_begin = begin;
+      for (size_t i = 0; i < block_size; ++i, ++begin)
+      {
+        indices[i] = (begin.index() ^ halfhash) + offset;
+        prefetch_weight(weights, indices[i], 0);
+      }
+      for (size_t i = 0; i < block_size; ++i, ++block_begin)
+      { call_FuncT<DataT, FuncT>(dat, weights, INTERACTION_VALUE(ft_value, block_begin.value()), indices[i]); }
+    }
   }
 }
 
+// Parts of the interactions of an example with a shared_context, see shared_context_features.
+enum class interaction_part
+{
+  all,
+  cross,   // the interactions that have a namespace of the example itself
+  shared,  // the interactions among the namespaces of the shared example alone
+};
+
+// Looks up the namespaces of an example with a shared_context as if the namespaces of the shared example, except its
+// constant namespace, were copied into the example. The two may not have a namespace in common.
+struct shared_context_features
+{
+  const VW::feature_arena* own;
+  const VW::feature_arena* shared;
+  interaction_part part;
+
+  const features& operator[](size_t ns) const
+  {
+    return ((*own)[ns].nonempty() || ns == constant_namespace) ? (*own)[ns] : (*shared)[ns];
+  }
+};
+
+// Looks up the namespaces of an example, but only generates the interactions that have one of the varying namespaces,
+// or only those that don't.
+struct varying_namespace_features
+{
+  const VW::feature_arena* own;
+  const std::array<bool, NUM_NAMESPACES>* varying;
+  bool varying_part;
+
+  const features& operator[](size_t ns) const { return (*own)[ns]; }
+};
+
+inline bool skip_interaction(const VW::feature_arena& /* features_data */, const std::vector<namespace_index>& /* ns */)
+{
+  return false;
+}
+
+inline bool skip_interaction(const varying_namespace_features& features_data, const std::vector<namespace_index>& ns)
+{
+  bool has_varying = false;
+  for (auto n : ns) { has_varying = has_varying || (*features_data.varying)[n]; }
+  return has_varying != features_data.varying_part;
+}
+
+inline bool skip_interaction(const shared_context_features& features_data, const std::vector<namespace_index>& ns)
+{
+  if (features_data.part == interaction_part::all) { return false; }
+  bool shared_only = true;
+  for (auto n : ns) { shared_only = shared_only && n != constant_namespace && (*features_data.shared)[n].nonempty(); }
+  return shared_only != (features_data.part == interaction_part::shared);
+}
+
 // this templated function generates new features for given example and set of interactions
 // and passes each of them to given function FuncT()
 // it must be in header file to avoid compilation problems
+// features_data maps a namespace to its features, either the feature_space of an example or a
+// shared_context_features.
 template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), bool audit,
-    void (*audit_func)(DataT&, const audit_strings*),
-    class WeightsT>  // nullptr func can't be used as template param in old compilers
+    void (*audit_func)(DataT&, const audit_strings*), class WeightsT, class FeaturesT>
 inline void generate_interactions(const std::vector<std::vector<namespace_index>>& interactions, bool permutations,
-    example_predict& ec, DataT& dat, WeightsT& weights,
-    size_t& num_features)  // default value removed to eliminate ambiguity in old complers
+    const FeaturesT& features_data, const uint64_t offset, DataT& dat, WeightsT& weights, size_t& num_features)
 {
   num_features = 0;
-  features* features_data = ec.feature_space.data();
-
-  // often used values
-  const uint64_t offset = ec.ft_offset;
-  //    const uint64_t stride_shift = all.stride_shift; // it seems we don't need stride shift in FTRL-like hash
 
   // statedata for generic non-recursive iteration
   v_array<feature_gen_data> state_data;
@@ -119,6 +196,7 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
 
   for (const auto& ns : interactions)
   {  // current list of namespaces to interact.
+    if (skip_interaction(features_data, ns)) { continue; }
 
 #ifndef GEN_INTER_LOOP
 
@@ -157,13 +235,13 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
     }
     else if (len == 3)  // special case for triples
     {
-      features& first = features_data[ns[0]];
+      const features& first = features_data[ns[0]];
       if (first.nonempty())
       {
-        features& second = features_data[ns[1]];
+        const features& second = features_data[ns[1]];
         if (second.nonempty())
         {
-          features& third = features_data[ns[2]];
+          const features& third = features_data[ns[2]];
           if (third.nonempty())
           {  // don't compare 1 and 3 as interaction is sorted
             const bool same_namespace1 = (!permutations && (ns[0] == ns[1]));
@@ -212,7 +290,7 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
       feature_gen_data* fgd2;  // for further use
       for (auto n : ns)
       {
-        features& ft = features_data[static_cast<int32_t>(n)];
+        const features& ft = features_data[static_cast<int32_t>(n)];
         const size_t ft_cnt = ft.indicies.size();
 
         if (ft_cnt == 0)
@@ -292,7 +370,7 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
         {
           feature_gen_data* next_data = cur_data + 1;
           size_t feature = cur_data->loop_idx;
-          features& fs = *(cur_data->ft_arr);
+          const features& fs = *(cur_data->ft_arr);
 
           if (next_data->self_interaction)
           {  // if next namespace is same, we should start with loop_idx + 1 to avoid feature interaction with itself
@@ -326,7 +404,7 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
           // start value is not a constant in this case
           if (!permutations) { start_i = fgd2->loop_idx; }
 
-          features& fs = *(fgd2->ft_arr);
+          const features& fs = *(fgd2->ft_arr);
 
           feature_value ft_value = fgd2->x;
           feature_index halfhash = fgd2->hash;
@@ -357,4 +435,15 @@ inline void generate_interactions(const std::vector<std::vector<namespace_index>
   }  // foreach interaction in all.interactions
 }
 
+template <class DataT, class WeightOrIndexT, void (*FuncT)(DataT&, float, WeightOrIndexT), bool audit,
+    void (*audit_func)(DataT&, const audit_strings*),
+    class WeightsT>  // nullptr func can't be used as template param in old compilers
+inline void generate_interactions(const std::vector<std::vector<namespace_index>>& interactions, bool permutations,
+    example_predict& ec, DataT& dat, WeightsT& weights,
+    size_t& num_features)  // default value removed to eliminate ambiguity in old complers
+{
+  generate_interactions<DataT, WeightOrIndexT, FuncT, audit, audit_func, WeightsT>(
+      interactions, permutations, ec.feature_space, ec.ft_offset, dat, weights, num_features);
+}
+
 }  // namespace INTERACTIONS
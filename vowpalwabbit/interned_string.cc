@@ -0,0 +1,72 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "interned_string.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+constexpr size_t NUM_SHARDS = 16;
+
+// Never destroyed, so the empty handle stays valid during static destruction.
+const std::shared_ptr<const std::string>& empty_string()
+{
+  static const auto* empty = new std::shared_ptr<const std::string>(std::make_shared<const std::string>());
+  return *empty;
+}
+}  // namespace
+
+namespace VW
+{
+struct string_table::impl
+{
+  struct shard
+  {
+    mutable std::mutex lock;
+    // The keys point into the strings, which don't move.
+    std::unordered_map<string_view, std::shared_ptr<const std::string>> index;
+  };
+
+  explicit impl(size_t max_size) : max_shard_size(std::max<size_t>(max_size / NUM_SHARDS, 1)) {}
+
+  const size_t max_shard_size;
+  shard shards[NUM_SHARDS];
+};
+
+interned_string::interned_string() : _str(empty_string()) {}
+
+string_table::string_table(size_t max_size) : _impl(new impl(max_size)) {}
+
+string_table::~string_table() = default;
+
+interned_string string_table::intern(string_view s)
+{
+  if (s.empty()) { return interned_string(); }
+
+  auto& shard = _impl->shards[std::hash<string_view>()(s) % NUM_SHARDS];
+  std::lock_guard<std::mutex> lock(shard.lock);
+  auto it = shard.index.find(s);
+  if (it != shard.index.end()) { return interned_string(it->second); }
+
+  if (shard.index.size() >= _impl->max_shard_size) { shard.index.clear(); }
+  auto interned = std::make_shared<const std::string>(s.begin(), s.end());
+  shard.index.emplace(string_view(*interned), interned);
+  return interned_string(std::move(interned));
+}
+
+size_t string_table::size() const
+{
+  size_t size = 0;
+  for (const auto& shard : _impl->shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    size += shard.index.size();
+  }
+  return size;
+}
+}  // namespace VW
@@ -0,0 +1,75 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "vw_string_view.h"
+
+namespace VW
+{
+class string_table;
+
+/// A handle to a string interned by a string_table, used for the namespace and feature names of audit mode. A handle is
+/// a shared pointer that is cheap to copy and compare, and keeps the string alive after the table dropped it.
+class interned_string
+{
+public:
+  /// The empty string, which belongs to no table.
+  interned_string();
+
+  const std::string& str() const { return *_str; }
+  operator const std::string&() const { return *_str; }
+  const char* c_str() const { return _str->c_str(); }
+  size_t size() const { return _str->size(); }
+  bool empty() const { return _str->empty(); }
+
+  // Equal strings interned by one table are usually the same entry, the strings are only compared when they are not.
+  friend bool operator==(const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs._str == rhs._str || *lhs._str == *rhs._str;
+  }
+  friend bool operator!=(const interned_string& lhs, const interned_string& rhs) { return !(lhs == rhs); }
+
+private:
+  friend class string_table;
+  explicit interned_string(std::shared_ptr<const std::string> str) : _str(std::move(str)) {}
+
+  std::shared_ptr<const std::string> _str;
+};
+
+inline bool operator==(const interned_string& lhs, const std::string& rhs) { return lhs.str() == rhs; }
+inline bool operator!=(const interned_string& lhs, const std::string& rhs) { return lhs.str() != rhs; }
+inline bool operator==(const interned_string& lhs, const char* rhs) { return lhs.str() == rhs; }
+inline bool operator!=(const interned_string& lhs, const char* rhs) { return lhs.str() != rhs; }
+inline std::ostream& operator<<(std::ostream& os, const interned_string& s) { return os << s.str(); }
+
+/// Shares one copy of equal strings between their handles. Interning is thread safe: the index is split into shards
+/// by hash, each with its own lock, so threads rarely wait for each other. The index is bounded, a shard that is full
+/// is emptied, which only means later handles of a string it held get a new copy.
+class string_table
+{
+public:
+  static constexpr size_t DEFAULT_MAX_SIZE = static_cast<size_t>(1) << 20;
+
+  explicit string_table(size_t max_size = DEFAULT_MAX_SIZE);
+  ~string_table();
+  string_table(const string_table&) = delete;
+  string_table& operator=(const string_table&) = delete;
+
+  interned_string intern(string_view s);
+
+  // Number of strings in the index.
+  size_t size() const;
+
+private:
+  struct impl;
+  std::unique_ptr<impl> _impl;
+};
+}  // namespace VW
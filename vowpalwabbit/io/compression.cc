@@ -0,0 +1,26 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "compression.h"
+
+#include <zlib.h>
+
+bool VW::io::compress_buffer(const char* data, size_t size, std::vector<char>& output, int level)
+{
+  uLongf compressed_size = compressBound(static_cast<uLong>(size));
+  output.resize(compressed_size);
+  if (compress2(reinterpret_cast<Bytef*>(output.data()), &compressed_size, reinterpret_cast<const Bytef*>(data),
+          static_cast<uLong>(size), level) != Z_OK)
+  { return false; }
+  output.resize(compressed_size);
+  return true;
+}
+
+bool VW::io::decompress_buffer(const char* data, size_t size, char* output, size_t output_size)
+{
+  uLongf decompressed_size = static_cast<uLongf>(output_size);
+  return uncompress(reinterpret_cast<Bytef*>(output), &decompressed_size, reinterpret_cast<const Bytef*>(data),
+             static_cast<uLong>(size)) == Z_OK &&
+      decompressed_size == output_size;
+}
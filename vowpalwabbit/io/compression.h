@@ -0,0 +1,22 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// In memory zlib compression, for data that is compressed piece by piece rather than as a gzip stream.
+namespace VW
+{
+namespace io
+{
+/// Replaces the contents of output with the compressed size bytes of data. Returns false if zlib fails.
+bool compress_buffer(const char* data, size_t size, std::vector<char>& output, int level);
+
+/// Decompresses size bytes of data into output, which must hold exactly output_size bytes of decompressed data.
+/// Returns false if the data is corrupted or decompresses to a different size.
+bool decompress_buffer(const char* data, size_t size, char* output, size_t output_size);
+}  // namespace io
+}  // namespace VW
@@ -52,6 +52,10 @@ struct reader
   /// \returns true if this reader can be reset, otherwise false
   bool is_resettable() const { return _is_resettable; }
 
+  /// \returns the descriptor of the uncompressed file this reader reads from, or -1 if there is none. Used to memory
+  /// map sections of a model file.
+  virtual int file_descriptor() const { return -1; }
+
   reader(reader& other) = delete;
   reader& operator=(reader& other) = delete;
   reader(reader&& other) = delete;
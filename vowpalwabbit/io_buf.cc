@@ -25,7 +25,10 @@ size_t io_buf::buf_read(char*& pointer, size_t n)
         fill(input_files[current].get()) > 0)  // read more bytes from current file if present
       return buf_read(pointer, n);             // more bytes are read.
     else if (++current < input_files.size())
+    {
+      _bytes_filled = 0;
       return buf_read(pointer, n);  // No more bytes, so go to next file and try again.
+    }
     else
     {
       // no more bytes to read, return all that we have left.
@@ -69,7 +72,10 @@ size_t io_buf::readto(char*& pointer, char terminal)
     if (current < input_files.size() && fill(input_files[current].get()) > 0)  // more bytes are read.
       return readto(pointer, terminal);
     else if (++current < input_files.size())  // no more bytes, so go to next file.
+    {
+      _bytes_filled = 0;
       return readto(pointer, terminal);
+    }
     else  // no more bytes to read, return everything we have.
     {
       size_t n = pointer - head;
@@ -125,6 +131,7 @@ void io_buf::flush()
     auto bytes_written = output_files[0]->write(_buffer._begin, unflushed_bytes_count());
     if (bytes_written != static_cast<ssize_t>(unflushed_bytes_count()))
     { VW::io::logger::errlog_error("error, failed to write example"); }
+    _bytes_flushed += unflushed_bytes_count();
     head = _buffer._begin;
     output_files[0]->flush();
   }
@@ -89,6 +89,9 @@ class io_buf
   internal_buffer _buffer;
   char* head = nullptr;
 
+  size_t _bytes_filled = 0;   // bytes read from the current input file
+  size_t _bytes_flushed = 0;  // bytes written to the output file
+
   std::vector<std::unique_ptr<VW::io::reader>> input_files;
   std::vector<std::unique_ptr<VW::io::writer>> output_files;
 
@@ -146,6 +149,7 @@ public:
   {
     f->reset();
     reset_buffer();
+    _bytes_filled = 0;
   }
 
   void set(char* p) { head = p; }
@@ -177,6 +181,7 @@ public:
     {
       // if some bytes were actually loaded, update the end of loaded values
       _buffer._end += num_read;
+      _bytes_filled += num_read;
       return num_read;
     }
 
@@ -188,6 +193,12 @@ public:
   //   - Read mode: The offset of the position that has been read up to so far.
   size_t unflushed_bytes_count() { return head - _buffer._begin; }
 
+  /// Offset in the current input file of the next byte to read.
+  size_t input_offset() const { return _bytes_filled - (_buffer._end - head); }
+
+  /// Number of bytes written so far, including the ones that are not flushed yet.
+  size_t output_offset() const { return _bytes_flushed + (head - _buffer._begin); }
+
   void flush();
 
   bool close_file()
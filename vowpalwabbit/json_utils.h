@@ -27,6 +27,7 @@ struct Namespace
   features* ftrs;
   size_t feature_count;
   const char* name;
+  VW::string_table* names;  // of the vw instance, for audit
 
   void AddFeature(feature_value v, feature_index i, const char* feature_name)
   {
@@ -36,7 +37,7 @@ struct Namespace
     ftrs->push_back(v, i);
     feature_count++;
 
-    if (audit) ftrs->space_names.push_back(audit_strings(name, feature_name));
+    if (audit) ftrs->space_names.push_back(audit_strings(names->intern(name), names->intern(feature_name)));
   }
 
   void AddFeature(vw* all, const char* str)
@@ -44,7 +45,7 @@ struct Namespace
     ftrs->push_back(1., VW::hash_feature_cstr(*all, str, namespace_hash));
     feature_count++;
 
-    if (audit) ftrs->space_names.push_back(audit_strings(name, str));
+    if (audit) ftrs->space_names.push_back(audit_strings(names->intern(name), names->intern(str)));
   }
 
   void AddFeature(vw* all, const char* key, const char* value)
@@ -54,7 +55,7 @@ struct Namespace
 
     std::stringstream ss;
     ss << key << "^" << value;
-    if (audit) ftrs->space_names.push_back(audit_strings(name, ss.str()));
+    if (audit) ftrs->space_names.push_back(audit_strings(names->intern(name), names->intern(ss.str())));
   }
 };
 
@@ -64,9 +65,10 @@ void push_ns(example* ex, const char* ns, std::vector<Namespace<audit>>& namespa
   Namespace<audit> n;
   n.feature_group = ns[0];
   n.namespace_hash = VW::hash_space_cstr(all, ns);
-  n.ftrs = ex->feature_space.data() + ns[0];
+  n.ftrs = &ex->feature_space[ns[0]];
   n.feature_count = 0;
   n.name = ns;
+  n.names = &all.name_table;
   namespaces.push_back(std::move(n));
 }
 
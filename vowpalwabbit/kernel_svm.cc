@@ -22,6 +22,8 @@
 #include "vw_allreduce.h"
 #include "rand48.h"
 #include "reductions.h"
+#include "sparse_dot.h"
+#include "thread_pool.h"
 
 #include "io/logger.h"
 
@@ -97,7 +99,7 @@ struct svm_params
 
   svm_model* model;
   size_t maxcache;
-  // size_t curcache;
+  size_t cache_budget;  // bytes of cached kernel rows kept by trim_cache
 
   svm_example** pool;
   float lambda;
@@ -113,6 +115,8 @@ struct svm_params
   vw* all;  // flatten, parallel
   std::shared_ptr<rand_state> _random_state;
 
+  std::unique_ptr<VW::thread_pool> kernel_pool;  // set when kernel_threads > 1
+
   ~svm_params()
   {
     free(pool);
@@ -152,6 +156,9 @@ svm_example::~svm_example()
 
 float kernel_function(const flat_example* fec1, const flat_example* fec2, void* params, size_t kernel_type);
 
+// Below this many new kernel values a row is cheaper to compute than to hand out to the threads.
+constexpr size_t min_parallel_kernels = 64;
+
 int svm_example::compute_kernels(svm_params& params)
 {
   int alloc = 0;
@@ -161,16 +168,24 @@ int svm_example::compute_kernels(svm_params& params)
   if (krow.size() < n)
   {
     // computing new kernel values and caching them
-    // if(params->curcache + n > params->maxcache)
-    // trim_cache(params);
-    num_kernel_evals += krow.size();
-    for (size_t i = krow.size(); i < n; i++)
+    const size_t first = krow.size();
+    num_kernel_evals += first;
+    krow.resize_but_with_stl_behavior(n);
+    const auto compute = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++)
+      { krow[i] = kernel_function(&ex, &(model->support_vec[i]->ex), params.kernel_params, params.kernel_type); }
+    };
+    // Each kernel value only reads the two examples, so a long row is split across the threads.
+    if (params.kernel_pool != nullptr && n - first >= min_parallel_kernels)
     {
-      svm_example* sec = model->support_vec[i];
-      float kv = kernel_function(&ex, &(sec->ex), params.kernel_params, params.kernel_type);
-      krow.push_back(kv);
-      alloc += 1;
+      params.kernel_pool->parallel_for_ranges(
+          n - first, [&](size_t begin, size_t end) { compute(first + begin, first + end); });
+    }
+    else
+    {
+      compute(first, n);
     }
+    alloc += static_cast<int>(n - first);
   }
   else
     num_cache_evals += n;
@@ -181,6 +196,7 @@ int svm_example::clear_kernels()
 {
   int rowsize = static_cast<int>(krow.size());
   krow.clear();
+  krow.shrink_to_fit();
   return -rowsize;
 }
 
@@ -227,17 +243,19 @@ static int make_hot_sv(svm_params& params, size_t svi)
   return alloc;
 }
 
+// Keeps the rows of the support vectors at the front, which make_hot_sv moved there, while their allocations fit in
+// the budget, and frees the rest.
 static int trim_cache(svm_params& params)
 {
-  int sz = static_cast<int>(params.maxcache);
+  size_t used = 0;
   svm_model* model = params.model;
   size_t n = model->num_support;
   int alloc = 0;
   for (size_t i = 0; i < n; i++)
   {
     svm_example* e = model->support_vec[i];
-    sz -= static_cast<int>(e->krow.size());
-    if (sz < 0) alloc += e->clear_kernels();
+    used += e->krow.capacity() * sizeof(float);
+    if (used > params.cache_budget) alloc += e->clear_kernels();
   }
   return alloc;
 }
@@ -367,9 +385,21 @@ float linear_kernel(const flat_example* fec1, const flat_example* fec2)
   features& fs_2 = const_cast<features&>(fec2->fs);
   if (fs_2.indicies.size() == 0) return 0.f;
 
+  // collision_cleanup leaves the first index of a flat example twice, which this merge pairs position by position.
+  // Past the first two features the indices are strictly increasing, so the rest can go to the vectorized kernel.
+  constexpr size_t unsorted_head = 2;
+  bool vectorize = true;
   int numint = 0;
   for (size_t idx1 = 0, idx2 = 0; idx1 < fs_1.size() && idx2 < fs_2.size(); idx1++)
   {
+    if (vectorize && idx1 >= unsorted_head && idx2 >= unsorted_head)
+    {
+      if (VW::sparse_dot(fs_1.indicies.begin() + idx1, fs_1.values.begin() + idx1, fs_1.size() - idx1,
+              fs_2.indicies.begin() + idx2, fs_2.values.begin() + idx2, fs_2.size() - idx2, dotprod))
+      { return dotprod; }
+      vectorize = false;
+    }
+
     uint64_t ec1pos = fs_1.indicies[idx1];
     uint64_t ec2pos = fs_2.indicies[idx2];
     // params.all->opts_n_args.trace_message<<ec1pos<<" "<<ec2pos<<" "<<idx1<<" "<<idx2<<" "<<f->x<<" "<<ec2f->x<< endl;
@@ -800,6 +830,8 @@ VW::LEARNER::base_learner* kernel_svm_setup(options_i& options, vw& all)
   std::string kernel_type;
   float bandwidth = 1.f;
   int degree = 2;
+  int kernel_threads = 1;
+  int kernel_cache_mb = 4096;
 
   bool ksvm = false;
 
@@ -817,7 +849,13 @@ VW::LEARNER::base_learner* kernel_svm_setup(options_i& options, vw& all)
                .default_value("linear")
                .help("type of kernel (rbf or linear (default))"))
       .add(make_option("bandwidth", bandwidth).keep().default_value(1.f).help("bandwidth of rbf kernel"))
-      .add(make_option("degree", degree).keep().default_value(2).help("degree of poly kernel"));
+      .add(make_option("degree", degree).keep().default_value(2).help("degree of poly kernel"))
+      .add(make_option("kernel_threads", kernel_threads)
+               .default_value(1)
+               .help("Number of threads computing the kernel values of a row across the support vectors"))
+      .add(make_option("kernel_cache_mb", kernel_cache_mb)
+               .default_value(4096)
+               .help("Memory in MB for cached kernel rows, the least recently used rows are freed beyond it"));
 
   if (!options.add_parse_and_check_necessary(new_options)) { return nullptr; }
 
@@ -828,7 +866,11 @@ VW::LEARNER::base_learner* kernel_svm_setup(options_i& options, vw& all)
   params->model = &calloc_or_throw<svm_model>();
   new (params->model) svm_model();
   params->model->num_support = 0;
+  if (kernel_threads < 1) THROW("kernel_threads must be at least 1");
+  if (kernel_cache_mb < 0) THROW("kernel_cache_mb can't be negative");
+  if (kernel_threads > 1) { params->kernel_pool = VW::make_unique<VW::thread_pool>(kernel_threads); }
   params->maxcache = 1024 * 1024 * 1024;
+  params->cache_budget = static_cast<size_t>(kernel_cache_mb) * 1024 * 1024;
   params->loss_sum = 0.;
   params->all = &all;
   params->_random_state = all.get_random_state();
@@ -10,8 +10,8 @@
 
 namespace logger = VW::io::logger;
 
-void add_grams(
-    size_t ngram, size_t skip_gram, features& fs, size_t initial_length, std::vector<size_t>& gram_mask, size_t skips)
+void add_grams(size_t ngram, size_t skip_gram, features& fs, size_t initial_length, std::vector<size_t>& gram_mask,
+    size_t skips, VW::string_table& names)
 {
   if (ngram == 0 && gram_mask.back() < initial_length)
   {
@@ -31,17 +31,17 @@ void add_grams(
           feature_name += std::string("^");
           feature_name += std::string(fs.space_names[i + gram_mask[n]].second);
         }
-        fs.space_names.push_back(audit_strings(fs.space_names[i].first, feature_name));
+        fs.space_names.push_back(audit_strings(fs.space_names[i].first, names.intern(feature_name)));
       }
     }
   }
   if (ngram > 0)
   {
     gram_mask.push_back(gram_mask.back() + 1 + skips);
-    add_grams(ngram - 1, skip_gram, fs, initial_length, gram_mask, 0);
+    add_grams(ngram - 1, skip_gram, fs, initial_length, gram_mask, 0, names);
     gram_mask.pop_back();
   }
-  if (skip_gram > 0 && ngram > 0) { add_grams(ngram, skip_gram - 1, fs, initial_length, gram_mask, skips + 1); }
+  if (skip_gram > 0 && ngram > 0) { add_grams(ngram, skip_gram - 1, fs, initial_length, gram_mask, skips + 1, names); }
 }
 
 void compile_gram(const std::vector<std::string>& grams, std::array<uint32_t, NUM_NAMESPACES>& dest,
@@ -68,7 +68,7 @@ void compile_gram(const std::vector<std::string>& grams, std::array<uint32_t, NU
   }
 }
 
-void VW::kskip_ngram_transformer::generate_grams(example* ex)
+void VW::kskip_ngram_transformer::generate_grams(example* ex, VW::string_table& names)
 {
   for (namespace_index index : ex->indices)
   {
@@ -77,7 +77,7 @@ void VW::kskip_ngram_transformer::generate_grams(example* ex)
     {
       gram_mask.clear();
       gram_mask.push_back(0);
-      add_grams(n, skip_definition[index], ex->feature_space[index], length, gram_mask, 0);
+      add_grams(n, skip_definition[index], ex->feature_space[index], length, gram_mask, 0, names);
     }
   }
 }
@@ -27,8 +27,9 @@ struct kskip_ngram_transformer
    * The k-skip-n-grams are appended to the feature vector.
    * Hash is evaluated using the principle h(a, b) = h(a)*X + h(b), where X is a random no.
    * 32 random nos. are maintained in an array and are used in the hashing.
+   * In audit mode the names of the grams are interned into names.
    */
-  void generate_grams(example* ex);
+  void generate_grams(example* ex, VW::string_table& names);
 
   std::vector<std::string> get_initial_ngram_definitions() const { return initial_ngram_definitions; }
   std::vector<std::string> get_initial_skip_definitions() const { return initial_skip_definitions; }
@@ -9,6 +9,7 @@
 #include <queue>
 #include <algorithm>
 #include <numeric>
+#include <atomic>
 #include <cmath>
 #include "correctedMath.h"
 #include "vw_versions.h"
@@ -27,6 +28,7 @@
 
 #include "io/logger.h"
 #include "shared_data.h"
+#include "thread_pool.h"
 
 #include <boost/version.hpp>
 #include <boost/math/special_functions/digamma.hpp>
@@ -55,6 +57,14 @@ public:
   bool operator<(const index_feature b) const { return f.weight_index < b.f.weight_index; }
 };
 
+// Per thread buffers of the document E-step.
+struct lda_scratch
+{
+  v_array<float> new_gamma;
+  v_array<float> old_gamma;
+  v_array<float> Elogtheta;
+};
+
 struct lda
 {
   size_t topics;
@@ -67,7 +77,6 @@ struct lda
 
   size_t finish_example_count;
 
-  v_array<float> Elogtheta;
   v_array<float> decay_levels;
   v_array<float> total_new;
   v_array<example *> examples;
@@ -88,6 +97,11 @@ struct lda
   double example_t;
   vw *all;  // regressor, lda
 
+  size_t lda_threads;
+  std::unique_ptr<VW::thread_pool> pool;  // set when lda_threads > 1
+  std::vector<lda_scratch> scratch;       // one per thread
+  std::vector<float> scores;              // E-step score of each document of the minibatch
+
   static constexpr float underflow_threshold = 1.0e-10f;
   inline float digamma(float x);
   inline float lgamma(float x);
@@ -650,26 +664,22 @@ float theta_kl(lda &l, v_array<float> &Elogtheta, float *gamma)
   return kl;
 }
 
-static inline float find_cw(lda &l, float *u_for_w, float *v)
+static inline float find_cw(lda &l, const float *u_for_w, float *v)
 {
   return 1.0f / std::inner_product(u_for_w, u_for_w + l.topics, v, 0.0f);
 }
 
-namespace
-{
-// Effectively, these are static and not visible outside the compilation unit.
-v_array<float> new_gamma;
-v_array<float> old_gamma;
-}  // namespace
-
 // Returns an estimate of the part of the variational bound that
 // doesn't have to do with beta for the entire corpus for the current
 // setting of lambda based on the document passed in. The value is
 // divided by the total number of words in the document This can be
 // used as a (possibly very noisy) estimate of held-out likelihood.
-float lda_loop(lda &l, v_array<float> &Elogtheta, float *v, example *ec, float)
+// Documents only read the weights, so several can run at once with their own scratch.
+float lda_loop(lda &l, lda_scratch &scratch, float *v, example *ec)
 {
   parameters &weights = l.all->weights;
+  v_array<float> &new_gamma = scratch.new_gamma;
+  v_array<float> &old_gamma = scratch.old_gamma;
   new_gamma.clear();
   old_gamma.clear();
 
@@ -699,7 +709,7 @@ float lda_loop(lda &l, v_array<float> &Elogtheta, float *v, example *ec, float)
     {
       for (features::iterator &f : fs)
       {
-        float *u_for_w = &(weights[f.index()]) + l.topics + 1;
+        const float *u_for_w = &(weights[f.index()]) + l.topics + 1;
         float c_w = find_cw(l, u_for_w, v);
         xc_w = c_w * f.value();
         score += -f.value() * log(c_w);
@@ -716,7 +726,7 @@ float lda_loop(lda &l, v_array<float> &Elogtheta, float *v, example *ec, float)
   ec->pred.scalars.resize_but_with_stl_behavior(l.topics);
   memcpy(ec->pred.scalars.begin(), new_gamma.begin(), l.topics * sizeof(float));
 
-  score += theta_kl(l, Elogtheta, new_gamma.begin());
+  score += theta_kl(l, scratch.Elogtheta, new_gamma.begin());
 
   return score / doc_length;
 }
@@ -903,9 +913,27 @@ void learn_batch(lda &l)
     l.expdigammify_2(*l.all, u_for_w, l.digammas.begin());
   }
 
+  // The documents are independent given the weights, so their E-steps can run concurrently. Their sufficient
+  // statistics are reduced into the weights by the M-step below.
+  l.scores.resize(batch_size);
+  if (l.pool != nullptr && batch_size > 1)
+  {
+    std::atomic<size_t> next_document{0};
+    l.pool->parallel_for(l.pool->size(), [&](size_t thread) {
+      size_t d;
+      while ((d = next_document++) < batch_size)
+      { l.scores[d] = lda_loop(l, l.scratch[thread], &(l.v[d * l.all->lda]), l.examples[d]); }
+    });
+  }
+  else
+  {
+    for (size_t d = 0; d < batch_size; d++)
+    { l.scores[d] = lda_loop(l, l.scratch[0], &(l.v[d * l.all->lda]), l.examples[d]); }
+  }
+
   for (size_t d = 0; d < batch_size; d++)
   {
-    float score = lda_loop(l, l.Elogtheta, &(l.v[d * l.all->lda]), l.examples[d], l.all->power_t);
+    float score = l.scores[d];
     if (l.all->audit) GD::print_audit_features(*l.all, *l.examples[d]);
     // If the doc is empty, give it loss of 0.
     if (l.doc_lengths[d] > 0)
@@ -1290,6 +1318,9 @@ VW::LEARNER::base_learner *lda_setup(options_i &options, vw &all)
       .add(make_option("lda_D", ld->lda_D).default_value(10000.0f).help("Number of documents"))
       .add(make_option("lda_epsilon", ld->lda_epsilon).default_value(0.001f).help("Loop convergence threshold"))
       .add(make_option("minibatch", ld->minibatch).default_value(1).help("Minibatch size, for LDA"))
+      .add(make_option("lda_threads", ld->lda_threads)
+               .default_value(1)
+               .help("Number of threads running the E-step over the documents of a minibatch"))
       .add(make_option("math-mode", math_mode).default_value(USE_SIMD).help("Math mode: simd, accuracy, fast-approx"))
       .add(make_option("metrics", ld->compute_coherence_metrics).help("Compute metrics"));
 
@@ -1298,6 +1329,14 @@ VW::LEARNER::base_learner *lda_setup(options_i &options, vw &all)
   // Convert from int to corresponding enum value.
   ld->mmode = static_cast<lda_math_mode>(math_mode);
 
+  if (ld->lda_threads == 0) THROW("lda_threads must be at least 1");
+  if (ld->lda_threads > 1)
+  {
+    if (ld->minibatch <= 1) { logger::errlog_warn("lda_threads has no effect without --minibatch"); }
+    ld->pool = VW::make_unique<VW::thread_pool>(ld->lda_threads);
+  }
+  ld->scratch.resize(ld->lda_threads);
+
   ld->finish_example_count = 0;
 
   all.lda = static_cast<uint32_t>(ld->topics);
@@ -8,6 +8,8 @@
 #include "parse_regressor.h"
 #include "parse_dispatch_loop.h"
 
+#include <atomic>
+
 #define CASE(type) \
   case type:       \
     return #type;
@@ -33,6 +35,14 @@ namespace VW
 {
 namespace LEARNER
 {
+namespace
+{
+thread_local size_t current_learn_thread = 0;
+
+// Examples per thread collected before a hogwild batch is learned.
+constexpr size_t HOGWILD_BATCH_PER_THREAD = 64;
+}  // namespace
+
 void learn_ex(example& ec, vw& all)
 {
   all.learn(ec);
@@ -254,6 +264,73 @@ void process_examples(queue_type& examples, handler_type& handler)
   while ((ec = examples.pop()) != nullptr) handler.on_example(ec);
 }
 
+size_t learn_thread_index() { return current_learn_thread; }
+
+void hogwild_learn(vw& all, const std::vector<example*>& examples)
+{
+  if (all.learn_pool == nullptr)
+  {
+    for (example* ec : examples) { all.learn(*ec); }
+    return;
+  }
+
+  // The scorer widens the label range in shared_data on every learn call. Doing it here first means the concurrent
+  // calls only store values that are already there.
+  if (all.training)
+  {
+    for (example* ec : examples)
+    {
+      if (!ec->test_only) { all.set_minmax(all.sd, ec->l.simple.label); }
+    }
+  }
+
+  std::atomic<size_t> next{0};
+  all.learn_pool->parallel_for(all.learn_pool->size(), [&](size_t thread) {
+    current_learn_thread = thread;
+    size_t i;
+    while ((i = next.fetch_add(1)) < examples.size()) { all.learn(*examples[i]); }
+    current_learn_thread = 0;
+  });
+}
+
+// Driver for --learn_threads. Examples are learned concurrently in batches and then finished in order on this thread,
+// so printing and shared_data accounting stay single threaded. End of pass and save commands act on the whole model,
+// so the examples before them are learned first.
+void hogwild_driver(vw& all)
+{
+  ready_examples_queue examples(all);
+  const size_t batch_size = HOGWILD_BATCH_PER_THREAD * all.learn_pool->size();
+  std::vector<example*> batch;
+  batch.reserve(batch_size);
+
+  auto learn_batch = [&]() {
+    hogwild_learn(all, batch);
+    for (example* ec : batch) { as_singleline(all.l)->finish_example(all, *ec); }
+    batch.clear();
+  };
+
+  example* ec;
+  while ((ec = examples.pop()) != nullptr)
+  {
+    if (ec->indices.size() <= 1 && (ec->end_pass || is_save_cmd(ec)))
+    {
+      learn_batch();
+      if (ec->end_pass) { end_pass(*ec, all); }
+      else
+      {
+        save(*ec, all);
+      }
+    }
+    else
+    {
+      batch.push_back(ec);
+      if (batch.size() == batch_size) { learn_batch(); }
+    }
+  }
+  learn_batch();
+  drain_examples(all);
+}
+
 template <typename context_type>
 void generic_driver(ready_examples_queue& examples, context_type& context)
 {
@@ -274,6 +351,12 @@ void generic_driver(ready_examples_queue& examples, context_type& context)
 
 void generic_driver(vw& all)
 {
+  if (all.learn_pool != nullptr)
+  {
+    hogwild_driver(all);
+    return;
+  }
+
   single_instance_context context(all);
   ready_examples_queue examples(all);
   generic_driver(examples, context);
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include "memory.h"
 #include "multiclass.h"
@@ -83,6 +84,8 @@ struct learn_data
   using fn = void (*)(void* data, base_learner& base, void* ex);
   using multi_fn = void (*)(void* data, base_learner& base, void* ex, size_t count, size_t step, polyprediction* pred,
       bool finalize_predictions);
+  using multi_update_fn = void (*)(void* data, base_learner& base, void* ex, size_t count, size_t step,
+      polyprediction* pred, const float* labels);
 
   void* data = nullptr;
   base_learner* base = nullptr;
@@ -90,6 +93,7 @@ struct learn_data
   fn predict_f = nullptr;
   fn update_f = nullptr;
   multi_fn multipredict_f = nullptr;
+  multi_update_fn multiupdate_f = nullptr;
 };
 
 struct sensitivity_data
@@ -128,6 +132,12 @@ void generic_driver(vw& all);
 void generic_driver(const std::vector<vw*>& alls);
 void generic_driver_onethread(vw& all);
 
+/// Learns every example on the --learn_threads pool, or serially when there is no pool. The examples share the weights
+/// without locking (Hogwild) and are not finished.
+void hogwild_learn(vw& all, const std::vector<example*>& examples);
+/// Index of the --learn_threads worker running on the calling thread, 0 outside of hogwild_learn.
+size_t learn_thread_index();
+
 inline void noop_save_load(void*, io_buf&, bool, bool) {}
 inline void noop_persist_metrics(void*, metric_sink&) {}
 inline void noop(void*) {}
@@ -194,6 +204,25 @@ inline void decrement_offset(multi_ex& ec_seq, const size_t increment, const siz
   debug_decrement_depth(ec_seq);
 }
 
+// Stores the prediction of one regressor when multipredict falls back to calling predict for each of them.
+inline void save_multipredict_prediction(example& ec, polyprediction& pred, bool finalize_predictions)
+{
+  if (finalize_predictions)
+    pred = std::move(ec.pred);  // TODO: this breaks for complex labels because = doesn't do deep copy! (XXX we
+                                // "fix" this by moving)
+  else
+    pred.scalar = ec.partial_prediction;
+  // pred.scalar = finalize_prediction ec.partial_prediction; // TODO: this breaks for complex labels because =
+  // doesn't do deep copy! // note works if ec.partial_prediction, but only if finalize_prediction is run????
+}
+
+// A multiline reduction predicts into its first example. The swap hands the buffers of pred back to the example for
+// the next regressor.
+inline void save_multipredict_prediction(multi_ex& ec_seq, polyprediction& pred, bool /* finalize_predictions */)
+{
+  std::swap(pred, ec_seq[0]->pred);
+}
+
 inline bool ec_is_example_header(example const& ec, label_type_t label_type)
 {
   if (label_type == label_type_t::cb) { return CB::ec_is_example_header(ec); }
@@ -331,13 +360,7 @@ public:
       for (size_t c = 0; c < count; c++)
       {
         learn_fd.predict_f(learn_fd.data, *learn_fd.base, (void*)&ec);
-        if (finalize_predictions)
-          pred[c] = std::move(ec.pred);  // TODO: this breaks for complex labels because = doesn't do deep copy! (XXX we
-                                         // "fix" this by moving)
-        else
-          pred[c].scalar = ec.partial_prediction;
-        // pred[c].scalar = finalize_prediction ec.partial_prediction; // TODO: this breaks for complex labels because =
-        // doesn't do deep copy! // note works if ec.partial_prediction, but only if finalize_prediction is run????
+        save_multipredict_prediction(ec, pred[c], finalize_predictions);
         increment_offset(ec, increment, 1);
       }
       decrement_offset(ec, increment, lo + count);
@@ -376,6 +399,43 @@ public:
     VW_WARNING_STATE_POP
   }
 
+  /// \brief Updates count consecutive regressors starting at offset lo, like calling update for each of them in
+  /// order. Regressor c is updated towards the simple label labels[c] from its prediction pred[c].scalar, as returned
+  /// by multipredict. A reduction that implements it can walk the features once for all of the regressors instead of
+  /// once each.
+  inline void multiupdate(E& ec, size_t lo, size_t count, polyprediction* pred, const float* labels)
+  {
+    assert((is_multiline && std::is_same<multi_ex, E>::value) ||
+        (!is_multiline && std::is_same<example, E>::value));  // sanity check under debug compile
+    increment_offset(ec, increment, lo);
+    debug_log_message(ec, "multiupdate");
+    if (learn_fd.multiupdate_f == nullptr)
+    {
+      for (size_t c = 0; c < count; c++)
+      {
+        ec.l.simple.label = labels[c];
+        ec.pred.scalar = pred[c].scalar;
+        learn_fd.update_f(learn_fd.data, *learn_fd.base, (void*)&ec);
+        increment_offset(ec, increment, 1);
+      }
+      decrement_offset(ec, increment, lo + count);
+    }
+    else
+    {
+      learn_fd.multiupdate_f(learn_fd.data, *learn_fd.base, (void*)&ec, count, increment, pred, labels);
+      decrement_offset(ec, increment, lo);
+    }
+  }
+
+  template <class L>
+  inline void set_multiupdate(void (*u)(T&, L&, E&, size_t, size_t, polyprediction*, const float*))
+  {
+    VW_WARNING_STATE_PUSH
+    VW_WARNING_DISABLE_CAST_FUNC_TYPE
+    learn_fd.multiupdate_f = (learn_data::multi_update_fn)u;
+    VW_WARNING_STATE_POP
+  }
+
   inline void update(E& ec, size_t i = 0)
   {
     assert((is_multiline && std::is_same<multi_ex, E>::value) ||
@@ -597,6 +657,7 @@ public:
     ret.learn_fd.predict_f = (learn_data::fn)predict;
     VW_WARNING_STATE_POP
     ret.learn_fd.multipredict_f = nullptr;
+    ret.learn_fd.multiupdate_f = nullptr;
     ret.pred_type = pred_type;
     ret.is_multiline = std::is_same<multi_ex, E>::value;
     ret.learn_returns_prediction = learn_returns_prediction;
@@ -815,6 +876,13 @@ struct common_learner_builder
     return *static_cast<FluentBuilderT*>(this);
   }
 
+  FluentBuilderT& set_multiupdate(
+      void (*fn_ptr)(DataT&, BaseLearnerT&, ExampleT&, size_t, size_t, polyprediction*, const float*))
+  {
+    this->_learner->learn_fd.multiupdate_f = (learn_data::multi_update_fn)fn_ptr;
+    return *static_cast<FluentBuilderT*>(this);
+  }
+
   FluentBuilderT& set_update(void (*u)(DataT& data, BaseLearnerT& base, ExampleT&))
   {
     this->_learner->learn_fd.update_f = (learn_data::fn)u;
@@ -910,6 +978,9 @@ struct reduction_learner_builder
     this->_learner->finisher_fd.data = this->_learner->learner_data.get();
     this->_learner->finisher_fd.base = make_base(*base);
     this->_learner->finisher_fd.func = static_cast<func_data::fn>(noop);
+    // The copied functions expect the data of the base.
+    this->_learner->learn_fd.multipredict_f = nullptr;
+    this->_learner->learn_fd.multiupdate_f = nullptr;
 
     set_params_per_weight(1);
     this->set_learn_returns_prediction(false);
@@ -961,6 +1032,9 @@ struct reduction_no_data_learner_builder
     this->_learner->finisher_fd.data = this->_learner->learner_data.get();
     this->_learner->finisher_fd.base = make_base(*base);
     this->_learner->finisher_fd.func = static_cast<func_data::fn>(noop);
+    // The copied functions expect the data of the base.
+    this->_learner->learn_fd.multipredict_f = nullptr;
+    this->_learner->learn_fd.multiupdate_f = nullptr;
 
     set_params_per_weight(1);
 
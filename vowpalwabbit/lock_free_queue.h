@@ -0,0 +1,208 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Mutex and CV cannot be used in managed C++, tell the compiler that this is unmanaged even if included in a managed
+// project.
+#ifdef _M_CEE
+#  pragma managed(push, off)
+#  undef _M_CEE
+#  include <mutex>
+#  include <condition_variable>
+#  include <thread>
+#  define _M_CEE 001
+#  pragma managed(pop)
+#else
+#  include <mutex>
+#  include <condition_variable>
+#  include <thread>
+#endif
+
+namespace VW
+{
+/// Bounded ring of pointers that is safe for any number of producers and consumers without taking a lock on the fast
+/// path. Each slot carries a sequence number (D. Vyukov's bounded queue) so producers and consumers only contend on
+/// their own cursor.
+///
+/// push and pop have the same blocking semantics as ptr_queue. A thread that cannot make progress spins for a short
+/// while and then parks on a condition variable. The mutex is only touched when some thread is parked.
+///
+/// The capacity is max_size rounded up to the next power of two.
+template <typename T>
+class lock_free_ptr_queue
+{
+public:
+  lock_free_ptr_queue(size_t max_size) : _capacity(round_up_to_pow2(max_size)), _cells(new cell[_capacity])
+  {
+    for (size_t i = 0; i < _capacity; ++i) { _cells[i].sequence.store(i, std::memory_order_relaxed); }
+  }
+
+  lock_free_ptr_queue(const lock_free_ptr_queue&) = delete;
+  lock_free_ptr_queue& operator=(const lock_free_ptr_queue&) = delete;
+
+  /// Non-blocking push. Returns false if the ring is full.
+  bool try_push(T* item)
+  {
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+      cell& c = _cells[pos & (_capacity - 1)];
+      const size_t seq = c.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0)
+      {
+        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          c.data = item;
+          c.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Non-blocking pop. Returns false if the ring is empty.
+  bool try_pop(T*& item)
+  {
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+      cell& c = _cells[pos & (_capacity - 1)];
+      const size_t seq = c.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0)
+      {
+        if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          item = c.data;
+          c.sequence.store(pos + _capacity, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = _dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Blocks until there is an item or the queue is done. Returns nullptr only once the queue is done and drained.
+  T* pop()
+  {
+    T* item = nullptr;
+    wait_until([&] { return try_pop(item) || _done.load(); });
+    if (item == nullptr) { try_pop(item); }
+    if (item != nullptr) { wake_parked(); }
+    return item;
+  }
+
+  /// Blocks while the ring is full.
+  void push(T* item)
+  {
+    wait_until([&] { return try_push(item); });
+    wake_parked();
+  }
+
+  void set_done()
+  {
+    _done.store(true);
+    std::unique_lock<std::mutex> lock(_park_mut);
+    _park_cv.notify_all();
+  }
+
+  /// Number of items in the ring. Only exact when no other thread is pushing or popping.
+  size_t size() const
+  {
+    const size_t enqueued = _enqueue_pos.load(std::memory_order_acquire);
+    const size_t dequeued = _dequeue_pos.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  size_t capacity() const { return _capacity; }
+
+private:
+  static constexpr size_t SPIN_ITERATIONS = 64;
+  static constexpr size_t YIELD_ITERATIONS = 16;
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  struct cell
+  {
+    std::atomic<size_t> sequence;
+    T* data;
+  };
+
+  static size_t round_up_to_pow2(size_t value)
+  {
+    size_t result = 1;
+    while (result < value) { result <<= 1; }
+    return result;
+  }
+
+  template <typename PredicateT>
+  void wait_until(PredicateT&& predicate)
+  {
+    for (size_t i = 0; i < SPIN_ITERATIONS; ++i)
+    {
+      if (predicate()) { return; }
+    }
+    for (size_t i = 0; i < YIELD_ITERATIONS; ++i)
+    {
+      if (predicate()) { return; }
+      std::this_thread::yield();
+    }
+
+    // Announce the park before the final check so that a concurrent push or pop either sees the parked count or
+    // has already made its change visible to the predicate.
+    _parked.fetch_add(1);
+    {
+      std::unique_lock<std::mutex> lock(_park_mut);
+      _park_cv.wait(lock, predicate);
+    }
+    _parked.fetch_sub(1);
+  }
+
+  void wake_parked()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_parked.load() > 0)
+    {
+      std::unique_lock<std::mutex> lock(_park_mut);
+      _park_cv.notify_all();
+    }
+  }
+
+  const size_t _capacity;
+  std::unique_ptr<cell[]> _cells;
+
+  // Cursors are padded onto their own cache lines so producers and consumers do not false share. Padding is used
+  // instead of alignas because the parser is heap allocated and over-aligned new is not available before C++17.
+  char _pad0[CACHE_LINE_SIZE];
+  std::atomic<size_t> _enqueue_pos{0};
+  char _pad1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> _dequeue_pos{0};
+  char _pad2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> _parked{0};
+  std::atomic<bool> _done{false};
+
+  std::mutex _park_mut;
+  std::condition_variable _park_cv;
+};
+}  // namespace VW
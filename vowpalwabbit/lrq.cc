@@ -127,7 +127,8 @@ void predict_or_learn(LRQstate& lrq, single_learner& base, example& ec)
                 char* new_space = strdup("lrq");
                 char* new_feature = strdup(new_feature_buffer.str().c_str());
 #endif
-                right_fs.space_names.push_back(audit_strings(new_space, new_feature));
+                right_fs.space_names.push_back(
+                    audit_strings(all.name_table.intern(new_space), all.name_table.intern(new_feature)));
               }
             }
           }
@@ -96,7 +96,8 @@ void predict_or_learn(LRQFAstate& lrq, single_learner& base, example& ec)
                 char* new_space = strdup("lrqfa");
                 char* new_feature = strdup(new_feature_buffer.str().c_str());
 #endif
-                rfs.space_names.push_back(audit_strings(new_space, new_feature));
+                rfs.space_names.push_back(
+                    audit_strings(all.name_table.intern(new_space), all.name_table.intern(new_feature)));
               }
             }
           }
@@ -101,6 +101,7 @@ int main(int argc, char* argv[])
 
     if (should_use_onethread)
     {
+      if (all.learn_threads > 1) THROW("--onethread doesn't make sense with --learn_threads");
       if (alls.size() == 1)
         VW::LEARNER::generic_driver_onethread(all);
       else
@@ -108,6 +109,7 @@ int main(int argc, char* argv[])
     }
     else
     {
+      if (alls.size() > 1 && all.learn_threads > 1) THROW("--learn_threads can't be used with multiple learners");
       VW::start_parser(all);
       if (alls.size() == 1)
         VW::LEARNER::generic_driver(all);
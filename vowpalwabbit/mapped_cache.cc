@@ -0,0 +1,334 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "mapped_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "cache.h"
+#include "global_data.h"
+#include "parser.h"
+#include "vw_exception.h"
+
+namespace
+{
+constexpr uint64_t MAPPED_CACHE_MAGIC = 0x3148434143575631;  // "1VWCACH1" read as little endian
+constexpr size_t RECORD_ALIGNMENT = 8;
+
+struct record_header
+{
+  uint64_t record_size;
+  uint32_t label_size;
+  uint32_t tag_size;
+  uint16_t num_namespaces;
+  uint8_t is_newline;
+  uint8_t sorted;
+  uint8_t reserved[4];
+};
+static_assert(sizeof(record_header) % RECORD_ALIGNMENT == 0, "record_header must keep records aligned");
+
+struct namespace_header
+{
+  uint8_t index;
+  uint8_t reserved[3];
+  float sum_feat_sq;
+  uint64_t count;
+};
+static_assert(sizeof(namespace_header) % RECORD_ALIGNMENT == 0, "namespace_header must keep columns aligned");
+
+struct footer
+{
+  uint64_t num_examples;
+  uint64_t index_offset;
+  uint64_t magic;
+};
+
+inline size_t padding_for(size_t size) { return (RECORD_ALIGNMENT - size % RECORD_ALIGNMENT) % RECORD_ALIGNMENT; }
+
+template <typename T>
+inline void append_value(std::vector<char>& buffer, const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+inline void append_padding(std::vector<char>& buffer) { buffer.resize(buffer.size() + padding_for(buffer.size())); }
+}  // namespace
+
+namespace VW
+{
+namespace details
+{
+// Reader over a span that can be re-pointed without allocating, so one io_buf can be reused for every cached label.
+class span_reader : public VW::io::reader
+{
+public:
+  span_reader() : reader(true) {}
+
+  void set_span(const char* data, size_t len)
+  {
+    _data = data;
+    _read_head = data;
+    _len = len;
+  }
+
+  ssize_t read(char* buffer, size_t num_bytes) override
+  {
+    num_bytes = std::min(static_cast<size_t>((_data + _len) - _read_head), num_bytes);
+    if (num_bytes == 0) { return 0; }
+    std::memcpy(buffer, _read_head, num_bytes);
+    _read_head += num_bytes;
+    return static_cast<ssize_t>(num_bytes);
+  }
+
+  void reset() override { _read_head = _data; }
+
+private:
+  const char* _data = nullptr;
+  const char* _read_head = nullptr;
+  size_t _len = 0;
+};
+}  // namespace details
+
+mapped_cache_writer::mapped_cache_writer(uint64_t header_size)
+    : _bytes_written(header_size), _label_bytes(std::make_shared<std::vector<char>>())
+{
+  _label_buf.add_file(VW::io::create_vector_writer(_label_bytes));
+}
+
+mapped_cache_writer::~mapped_cache_writer() = default;
+
+void mapped_cache_writer::write_padding(io_buf& output)
+{
+  const char zeros[RECORD_ALIGNMENT] = {};
+  const size_t padding = padding_for(static_cast<size_t>(_bytes_written));
+  output.bin_write_fixed(zeros, padding);
+  _bytes_written += padding;
+}
+
+void mapped_cache_writer::write_example(io_buf& output, example& ae, label_parser& lbl_parser, uint64_t parse_mask)
+{
+  write_padding(output);
+  _offsets.push_back(_bytes_written);
+
+  _label_bytes->clear();
+  lbl_parser.cache_label(&ae.l, ae._reduction_features, _label_buf);
+  _label_buf.flush();
+
+  record_header header;
+  std::memset(&header, 0, sizeof(header));
+  header.label_size = VW::convert(_label_bytes->size());
+  header.tag_size = VW::convert(ae.tag.size());
+  header.num_namespaces = static_cast<uint16_t>(ae.indices.size());
+  header.is_newline = ae.is_newline ? 1 : 0;
+  header.sorted = 1;
+
+  _record.resize(sizeof(record_header));
+  _record.insert(_record.end(), _label_bytes->begin(), _label_bytes->end());
+  _record.insert(_record.end(), ae.tag.begin(), ae.tag.end());
+  append_padding(_record);
+
+  for (namespace_index ns : ae.indices)
+  {
+    const features& fs = ae.feature_space[ns];
+    namespace_header ns_header;
+    std::memset(&ns_header, 0, sizeof(ns_header));
+    ns_header.index = ns;
+    ns_header.count = fs.size();
+    // Accumulated in feature order so it matches what features::push_back computes when reading the varint cache.
+    for (feature_value v : fs.values) { ns_header.sum_feat_sq += v * v; }
+    append_value(_record, ns_header);
+
+    uint64_t last = 0;
+    for (feature_index index : fs.indicies)
+    {
+      const uint64_t masked = index & parse_mask;
+      if (masked < last) { header.sorted = 0; }
+      last = masked;
+      append_value(_record, masked);
+    }
+    const char* values = reinterpret_cast<const char*>(fs.values.begin());
+    _record.insert(_record.end(), values, values + fs.size() * sizeof(feature_value));
+    append_padding(_record);
+  }
+
+  header.record_size = _record.size();
+  std::memcpy(_record.data(), &header, sizeof(header));
+  output.bin_write_fixed(_record.data(), _record.size());
+  _bytes_written += _record.size();
+}
+
+void mapped_cache_writer::finish(io_buf& output)
+{
+  write_padding(output);
+  footer foot;
+  foot.num_examples = _offsets.size();
+  foot.index_offset = _bytes_written;
+  foot.magic = MAPPED_CACHE_MAGIC;
+
+  output.bin_write_fixed(reinterpret_cast<const char*>(_offsets.data()), _offsets.size() * sizeof(uint64_t));
+  output.bin_write_fixed(reinterpret_cast<const char*>(&foot), sizeof(foot));
+  _bytes_written += _offsets.size() * sizeof(uint64_t) + sizeof(foot);
+  _offsets.clear();
+}
+
+mapped_cache_reader::mapped_cache_reader(const std::string& file_name)
+{
+#ifndef _WIN32
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) { THROW("can't open mapped cache file " << file_name << ": " << VW::strerror_to_string(errno)); }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0)
+  {
+    close(fd);
+    THROW("can't stat mapped cache file " << file_name << ": " << VW::strerror_to_string(errno));
+  }
+  _size = static_cast<size_t>(file_stat.st_size);
+  if (_size > 0)
+  {
+    void* mapped = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+      close(fd);
+      THROW("can't map cache file " << file_name << ": " << VW::strerror_to_string(errno));
+    }
+    _data = static_cast<const char*>(mapped);
+  }
+  close(fd);
+#else
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file) { THROW("can't open mapped cache file " << file_name); }
+  _file_contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  _data = _file_contents.data();
+  _size = _file_contents.size();
+#endif
+
+  size_t v_length = 0;
+  if (_size < sizeof(v_length) + sizeof(footer)) { THROW("mapped cache file " << file_name << " is truncated"); }
+  std::memcpy(&v_length, _data, sizeof(v_length));
+  const size_t header_size = sizeof(v_length) + v_length + 1 + sizeof(_num_bits);
+  if (header_size + sizeof(footer) > _size || _data[sizeof(v_length) + v_length] != MAPPED_CACHE_TYPE)
+  { THROW("file " << file_name << " is not a mapped cache"); }
+  std::memcpy(&_num_bits, _data + sizeof(v_length) + v_length + 1, sizeof(_num_bits));
+
+  footer foot;
+  std::memcpy(&foot, _data + _size - sizeof(footer), sizeof(footer));
+  if (foot.magic != MAPPED_CACHE_MAGIC)
+  { THROW("mapped cache file " << file_name << " has no index, it was probably not completely written"); }
+  if (foot.num_examples > (_size - sizeof(footer)) / sizeof(uint64_t) || foot.index_offset % RECORD_ALIGNMENT != 0 ||
+      foot.index_offset < header_size ||
+      foot.index_offset + foot.num_examples * sizeof(uint64_t) + sizeof(footer) != _size)
+  { THROW("mapped cache file " << file_name << " has a corrupt index"); }
+
+  _records_begin = header_size;
+  _records_end = foot.index_offset;
+  _num_examples = foot.num_examples;
+  _offsets = reinterpret_cast<const uint64_t*>(_data + foot.index_offset);
+
+  auto span = VW::make_unique<details::span_reader>();
+  _label_span = span.get();
+  _label_buf.add_file(std::move(span));
+}
+
+mapped_cache_reader::~mapped_cache_reader()
+{
+#ifndef _WIN32
+  if (_data != nullptr) { munmap(const_cast<char*>(_data), _size); }
+#endif
+}
+
+void mapped_cache_reader::seek(size_t example_index)
+{
+  if (example_index > _num_examples)
+  { THROW("can't seek to example " << example_index << " of a cache with " << _num_examples << " examples"); }
+  _position = example_index;
+}
+
+size_t mapped_cache_reader::read_next(example& ae, label_parser& lbl_parser, shared_data* sd, bool sorted_cache)
+{
+  if (_position >= _num_examples) { return 0; }
+  return read_at(_position++, ae, lbl_parser, sd, sorted_cache);
+}
+
+size_t mapped_cache_reader::read_at(
+    size_t example_index, example& ae, label_parser& lbl_parser, shared_data* sd, bool sorted_cache)
+{
+  if (example_index >= _num_examples) { return 0; }
+
+  // Nothing in the file is trusted: the offset, every size and every count is checked against the record before it
+  // is used, so a corrupt or truncated cache can't make the reader leave the mapping.
+  const uint64_t offset = _offsets[example_index];
+  if (offset < _records_begin || offset > _records_end || offset % RECORD_ALIGNMENT != 0 ||
+      _records_end - offset < sizeof(record_header))
+  { THROW("mapped cache record " << example_index << " has a corrupt offset"); }
+  const char* record = _data + offset;
+  record_header header;
+  std::memcpy(&header, record, sizeof(header));
+  if (header.record_size < sizeof(header) || header.record_size > _records_end - offset)
+  { THROW("mapped cache record " << example_index << " extends past the end of the records"); }
+  const char* const end = record + header.record_size;
+  const char* p = record + sizeof(header);
+  auto check_room = [&](uint64_t bytes) {
+    if (bytes > static_cast<uint64_t>(end - p))
+    { THROW("mapped cache record " << example_index << " is corrupt, it is shorter than its contents"); }
+  };
+
+  check_room(static_cast<uint64_t>(header.label_size) + header.tag_size);
+  _label_span->set_span(p, header.label_size);
+  _label_buf.reset_buffer();
+  _label_buf.current = 0;
+  if (lbl_parser.read_cached_label(sd, &ae.l, ae._reduction_features, _label_buf) == 0) { return 0; }
+  p += header.label_size;
+
+  ae.sorted = sorted_cache && header.sorted != 0;
+  ae.is_newline = header.is_newline != 0;
+  ae.tag.clear();
+  ae.tag.insert(ae.tag.end(), p, p + header.tag_size);
+  p += header.tag_size;
+  check_room(padding_for(static_cast<size_t>(p - record)));
+  p += padding_for(static_cast<size_t>(p - record));
+
+  for (uint16_t i = 0; i < header.num_namespaces; ++i)
+  {
+    check_room(sizeof(namespace_header));
+    namespace_header ns_header;
+    std::memcpy(&ns_header, p, sizeof(ns_header));
+    p += sizeof(ns_header);
+
+    if (ns_header.count > static_cast<uint64_t>(end - p) / (sizeof(feature_index) + sizeof(feature_value)))
+    { THROW("mapped cache record " << example_index << " is corrupt, it is shorter than its contents"); }
+    const auto* indices = reinterpret_cast<const feature_index*>(p);
+    p += ns_header.count * sizeof(feature_index);
+    const auto* values = reinterpret_cast<const feature_value*>(p);
+    p += ns_header.count * sizeof(feature_value);
+    check_room(padding_for(static_cast<size_t>(p - record)));
+    p += padding_for(static_cast<size_t>(p - record));
+
+    ae.indices.push_back(ns_header.index);
+    features& fs = ae.feature_space[ns_header.index];
+    fs.indicies.insert(fs.indicies.end(), indices, indices + ns_header.count);
+    fs.values.insert(fs.values.end(), values, values + ns_header.count);
+    fs.sum_feat_sq += ns_header.sum_feat_sq;
+  }
+
+  return static_cast<size_t>(header.record_size);
+}
+}  // namespace VW
+
+int read_mapped_cached_features(vw* all, v_array<example*>& examples)
+{
+  parser& p = *all->example_parser;
+  const size_t bytes = p.mapped_cache->read_next(*examples[0], p.lbl_parser, p._shared_data, p.sorted_cache);
+  return static_cast<int>(std::min<size_t>(bytes, std::numeric_limits<int>::max()));
+}
@@ -0,0 +1,106 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io_buf.h"
+#include "example.h"
+#include "label_parser.h"
+
+/*
+ * Memory mappable cache layout. The file starts with the same header as the varint cache (version string, cache type
+ * byte and num_bits) but uses MAPPED_CACHE_TYPE as the type byte. It continues with:
+ *
+ *   padding to 8 bytes
+ *   record*                 one per example, each 8 byte aligned
+ *   uint64_t offset[n]      file offset of every record
+ *   uint64_t n
+ *   uint64_t index_offset   file offset of the offset table
+ *   uint64_t magic
+ *
+ * A record is a record_header, the cached label and tag bytes, and then one column group per namespace:
+ * a namespace_header followed by `count` uint64_t indices and `count` float values.
+ * Fixed width columns let the reader copy each namespace with two memcpy calls instead of decoding varints, and the
+ * offset table lets it start at any example without reading the ones before it.
+ */
+
+namespace VW
+{
+constexpr char MAPPED_CACHE_TYPE = 'm';
+
+namespace details
+{
+class span_reader;
+}
+
+class mapped_cache_writer
+{
+public:
+  /// header_size is the number of bytes already written to the output by make_write_cache.
+  explicit mapped_cache_writer(uint64_t header_size);
+  ~mapped_cache_writer();
+
+  void write_example(io_buf& output, example& ae, label_parser& lbl_parser, uint64_t parse_mask);
+  /// Appends the offset table and footer. No examples may be written afterwards.
+  void finish(io_buf& output);
+
+  size_t num_examples() const { return _offsets.size(); }
+
+private:
+  void write_padding(io_buf& output);
+
+  uint64_t _bytes_written;
+  std::vector<uint64_t> _offsets;
+  std::shared_ptr<std::vector<char>> _label_bytes;
+  io_buf _label_buf;
+  std::vector<char> _record;
+};
+
+class mapped_cache_reader
+{
+public:
+  /// Maps file_name read-only. Throws if it is not a complete mapped cache.
+  explicit mapped_cache_reader(const std::string& file_name);
+  ~mapped_cache_reader();
+
+  mapped_cache_reader(const mapped_cache_reader&) = delete;
+  mapped_cache_reader& operator=(const mapped_cache_reader&) = delete;
+
+  uint32_t num_bits() const { return _num_bits; }
+  size_t num_examples() const { return static_cast<size_t>(_num_examples); }
+
+  /// Index of the example returned by the next call to read_next.
+  size_t position() const { return _position; }
+  void seek(size_t example_index);
+
+  /// Reads the example at position() into ae and advances. Returns the record size or 0 once all examples are read.
+  size_t read_next(example& ae, label_parser& lbl_parser, shared_data* sd, bool sorted_cache);
+  /// Reads the example at example_index without changing position().
+  size_t read_at(size_t example_index, example& ae, label_parser& lbl_parser, shared_data* sd, bool sorted_cache);
+
+private:
+  const char* _data = nullptr;
+  size_t _size = 0;
+#ifdef _WIN32
+  std::vector<char> _file_contents;
+#endif
+  uint32_t _num_bits = 0;
+  uint64_t _num_examples = 0;
+  const uint64_t* _offsets = nullptr;
+  uint64_t _records_begin = 0;  // file offsets of the first byte after the header and of the offset table
+  uint64_t _records_end = 0;
+  size_t _position = 0;
+
+  // Labels are cached through the label parser's io_buf interface, so they are read through a reader over the record.
+  details::span_reader* _label_span = nullptr;  // owned by _label_buf
+  io_buf _label_buf;
+};
+}  // namespace VW
+
+int read_mapped_cached_features(vw* all, v_array<example*>& examples);
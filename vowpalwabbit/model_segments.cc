@@ -0,0 +1,204 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "model_segments.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "hash.h"
+#include "io/compression.h"
+#include "thread_pool.h"
+#include "vw_exception.h"
+
+namespace
+{
+// Segments held in memory at once per thread, so a wave bounds memory use while keeping every thread busy.
+constexpr size_t SEGMENTS_PER_THREAD = 2;
+constexpr int COMPRESSION_LEVEL = 1;  // zlib's fastest level, checkpoints are on the training path
+
+struct segment
+{
+  uint64_t offset = 0;
+  uint64_t stored_bytes = 0;
+  uint32_t checksum = 0;
+  uint32_t compressed = 0;
+  std::vector<char> raw;
+  std::vector<char> stored;
+};
+
+size_t pool_size(size_t threads)
+{
+  if (threads == 0) { threads = std::thread::hardware_concurrency(); }
+  return std::max<size_t>(threads, 1);
+}
+
+template <typename T>
+void write_value(io_buf& model_file, T value)
+{
+  model_file.bin_write_fixed(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T read_value(io_buf& model_file)
+{
+  T value{};
+  if (model_file.bin_read_fixed(reinterpret_cast<char*>(&value), sizeof(value), "") != sizeof(value))
+    THROW("Model content is corrupted, the weight segments are truncated");
+  return value;
+}
+
+uint32_t checksum(const std::vector<char>& raw)
+{
+  return static_cast<uint32_t>(uniform_hash(raw.data(), raw.size(), 0));
+}
+}  // namespace
+
+void VW::write_weight_segments(
+    io_buf& model_file, dense_parameters& weights, uint32_t floats_per_weight, size_t threads, bool compress)
+{
+  const uint64_t weight_count = (weights.mask() + 1) >> weights.stride_shift();
+  const uint64_t segment_count = (weight_count + MODEL_SEGMENT_WEIGHTS - 1) / MODEL_SEGMENT_WEIGHTS;
+  const uint64_t stride = weights.stride();
+  if (floats_per_weight == 0 || floats_per_weight > std::min<uint64_t>(stride, MAX_FLOATS_PER_WEIGHT))
+    THROW("weight segments can't hold " << floats_per_weight << " floats of weights with a stride of " << stride);
+  const uint64_t start = model_file.output_offset();
+  write_value(model_file, floats_per_weight);
+  write_value(model_file, weight_count);
+  write_value(model_file, MODEL_SEGMENT_WEIGHTS);
+
+  VW::thread_pool pool(pool_size(threads));
+  std::vector<segment> wave(pool.size() * SEGMENTS_PER_THREAD);
+  std::vector<segment> manifest;
+  for (uint64_t first = 0; first < segment_count; first += wave.size())
+  {
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(wave.size(), segment_count - first));
+    pool.parallel_for(count, [&](size_t s) {
+      segment& seg = wave[s];
+      const uint64_t begin = (first + s) * MODEL_SEGMENT_WEIGHTS;
+      const uint64_t end = std::min(weight_count, begin + MODEL_SEGMENT_WEIGHTS);
+      seg.raw.resize(static_cast<size_t>((end - begin) * floats_per_weight * sizeof(weight)));
+      weight* out = reinterpret_cast<weight*>(seg.raw.data());
+      for (uint64_t i = begin; i < end; ++i)
+      {
+        const weight* w = &weights[i * stride];
+        std::copy(w, w + floats_per_weight, out);
+        out += floats_per_weight;
+      }
+      seg.checksum = checksum(seg.raw);
+      // Incompressible segments, e.g. of dense random weights, are stored as they are.
+      seg.compressed = compress && VW::io::compress_buffer(seg.raw.data(), seg.raw.size(), seg.stored,
+                                       COMPRESSION_LEVEL) &&
+          seg.stored.size() < seg.raw.size();
+      seg.stored_bytes = seg.compressed ? seg.stored.size() : seg.raw.size();
+    });
+
+    for (size_t s = 0; s < count; ++s)
+    {
+      segment& seg = wave[s];
+      seg.offset = model_file.output_offset() - start;
+      write_value(model_file, seg.stored_bytes);
+      write_value(model_file, seg.checksum);
+      write_value(model_file, seg.compressed);
+      const auto& payload = seg.compressed ? seg.stored : seg.raw;
+      model_file.bin_write_fixed(payload.data(), payload.size());
+
+      manifest.emplace_back();
+      manifest.back().offset = seg.offset;
+      manifest.back().stored_bytes = seg.stored_bytes;
+      manifest.back().checksum = seg.checksum;
+      manifest.back().compressed = seg.compressed;
+    }
+  }
+
+  write_value(model_file, segment_count);
+  for (const auto& seg : manifest)
+  {
+    write_value(model_file, seg.offset);
+    write_value(model_file, seg.stored_bytes);
+    write_value(model_file, seg.checksum);
+    write_value(model_file, seg.compressed);
+  }
+}
+
+void VW::read_weight_segments(io_buf& model_file, dense_parameters& weights, size_t threads)
+{
+  const uint64_t start = model_file.input_offset();
+  const auto floats_per_weight = read_value<uint32_t>(model_file);
+  const auto weight_count = read_value<uint64_t>(model_file);
+  const auto weights_per_segment = read_value<uint64_t>(model_file);
+  const uint64_t length = (weights.mask() + 1) >> weights.stride_shift();
+  if (floats_per_weight == 0 || floats_per_weight > MAX_FLOATS_PER_WEIGHT || weights_per_segment == 0 ||
+      weight_count != length)
+    THROW("Model content is corrupted, the weight segments do not hold " << length << " weights");
+
+  const uint64_t segment_count = (weight_count + weights_per_segment - 1) / weights_per_segment;
+  const uint64_t stride = weights.stride();
+  const uint32_t copied = static_cast<uint32_t>(std::min<uint64_t>(floats_per_weight, stride));
+
+  VW::thread_pool pool(pool_size(threads));
+  std::vector<segment> wave(pool.size() * SEGMENTS_PER_THREAD);
+  std::vector<segment> seen;
+  for (uint64_t first = 0; first < segment_count; first += wave.size())
+  {
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(wave.size(), segment_count - first));
+    for (size_t s = 0; s < count; ++s)
+    {
+      segment& seg = wave[s];
+      seg.offset = model_file.input_offset() - start;
+      seg.stored_bytes = read_value<uint64_t>(model_file);
+      seg.checksum = read_value<uint32_t>(model_file);
+      seg.compressed = read_value<uint32_t>(model_file);
+      const uint64_t begin = (first + s) * weights_per_segment;
+      const uint64_t raw_bytes = (std::min(weight_count, begin + weights_per_segment) - begin) * floats_per_weight *
+          sizeof(weight);
+      if (seg.compressed > 1 || (seg.compressed ? seg.stored_bytes >= raw_bytes : seg.stored_bytes != raw_bytes))
+        THROW("Model content is corrupted, weight segment " << first + s << " has an invalid size");
+      seg.raw.resize(static_cast<size_t>(raw_bytes));
+      auto& payload = seg.compressed ? seg.stored : seg.raw;
+      payload.resize(static_cast<size_t>(seg.stored_bytes));
+      if (model_file.bin_read_fixed(payload.data(), payload.size(), "") != payload.size())
+        THROW("Model content is corrupted, the weight segments are truncated");
+
+      seen.emplace_back();
+      seen.back().offset = seg.offset;
+      seen.back().stored_bytes = seg.stored_bytes;
+      seen.back().checksum = seg.checksum;
+      seen.back().compressed = seg.compressed;
+    }
+
+    pool.parallel_for(count, [&](size_t s) {
+      segment& seg = wave[s];
+      if (seg.compressed && !VW::io::decompress_buffer(seg.stored.data(), seg.stored.size(), seg.raw.data(),
+                                seg.raw.size()))
+        THROW("Model content is corrupted, weight segment " << first + s << " can't be decompressed");
+      if (checksum(seg.raw) != seg.checksum)
+        THROW("Model content is corrupted, weight segment " << first + s << " fails its checksum");
+
+      const weight* in = reinterpret_cast<const weight*>(seg.raw.data());
+      const uint64_t begin = (first + s) * weights_per_segment;
+      const uint64_t end = begin + seg.raw.size() / (floats_per_weight * sizeof(weight));
+      for (uint64_t i = begin; i < end; ++i, in += floats_per_weight)
+      {
+        if (std::all_of(in, in + floats_per_weight, [](weight f) { return f == 0.f; })) { continue; }
+        weight* w = &weights[i * stride];
+        std::copy(in, in + copied, w);
+        std::fill(w + copied, w + stride, 0.f);
+      }
+    });
+  }
+
+  if (read_value<uint64_t>(model_file) != segment_count)
+    THROW("Model content is corrupted, the weight segment manifest does not match the segments");
+  for (const auto& seg : seen)
+  {
+    const auto offset = read_value<uint64_t>(model_file);
+    const auto stored_bytes = read_value<uint64_t>(model_file);
+    const auto checksum = read_value<uint32_t>(model_file);
+    const auto compressed = read_value<uint32_t>(model_file);
+    if (offset != seg.offset || stored_bytes != seg.stored_bytes || checksum != seg.checksum ||
+        compressed != seg.compressed)
+      THROW("Model content is corrupted, the weight segment manifest does not match the segments");
+  }
+}
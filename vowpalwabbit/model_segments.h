@@ -0,0 +1,38 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "array_parameters_dense.h"
+#include "io_buf.h"
+
+// With --chunked_model the dense weights are saved as a container of segments, each holding the first
+// floats_per_weight floats of a fixed number of consecutive weights. Segments are encoded, checksummed and optionally
+// compressed in parallel, and decoded, verified and copied into the weights in parallel when loading, so only the file
+// access itself is sequential.
+//
+// Layout, all integers little endian:
+//   floats_per_weight (u32), weight_count (u64), weights_per_segment (u64)
+//   for each segment: stored_bytes (u64), checksum (u32), compressed (u32), stored_bytes of payload
+//   manifest: segment_count (u64), then for each segment its offset from the start of the container (u64),
+//   stored_bytes (u64), checksum (u32) and compressed (u32)
+// The checksum is the uniform_hash of the uncompressed payload. The manifest lets tools find a segment without
+// decoding the ones before it, and the reader checks it against the segments it has read.
+namespace VW
+{
+constexpr uint64_t MODEL_SEGMENT_WEIGHTS = static_cast<uint64_t>(1) << 16;
+constexpr uint32_t MAX_FLOATS_PER_WEIGHT = 8;
+
+/// Writes weights as a segment container using threads threads, 0 for one per core.
+void write_weight_segments(
+    io_buf& model_file, dense_parameters& weights, uint32_t floats_per_weight, size_t threads, bool compress);
+
+/// Reads a segment container written by write_weight_segments into weights, which must hold weight_count weights but
+/// may have a different stride. Floats of the stride that were not saved are set to 0, and weights whose saved floats
+/// are all 0 are left as they are, like the sequential format does.
+void read_weight_segments(io_buf& model_file, dense_parameters& weights, size_t threads);
+}  // namespace VW
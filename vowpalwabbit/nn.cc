@@ -44,6 +44,7 @@ struct nn
 
   float* hidden_units;
   bool* dropped_out;
+  float* hidden_labels;  // for multiupdate
 
   polyprediction* hidden_units_pred;
   polyprediction* hiddenbias_pred;
@@ -55,6 +56,7 @@ struct nn
   {
     free(hidden_units);
     free(dropped_out);
+    free(hidden_labels);
     free(hidden_units_pred);
     free(hiddenbias_pred);
   }
@@ -97,7 +99,7 @@ void finish_setup(nn& n, vw& all)
     {
       std::stringstream ss;
       ss << "OutputLayer" << i;
-      fs.space_names.push_back(audit_strings("", ss.str()));
+      fs.space_names.push_back(audit_strings(VW::interned_string(), all.name_table.intern(ss.str())));
     }
     nn_index += static_cast<uint64_t>(n.increment);
   }
@@ -106,7 +108,8 @@ void finish_setup(nn& n, vw& all)
   if (!n.inpass)
   {
     fs.push_back(1., nn_index);
-    if (all.audit || all.hash_inv) fs.space_names.push_back(audit_strings("", "OutputLayerConst"));
+    if (all.audit || all.hash_inv)
+    { fs.space_names.push_back(audit_strings(VW::interned_string(), all.name_table.intern("OutputLayerConst"))); }
     ++n.output_layer.num_features;
   }
 
@@ -115,7 +118,10 @@ void finish_setup(nn& n, vw& all)
   n.hiddenbias.indices.push_back(constant_namespace);
   n.hiddenbias.feature_space[constant_namespace].push_back(1, constant);
   if (all.audit || all.hash_inv)
-    n.hiddenbias.feature_space[constant_namespace].space_names.push_back(audit_strings("", "HiddenBias"));
+  {
+    n.hiddenbias.feature_space[constant_namespace].space_names.push_back(
+        audit_strings(VW::interned_string(), all.name_table.intern("HiddenBias")));
+  }
   n.hiddenbias.l.simple.label = FLT_MAX;
   n.hiddenbias.weight = 1;
 
@@ -124,7 +130,10 @@ void finish_setup(nn& n, vw& all)
   features& outfs = n.output_layer.feature_space[nn_output_namespace];
   n.outputweight.feature_space[nn_output_namespace].push_back(outfs.values[0], outfs.indicies[0]);
   if (all.audit || all.hash_inv)
-    n.outputweight.feature_space[nn_output_namespace].space_names.push_back(audit_strings("", "OutputWeight"));
+  {
+    n.outputweight.feature_space[nn_output_namespace].space_names.push_back(
+        audit_strings(VW::interned_string(), all.name_table.intern("OutputWeight")));
+  }
   n.outputweight.feature_space[nn_output_namespace].values[0] = 1;
   n.outputweight.l.simple.label = FLT_MAX;
   n.outputweight.weight = 1;
@@ -327,8 +336,14 @@ void predict_or_learn_multi(nn& n, single_learner& base, example& ec)
 
           if (n.multitask) ec.ft_offset = 0;
 
+          // The hidden units are consecutive regressors, so every run of units that are updated is updated with one
+          // multiupdate, which walks the features of ec once for all of them. Regularization rescales the weights after
+          // every update, which changes the output weight of the next unit, so it keeps one update per unit.
+          const bool per_unit = n.all->reg_mode != 0;
+          unsigned int run_start = 0;
           for (unsigned int i = 0; i < n.k; ++i)
           {
+            bool update_unit = false;
             if (!dropped_out[i])
             {
               float sigmah = n.output_layer.feature_space[nn_output_namespace].values[i] / dropscale;
@@ -339,11 +354,22 @@ void predict_or_learn_multi(nn& n, single_learner& base, example& ec)
               float nu = n.outputweight.pred.scalar;
               float gradhw = 0.5f * nu * gradient * sigmahprime;
 
-              ec.l.simple.label = GD::finalize_prediction(n.all->sd, n.all->logger, hidden_units[i].scalar - gradhw);
-              ec.pred.scalar = hidden_units[i].scalar;
-              if (ec.l.simple.label != hidden_units[i].scalar) base.update(ec, i);
+              n.hidden_labels[i] = GD::finalize_prediction(n.all->sd, n.all->logger, hidden_units[i].scalar - gradhw);
+              update_unit = n.hidden_labels[i] != hidden_units[i].scalar;
+            }
+            if (!update_unit || per_unit)
+            {
+              const unsigned int run_end = update_unit ? i + 1 : i;
+              if (run_end > run_start)
+              {
+                base.multiupdate(
+                    ec, run_start, run_end - run_start, hidden_units + run_start, n.hidden_labels + run_start);
+              }
+              run_start = i + 1;
             }
           }
+          if (n.k > run_start)
+          { base.multiupdate(ec, run_start, n.k - run_start, hidden_units + run_start, n.hidden_labels + run_start); }
 
           loss_function_swap_guard_learn_block.do_swap();
           n.all->set_minmax = save_set_minmax;
@@ -448,6 +474,7 @@ base_learner* nn_setup(options_i& options, vw& all)
 
   n->hidden_units = calloc_or_throw<float>(n->k);
   n->dropped_out = calloc_or_throw<bool>(n->k);
+  n->hidden_labels = calloc_or_throw<float>(n->k);
   n->hidden_units_pred = calloc_or_throw<polyprediction>(n->k);
   n->hiddenbias_pred = calloc_or_throw<polyprediction>(n->k);
 
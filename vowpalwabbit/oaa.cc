@@ -21,6 +21,7 @@ struct oaa
   uint64_t k;
   vw* all;                    // for raw
   polyprediction* pred;       // for multipredict
+  float* labels;              // for multiupdate
   uint64_t num_subsample;     // for randomized subsampling, how many negatives to draw?
   uint32_t* subsample_order;  // for randomized subsampling, in what order should we touch classes
   size_t subsample_id;        // for randomized subsampling, where do we live in the list
@@ -28,6 +29,7 @@ struct oaa
   ~oaa()
   {
     free(pred);
+    free(labels);
     free(subsample_order);
   }
 };
@@ -83,15 +85,11 @@ void learn(oaa& o, VW::LEARNER::single_learner& base, example& ec)
   ec.l.simple = {FLT_MAX};
   ec._reduction_features.template get<simple_label_reduction_features>().reset_to_default();
 
-  for (uint32_t i = 1; i <= o.k; i++)
-  {
-    ec.l.simple = {(mc_label_data.label == i) ? 1.f : -1.f};
-    // The following is an unfortunate loss of abstraction
-    // Downstream reduction (gd.update) uses the prediction
-    // from here
-    ec.pred.scalar = o.pred[i - 1].scalar;
-    base.update(ec, i - 1);
-  }
+  for (uint32_t i = 1; i <= o.k; i++) o.labels[i - 1] = (mc_label_data.label == i) ? 1.f : -1.f;
+  // The following is an unfortunate loss of abstraction
+  // Downstream reduction (gd.update) uses the predictions
+  // from predict
+  base.multiupdate(ec, 0, o.k, o.pred, o.labels);
 
   // Restore label
   ec.l.multi = mc_label_data;
@@ -237,6 +235,7 @@ VW::LEARNER::base_learner* oaa_setup(options_i& options, vw& all)
 
   data->all = &all;
   data->pred = calloc_or_throw<polyprediction>(data->k);
+  data->labels = calloc_or_throw<float>(data->k);
   data->subsample_order = nullptr;
   data->subsample_id = 0;
   if (data->num_subsample > 0)
@@ -4,9 +4,17 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <memory>
 #include <set>
 #include <queue>
 #include <stack>
+#include <vector>
+
+#include "lock_free_queue.h"
+#include "vw_exception.h"
 
 // Mutex and CV cannot be used in managed C++, tell the compiler that this is unmanaged even if included in a managed
 // project.
@@ -191,4 +199,108 @@ private:
   mutable std::mutex m_lock;
   no_lock_object_pool<T, TInitializer, TCleanup> inner_pool;
 };
+/// Object pool whose free list is a lock_free_ptr_queue so that getting and returning objects from different threads
+/// does not take a lock. Growing the pool and overflowing the free list are rare and fall back to a mutex.
+/// Chunks double in size as the pool grows which bounds the number of chunks that is_from_pool has to scan.
+template <typename T, typename TInitializer = default_initializer<T>, typename TCleanup = default_cleanup<T>>
+struct lock_free_object_pool
+{
+  lock_free_object_pool(size_t initial_chunk_size, TInitializer initializer = {})
+      : m_initializer(initializer), m_free_list(initial_chunk_size * 2)
+  {
+    std::unique_lock<std::mutex> lock(m_grow_lock);
+    new_chunk(initial_chunk_size > 0 ? initial_chunk_size : 8);
+  }
+
+  ~lock_free_object_pool()
+  {
+    T* obj;
+    while (m_free_list.try_pop(obj)) { m_cleanup(obj); }
+    for (auto* overflow_obj : m_overflow) { m_cleanup(overflow_obj); }
+  }
+
+  void return_object(T* obj)
+  {
+    assert(is_from_pool(obj));
+    if (!m_free_list.try_push(obj))
+    {
+      std::unique_lock<std::mutex> lock(m_grow_lock);
+      m_overflow.push_back(obj);
+    }
+  }
+
+  T* get_object()
+  {
+    T* obj;
+    if (m_free_list.try_pop(obj)) { return obj; }
+
+    std::unique_lock<std::mutex> lock(m_grow_lock);
+    while (true)
+    {
+      if (!m_overflow.empty())
+      {
+        obj = m_overflow.back();
+        m_overflow.pop_back();
+        return obj;
+      }
+      if (m_free_list.try_pop(obj)) { return obj; }
+      new_chunk(m_chunk_sizes[m_num_chunks.load() - 1] * 2);
+    }
+  }
+
+  size_t size() const
+  {
+    size_t size = 0;
+    const size_t num_chunks = m_num_chunks.load();
+    for (size_t i = 0; i < num_chunks; ++i) { size += m_chunk_sizes[i]; }
+    return size;
+  }
+
+  bool is_from_pool(T* obj) const
+  {
+    // Chunk bounds are written before m_num_chunks is published and never change afterwards.
+    const size_t num_chunks = m_num_chunks.load();
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+      if (obj >= m_chunk_bounds[i].first && obj <= m_chunk_bounds[i].second) { return true; }
+    }
+
+    return false;
+  }
+
+private:
+  static constexpr size_t MAX_CHUNKS = 48;
+
+  // Must be called with m_grow_lock held. Objects that do not fit in the free list go to the overflow list, which
+  // get_object drains under the same lock, so the free list never has to grow.
+  void new_chunk(size_t size)
+  {
+    const size_t chunk_index = m_num_chunks.load();
+    if (chunk_index == MAX_CHUNKS) { THROW("lock_free_object_pool exhausted its chunk table"); }
+
+    m_chunks[chunk_index].reset(new T[size]);
+    auto& chunk = m_chunks[chunk_index];
+    m_chunk_bounds[chunk_index] = {&chunk[0], &chunk[size - 1]};
+    m_chunk_sizes[chunk_index] = size;
+    m_num_chunks.store(chunk_index + 1);
+
+    for (size_t i = 0; i < size; i++)
+    {
+      T* obj = m_initializer(&chunk[i]);
+      if (!m_free_list.try_push(obj)) { m_overflow.push_back(obj); }
+    }
+  }
+
+  TInitializer m_initializer;
+  TCleanup m_cleanup;
+
+  lock_free_ptr_queue<T> m_free_list;
+  std::mutex m_grow_lock;
+  std::vector<T*> m_overflow;
+
+  std::array<std::unique_ptr<T[]>, MAX_CHUNKS> m_chunks;
+  std::array<std::pair<T*, T*>, MAX_CHUNKS> m_chunk_bounds;
+  std::array<size_t, MAX_CHUNKS> m_chunk_sizes;
+  std::atomic<size_t> m_num_chunks{0};
+};
 }  // namespace VW
@@ -0,0 +1,304 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "page_allocator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+#if defined(__linux__)
+#  include <sys/syscall.h>
+#endif
+
+#if defined(__APPLE__) && !defined(MAP_ANONYMOUS)
+#  define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#include "vw_exception.h"
+
+namespace
+{
+// This file is also built into vw_slim, which has no logger.
+void warn(const char* msg)
+{
+  fputs(msg, stderr);
+  fputs("\n", stderr);
+}
+
+constexpr size_t TWO_MB = static_cast<size_t>(1) << 21;
+constexpr size_t ONE_GB = static_cast<size_t>(1) << 30;
+
+size_t base_page_size()
+{
+#ifndef _WIN32
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 4096;
+#endif
+}
+
+size_t round_up(size_t length, size_t page_size) { return (length + page_size - 1) / page_size * page_size; }
+
+#if defined(__linux__)
+#  ifndef MAP_HUGE_SHIFT
+#    define MAP_HUGE_SHIFT 26
+#  endif
+// Policies from <numaif.h>, used through the raw syscall to avoid a libnuma dependency.
+constexpr int MPOL_BIND_MODE = 2;
+constexpr int MPOL_INTERLEAVE_MODE = 3;
+constexpr size_t BITS_PER_MASK_WORD = 8 * sizeof(unsigned long);
+
+// Parses a node list such as "0-3,6" from sysfs.
+std::vector<int> online_numa_nodes()
+{
+  std::vector<int> nodes;
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string range;
+  while (std::getline(file, range, ','))
+  {
+    int first = 0;
+    int last = 0;
+    char dash = 0;
+    std::istringstream ss(range);
+    if (!(ss >> first)) { continue; }
+    last = (ss >> dash >> last) ? last : first;
+    for (int node = first; node <= last; ++node) { nodes.push_back(node); }
+  }
+  return nodes;
+}
+
+// Must run before the pages are first touched, which is guaranteed for a fresh anonymous mapping.
+VW::page_status apply_numa_policy(void* data, size_t length, const VW::page_options& options)
+{
+  if (options.numa == VW::numa_mode::none) { return VW::page_status::ok; }
+
+  std::vector<int> nodes = online_numa_nodes();
+  if (nodes.empty())
+  {
+    warn("NUMA topology is not available, weights are allocated with the default policy");
+    return VW::page_status::ok;
+  }
+  if (options.numa == VW::numa_mode::bind)
+  {
+    bool online = false;
+    for (int node : nodes) { online = online || node == options.numa_node; }
+    if (!online) { return VW::page_status::numa_node_offline; }
+    nodes.assign(1, options.numa_node);
+  }
+
+  int max_node = 0;
+  for (int node : nodes) { max_node = std::max(max_node, node); }
+  std::vector<unsigned long> mask(max_node / BITS_PER_MASK_WORD + 1, 0);
+  for (int node : nodes) { mask[node / BITS_PER_MASK_WORD] |= 1UL << (node % BITS_PER_MASK_WORD); }
+
+  const int mode = options.numa == VW::numa_mode::interleave ? MPOL_INTERLEAVE_MODE : MPOL_BIND_MODE;
+  // The kernel reads maxnode - 1 bits of the mask.
+  if (syscall(SYS_mbind, data, length, mode, mask.data(), mask.size() * BITS_PER_MASK_WORD + 1, 0) != 0)
+  { warn("mbind of the weights failed, they are allocated with the default NUMA policy"); }
+  return VW::page_status::ok;
+}
+
+// Size the kernel uses for transparent huge pages, or 0 if they are disabled.
+size_t transparent_huge_page_size()
+{
+  std::ifstream enabled("/sys/kernel/mm/transparent_hugepage/enabled");
+  std::string setting;
+  std::getline(enabled, setting);
+  if (setting.empty() || setting.find("[never]") != std::string::npos) { return 0; }
+
+  size_t size = 0;
+  std::ifstream pmd_size("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+  return (pmd_size >> size) ? size : TWO_MB;
+}
+
+bool map_hugetlb(VW::page_region& region, size_t length, size_t page_size, int visibility)
+{
+  const int size_flag = (page_size == ONE_GB ? 30 : 21) << MAP_HUGE_SHIFT;
+  const size_t rounded = round_up(length, page_size);
+  void* data =
+      mmap(nullptr, rounded, PROT_READ | PROT_WRITE, visibility | MAP_ANONYMOUS | MAP_HUGETLB | size_flag, -1, 0);
+  if (data == MAP_FAILED) { return false; }
+  region.data = data;
+  region.length = rounded;
+  region.page_size = page_size;
+  return true;
+}
+
+// Maps with regular pages and advises the kernel to back the mapping with transparent huge pages. Huge pages can
+// only be used for aligned 2MB ranges, so the mapping is over allocated and trimmed to an aligned start.
+bool map_transparent(VW::page_region& region, size_t length, int visibility)
+{
+  const size_t huge_size = transparent_huge_page_size();
+  if (huge_size == 0) { return false; }
+
+  const size_t rounded = round_up(length, huge_size);
+  char* raw = static_cast<char*>(
+      mmap(nullptr, rounded + huge_size, PROT_READ | PROT_WRITE, visibility | MAP_ANONYMOUS, -1, 0));
+  if (raw == reinterpret_cast<char*>(MAP_FAILED)) { return false; }
+  char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<size_t>(raw), huge_size));
+  if (aligned != raw) { munmap(raw, aligned - raw); }
+  const size_t tail = (raw + rounded + huge_size) - (aligned + rounded);
+  if (tail != 0) { munmap(aligned + rounded, tail); }
+
+  region.data = aligned;
+  region.length = rounded;
+  if (madvise(aligned, rounded, MADV_HUGEPAGE) == 0)
+  {
+    region.page_size = huge_size;
+    region.transparent = true;
+  }
+  else
+  {
+    region.page_size = base_page_size();
+  }
+  return true;
+}
+#endif
+}  // namespace
+
+VW::huge_page_mode VW::parse_huge_page_mode(const std::string& mode)
+{
+  if (mode == "transparent") { return huge_page_mode::transparent; }
+  if (mode == "2m" || mode == "2M") { return huge_page_mode::huge_2mb; }
+  if (mode == "1g" || mode == "1G") { return huge_page_mode::huge_1gb; }
+  THROW_OR_RETURN("huge_pages must be one of transparent, 2m or 1g, but was: " << mode, huge_page_mode::none);
+}
+
+VW::page_status VW::try_allocate_pages(size_t length, const page_options& options, bool shared, page_region& region)
+{
+  region = page_region();
+  if (length == 0) { return page_status::ok; }
+
+#ifndef _WIN32
+  const int visibility = shared ? MAP_SHARED : MAP_PRIVATE;
+  region.mapped = true;
+
+#  if !defined(__linux__)
+  if (!options.is_default())
+  { warn("huge pages and NUMA placement are not supported on this platform, using regular pages"); }
+#  else
+  bool allocated = false;
+  if (options.huge_pages == huge_page_mode::huge_1gb)
+  {
+    allocated = map_hugetlb(region, length, ONE_GB, visibility);
+    if (!allocated) { warn("no 1GB huge pages are available, trying 2MB huge pages"); }
+  }
+  if (!allocated && (options.huge_pages == huge_page_mode::huge_1gb || options.huge_pages == huge_page_mode::huge_2mb))
+  {
+    allocated = map_hugetlb(region, length, TWO_MB, visibility);
+    if (!allocated) { warn("no 2MB huge pages are available, trying transparent huge pages"); }
+  }
+  if (!allocated && options.huge_pages != huge_page_mode::none)
+  {
+    allocated = map_transparent(region, length, visibility);
+    if (!allocated) { warn("transparent huge pages are disabled, using regular pages"); }
+  }
+  if (!allocated)
+#  endif
+  {
+    region.page_size = base_page_size();
+    region.length = round_up(length, region.page_size);
+    region.data = mmap(nullptr, region.length, PROT_READ | PROT_WRITE, visibility | MAP_ANONYMOUS, -1, 0);
+    if (region.data == MAP_FAILED)
+    {
+      region = page_region();
+      return page_status::out_of_memory;
+    }
+  }
+
+#  if defined(__linux__)
+  const page_status status = apply_numa_policy(region.data, region.length, options);
+  if (status != page_status::ok)
+  {
+    free_pages(region);
+    region = page_region();
+    return status;
+  }
+#  endif
+#else
+  _UNUSED(shared);
+  if (!options.is_default())
+  { warn("huge pages and NUMA placement are not supported on this platform, using regular pages"); }
+  region.data = calloc(length, 1);
+  if (region.data == nullptr) { return page_status::out_of_memory; }
+  region.length = length;
+  region.page_size = base_page_size();
+#endif
+  return page_status::ok;
+}
+
+#ifndef VW_NOEXCEPT
+VW::page_region VW::allocate_pages(size_t length, const page_options& options, bool shared)
+{
+  page_region region;
+  const page_status status = try_allocate_pages(length, options, shared, region);
+  if (status == page_status::numa_node_offline)
+  { THROW("numa_node " << options.numa_node << " is not an online NUMA node"); }
+  if (status != page_status::ok) { THROW("failed to allocate " << length << " bytes"); }
+  return region;
+}
+#endif
+
+bool VW::map_file_pages(int fd, uint64_t offset, size_t length, page_region& region)
+{
+#ifndef _WIN32
+  if (fd < 0 || length == 0 || offset % base_page_size() != 0) { return false; }
+  // Touching a mapped page past the end of the file raises SIGBUS, so a truncated file must not be mapped.
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || static_cast<uint64_t>(file_stat.st_size) < offset + length) { return false; }
+  void* data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(offset));
+  if (data == MAP_FAILED) { return false; }
+  region = page_region();
+  region.data = data;
+  region.length = length;
+  region.page_size = base_page_size();
+  region.mapped = true;
+  region.read_only = true;
+  return true;
+#else
+  _UNUSED(fd);
+  _UNUSED(offset);
+  _UNUSED(length);
+  _UNUSED(region);
+  return false;
+#endif
+}
+
+void VW::free_pages(const page_region& region)
+{
+  if (region.data == nullptr) { return; }
+#ifndef _WIN32
+  if (region.mapped)
+  {
+    munmap(region.data, region.length);
+    return;
+  }
+#endif
+  free(region.data);
+}
+
+std::string VW::describe_page_size(const page_region& region)
+{
+  std::stringstream ss;
+  if (region.page_size >= ONE_GB && region.page_size % ONE_GB == 0) { ss << region.page_size / ONE_GB << "GB"; }
+  else if (region.page_size >= (1 << 20) && region.page_size % (1 << 20) == 0)
+  {
+    ss << region.page_size / (1 << 20) << "MB";
+  }
+  else
+  {
+    ss << region.page_size / 1024 << "KB";
+  }
+  if (region.transparent) { ss << " (transparent)"; }
+  return ss.str();
+}
@@ -0,0 +1,81 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Page level control over large allocations such as the dense weight table. Hashed feature indices touch the table
+// at random, so with 4KB pages a multi GB table misses the TLB on almost every access. Backing it with huge pages
+// and spreading or binding it across NUMA nodes is only supported on Linux, other platforms fall back to regular pages.
+namespace VW
+{
+enum class huge_page_mode
+{
+  none,
+  transparent,  // madvise(MADV_HUGEPAGE), the kernel promotes pages when it can
+  huge_2mb,     // MAP_HUGETLB from the reserved 2MB pool
+  huge_1gb      // MAP_HUGETLB from the reserved 1GB pool
+};
+
+enum class numa_mode
+{
+  none,
+  interleave,  // spread pages round robin over all online nodes
+  bind         // allocate only on numa_node
+};
+
+struct page_options
+{
+  huge_page_mode huge_pages = huge_page_mode::none;
+  numa_mode numa = numa_mode::none;
+  int numa_node = 0;
+
+  bool is_default() const { return huge_pages == huge_page_mode::none && numa == numa_mode::none; }
+};
+
+// Memory returned by allocate_pages. Release it with free_pages.
+struct page_region
+{
+  void* data = nullptr;
+  size_t length = 0;         // bytes mapped, the requested length rounded up to page_size
+  size_t page_size = 0;      // size of the pages backing the region
+  bool mapped = false;       // false when the region is heap memory that must be released with free()
+  bool transparent = false;  // page_size is what the kernel was advised to use, not a guarantee
+  bool read_only = false;    // a mapping of a file, writing to it faults
+};
+
+enum class page_status
+{
+  ok,
+  out_of_memory,     // not even regular pages could be mapped
+  numa_node_offline  // numa_mode::bind asked for a node that isn't online
+};
+
+/// Parses the argument of --huge_pages: "transparent", "2m" or "1g". Throws on anything else.
+huge_page_mode parse_huge_page_mode(const std::string& mode);
+
+/// Allocates length zeroed bytes as requested by options into region. Requests that can't be satisfied, such as an
+/// empty huge page pool, fall back to the next smaller page size with a warning. shared regions stay shared with forked
+/// children. Returns ok, or why nothing was allocated, in which case region is left empty. Doesn't throw, so that
+/// vw_slim, which is built without exceptions, can check the status and fall back to the ordinary allocation itself.
+page_status try_allocate_pages(size_t length, const page_options& options, bool shared, page_region& region);
+
+#ifndef VW_NOEXCEPT
+/// Like try_allocate_pages, but throws if nothing was allocated.
+page_region allocate_pages(size_t length, const page_options& options, bool shared);
+#endif
+
+/// Maps length bytes of the file fd starting at offset read only. The pages are shared with every other process that
+/// maps the same file. offset must be a multiple of the page size. Returns false if the range can't be mapped, e.g. on
+/// Windows, when fd is a pipe or when the file is shorter than offset + length.
+bool map_file_pages(int fd, uint64_t offset, size_t length, page_region& region);
+
+void free_pages(const page_region& region);
+
+/// Human readable page size of region, e.g. "2MB" or "2MB (transparent)".
+std::string describe_page_size(const page_region& region);
+}  // namespace VW
@@ -14,6 +14,7 @@
 #include "parser.h"
 #include "parse_primitives.h"
 #include "vw.h"
+#include "delta_checkpoint.h"
 #include "interactions.h"
 
 #include "sender.h"
@@ -286,7 +287,7 @@ void parse_dictionary_argument(vw& all, const std::string& str)
     // clear up ec
     ec->tag.clear();
     ec->indices.clear();
-    for (size_t i = 0; i < 256; i++) { ec->feature_space[i].clear(); }
+    for (auto& fs : ec->feature_space) { fs.clear(); }
   } while ((rc != EOF) && (nread > 0));
   free(buffer);
   VW::dealloc_examples(ec, 1);
@@ -453,6 +454,13 @@ input_options parse_source(vw& all, options_i& options)
       .add(make_option("kill_cache", parsed_options.kill_cache)
                .short_name("k")
                .help("do not reuse existing cache: create a new one always"))
+      .add(make_option("mapped_cache", parsed_options.mapped_cache)
+               .help("create cache files in the memory mappable columnar format, which is faster to replay over many "
+                     "passes. Existing cache files of any format are detected automatically."))
+      .add(make_option("block_cache", parsed_options.block_cache)
+               .help("create cache files with the block codec, which stores features in blocks of Stream VByte "
+                     "encoded index deltas that decode with SIMD. Existing cache files of any format are detected "
+                     "automatically."))
       .add(
           make_option("compressed", parsed_options.compressed)
               .help(
@@ -499,6 +507,9 @@ input_options parse_source(vw& all, options_i& options)
   if ((parsed_options.cache || options.was_supplied("cache_file")) && options.was_supplied("invert_hash"))
     THROW("invert_hash is incompatible with a cache file.  Use it in single pass mode only.");
 
+  if (parsed_options.mapped_cache && parsed_options.block_cache)
+    THROW("mapped_cache and block_cache select different cache formats, only one of them can be used.");
+
   if (!all.holdout_set_off &&
       (options.was_supplied("output_feature_regularizer_binary") ||
           options.was_supplied("output_feature_regularizer_text")))
@@ -1183,6 +1194,7 @@ void parse_output_preds(options_i& options, vw& all)
 
 void parse_output_model(options_i& options, vw& all)
 {
+  int model_threads;
   option_group_definition output_model_options("Output model");
   output_model_options
       .add(make_option("final_regressor", all.final_regressor_name).short_name("f").help("Final regressor"))
@@ -1192,6 +1204,22 @@ void parse_output_model(options_i& options, vw& all)
                .help("Output human-readable final regressor with feature names.  Computationally expensive."))
       .add(make_option("save_resume", all.save_resume)
                .help("save extra state so learning can be resumed later with new data"))
+      .add(make_option("mmap_model", all.mmap_model)
+               .keep()
+               .help("Save the dense weights as one page aligned block. A model saved this way is memory mapped "
+                     "read only when it is loaded with -t, so processes serving it share its pages"))
+      .add(make_option("chunked_model", all.chunked_model)
+               .keep()
+               .help("Save the dense weights as checksummed segments that are written and read in parallel"))
+      .add(make_option("compress_model_segments", all.compress_model_segments)
+               .keep()
+               .help("Compress the segments of --chunked_model with zlib"))
+      .add(make_option("model_threads", model_threads)
+               .default_value(0)
+               .help("Threads that write and read the segments of --chunked_model, 0 for one per core"))
+      .add(make_option("delta_checkpoints", all.delta_checkpoints)
+               .help("With --save_per_pass, save the passes after the first as <final_regressor>.<pass>.delta, "
+                     "holding only the weight blocks that changed since the previous pass"))
       .add(make_option("preserve_performance_counters", all.preserve_performance_counters)
                .help("reset performance counters when warmstarting"))
       .add(make_option("save_per_pass", all.save_per_pass).help("Save the model after every pass over data"))
@@ -1207,6 +1235,18 @@ void parse_output_model(options_i& options, vw& all)
 
   if (options.was_supplied("invert_hash")) all.hash_inv = true;
 
+  if (all.mmap_model && all.weights.sparse)
+    THROW("mmap_model requires dense weights, it can't be used with --sparse_weights");
+  if (all.mmap_model && all.save_resume)
+    THROW("mmap_model saves the weights only, it can't be used with --save_resume");
+  if (all.chunked_model && all.weights.sparse)
+    THROW("chunked_model requires dense weights, it can't be used with --sparse_weights");
+  if (all.chunked_model && all.mmap_model) THROW("chunked_model and mmap_model are different weight layouts");
+  if (all.compress_model_segments && !all.chunked_model)
+    THROW("compress_model_segments only applies to models saved with --chunked_model");
+  if (model_threads < 0) THROW("model_threads must not be negative");
+  all.model_threads = static_cast<size_t>(model_threads);
+
   // Question: This doesn't seem necessary
   // if (options.was_supplied("id") && find(arg.args.begin(), arg.args.end(), "--id") == arg.args.end())
   // {
@@ -1235,6 +1275,9 @@ void load_input_model(vw& all, io_buf& io_temp)
     all.l->save_load(io_temp, true, false);
     io_temp.close_file();
   }
+
+  for (const auto& delta : all.delta_files) VW::apply_delta(all, delta);
+  if (all.delta_checkpoints && !all.initial_regressors.empty()) VW::reset_delta_baseline(all);
 }
 
 VW::LEARNER::base_learner* setup_base(options_i& options, vw& all)
@@ -1417,16 +1460,25 @@ vw& parse_args(
 
     bool strict_parse = false;
     int ring_size_tmp;
+    int parse_threads_tmp;
     option_group_definition vw_args("VW options");
     vw_args.add(make_option("ring_size", ring_size_tmp).default_value(256).help("size of example ring"))
-        .add(make_option("strict_parse", strict_parse).help("throw on malformed examples"));
+        .add(make_option("strict_parse", strict_parse).help("throw on malformed examples"))
+        .add(make_option("parse_threads", parse_threads_tmp)
+                 .default_value(1)
+                 .help("number of threads used to parse text format examples. Examples are still delivered to the "
+                       "learner in input order"));
     all.options->add_and_parse(vw_args);
 
     if (ring_size_tmp <= 0) { THROW("ring_size should be positive"); }
     size_t ring_size = static_cast<size_t>(ring_size_tmp);
+    if (parse_threads_tmp <= 0) { THROW("parse_threads should be positive"); }
 
     all.example_parser = new parser{ring_size, strict_parse};
     all.example_parser->_shared_data = all.sd;
+    all.example_parser->parse_threads = static_cast<size_t>(parse_threads_tmp);
+    if (all.example_parser->parse_threads > 1)
+    { all.example_parser->parse_pool = VW::make_unique<VW::thread_pool>(all.example_parser->parse_threads); }
 
     option_group_definition update_args("Update options");
     update_args.add(make_option("learning_rate", all.eta).help("Set learning rate").short_name("l"))
@@ -1439,24 +1491,50 @@ vw& parse_args(
                        "given, also used for initial weights."));
     all.options->add_and_parse(update_args);
 
+    std::string huge_pages_arg;
+    bool numa_interleave = false;
+    int numa_node_arg;
     option_group_definition weight_args("Weight options");
     weight_args
         .add(make_option("initial_regressor", all.initial_regressors).help("Initial regressor(s)").short_name("i"))
+        .add(make_option("apply_deltas", all.delta_files)
+                 .help("Delta checkpoints to apply in order after the initial regressor is loaded"))
         .add(make_option("initial_weight", all.initial_weight).help("Set all weights to an initial value of arg."))
         .add(make_option("random_weights", all.random_weights).help("make initial weights random"))
         .add(make_option("normal_weights", all.normal_weights).help("make initial weights normal"))
         .add(make_option("truncated_normal_weights", all.tnormal_weights).help("make initial weights truncated normal"))
         .add(make_option("sparse_weights", all.weights.sparse).help("Use a sparse datastructure for weights"))
         .add(make_option("input_feature_regularizer", all.per_feature_regularizer_input)
-                 .help("Per feature regularization input file"));
+                 .help("Per feature regularization input file"))
+        .add(make_option("huge_pages", huge_pages_arg)
+                 .help("Back the dense weights with huge pages: transparent, 2m or 1g. Falls back to smaller pages "
+                       "when none of the requested size are available"))
+        .add(make_option("numa_interleave", numa_interleave)
+                 .help("Interleave the dense weights across all NUMA nodes"))
+        .add(make_option("numa_node", numa_node_arg).help("Allocate the dense weights on this NUMA node"));
     all.options->add_and_parse(weight_args);
 
+    if (all.options->was_supplied("huge_pages"))
+    { all.weights.page_options.huge_pages = VW::parse_huge_page_mode(huge_pages_arg); }
+    if (numa_interleave && all.options->was_supplied("numa_node"))
+    { THROW("numa_interleave and numa_node can't be used together"); }
+    if (numa_interleave) { all.weights.page_options.numa = VW::numa_mode::interleave; }
+    if (all.options->was_supplied("numa_node"))
+    {
+      if (numa_node_arg < 0) { THROW("numa_node can't be negative"); }
+      all.weights.page_options.numa = VW::numa_mode::bind;
+      all.weights.page_options.numa_node = numa_node_arg;
+    }
+    if (all.weights.sparse && !all.weights.page_options.is_default())
+    { THROW("huge_pages, numa_interleave and numa_node only apply to dense weights"); }
+
     std::string span_server_arg;
     int span_server_port_arg;
     // bool threads_arg;
     size_t unique_id_arg;
     size_t total_arg;
     size_t node_arg;
+    int learn_threads_arg;
     option_group_definition parallelization_args("Parallelization options");
     parallelization_args
         .add(make_option("span_server", span_server_arg).help("Location of server for setting up spanning tree"))
@@ -1467,9 +1545,17 @@ vw& parse_args(
         .add(make_option("node", node_arg).default_value(0).help("node number in cluster parallel job"))
         .add(make_option("span_server_port", span_server_port_arg)
                  .default_value(26543)
-                 .help("Port of the server for setting up spanning tree"));
+                 .help("Port of the server for setting up spanning tree"))
+        .add(make_option("learn_threads", learn_threads_arg)
+                 .default_value(1)
+                 .help("Number of threads that learn from parsed examples concurrently. The threads update the "
+                       "shared weights without locking (Hogwild), so results are not deterministic. Only plain "
+                       "gd with dense weights is supported."));
     all.options->add_and_parse(parallelization_args);
 
+    if (learn_threads_arg < 1) { THROW("learn_threads must be positive"); }
+    all.learn_threads = static_cast<size_t>(learn_threads_arg);
+
     // total, unique_id and node must be specified together.
     if ((all.options->was_supplied("total") || all.options->was_supplied("node") ||
             all.options->was_supplied("unique_id")) &&
@@ -1749,6 +1835,29 @@ void free_args(int argc, char* argv[])
   free(argv);
 }
 
+// Every reduction other than gd and the scorer keeps state across a learn call, so only that stack can be run from
+// several threads at once.
+void setup_learn_threads(vw& all)
+{
+  for (const auto& reduction : all.enabled_reductions)
+  {
+    if (reduction != "gd" && reduction != "scorer")
+    { THROW("learn_threads only supports gd, but the " << reduction << " reduction is enabled"); }
+  }
+  if (all.weights.sparse) THROW("learn_threads requires dense weights, it can't be used with --sparse_weights");
+  if (all.reg_mode != 0) THROW("learn_threads can't be used with --l1 or --l2");
+  if (all.daemon) THROW("learn_threads learns in batches, which would hold back daemon responses");
+
+  all.learn_pool = VW::make_unique<VW::thread_pool>(all.learn_threads);
+}
+
+void print_weight_pages(vw& all)
+{
+  const VW::page_region& pages = all.weights.dense_weights.pages();
+  if (!all.logger.quiet && !all.weights.page_options.is_default() && pages.data != nullptr)
+  { *(all.trace_message) << "Weight page size = " << VW::describe_page_size(pages) << std::endl; }
+}
+
 void print_enabled_reductions(vw& all)
 {
   // output list of enabled reductions
@@ -1812,6 +1921,9 @@ vw* initialize(std::unique_ptr<options_i, options_deleter_type> options, io_buf*
     }
 
     print_enabled_reductions(all);
+    print_weight_pages(all);
+
+    if (all.learn_threads > 1) { setup_learn_threads(all); }
 
     if (!all.options->get_typed_option<bool>("dry_run").value())
     {
@@ -19,6 +19,8 @@ struct input_options
   bool json;
   bool dsjson;
   bool kill_cache;
+  bool mapped_cache;
+  bool block_cache;
   bool compressed;
   bool chain_hash_json;
   bool flatbuffer = false;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 
 #include "global_data.h"
@@ -16,6 +17,8 @@ using dispatch_fptr = std::function<void(vw&, const v_array<example*>&)>;
 inline void parse_dispatch(vw& all, dispatch_fptr dispatch)
 {
   v_array<example*> examples;
+  v_array<example*> single_example;
+  single_example.push_back(nullptr);
   size_t example_number = 0;  // for variable-size batch learning algorithms
 
   try
@@ -23,12 +26,29 @@ inline void parse_dispatch(vw& all, dispatch_fptr dispatch)
     while (!all.example_parser->done)
     {
       examples.push_back(&VW::get_unused_example(&all));  // need at least 1 example
+      const size_t example_limit = std::min(all.pass_length, all.max_examples);
+      all.example_parser->max_examples_per_read = example_limit > example_number ? example_limit - example_number : 1;
       if (!all.do_reset_source && example_number != all.pass_length && all.max_examples > example_number &&
           all.example_parser->reader(&all, examples) > 0)
       {
-        VW::setup_examples(all, examples);
-        example_number += examples.size();
-        dispatch(all, examples);
+        if (all.example_parser->reader == &read_features_string_threaded)
+        {
+          // Every line of a batch is an independent example. Dispatch them one by one so that example counters and
+          // holdout assignment are the same as with serial parsing.
+          for (auto* ex : examples)
+          {
+            single_example[0] = ex;
+            VW::setup_example(all, ex);
+            dispatch(all, single_example);
+          }
+          example_number += examples.size();
+        }
+        else
+        {
+          VW::setup_examples(all, examples);
+          example_number += examples.size();
+          dispatch(all, examples);
+        }
       }
       else
       {
@@ -4,6 +4,8 @@
 
 #include <cmath>
 #include <cctype>
+#include <algorithm>
+#include <limits>
 #include "parse_example.h"
 #include "parse_primitives.h"
 #include "hash.h"
@@ -50,6 +52,53 @@ int read_features_string(vw* all, v_array<example*>& examples)
   return static_cast<int>(num_chars_initial);
 }
 
+int read_features_string_threaded(vw* all, v_array<example*>& examples)
+{
+  parser& p = *all->example_parser;
+  const size_t max_lines = std::max<size_t>(1, std::min(p.ring_size, p.max_examples_per_read));
+
+  // Lines handed out by io_buf are only valid until the next read, so the batch is copied into one scratch buffer.
+  p.batch_buffer.clear();
+  p.batch_lines.clear();
+  size_t total_chars = 0;
+  while (p.batch_lines.size() < max_lines)
+  {
+    char* line;
+    size_t num_chars;
+    size_t num_chars_initial = read_features(all, line, num_chars);
+    if (num_chars_initial < 1) { break; }
+    total_chars += num_chars_initial;
+    p.batch_lines.emplace_back(p.batch_buffer.size(), num_chars);
+    p.batch_buffer.insert(p.batch_buffer.end(), line, line + num_chars);
+  }
+
+  if (p.batch_lines.empty())
+  {
+    examples[0]->is_newline = true;
+    return 0;
+  }
+
+  while (examples.size() < p.batch_lines.size()) { examples.push_back(&VW::get_unused_example(all)); }
+
+  // Label parsers use scratch space and shared data owned by the parser, so labels are parsed serially. Only the
+  // feature portion of each line, which is where tokenizing and hashing happen, is fanned out to the pool.
+  p.batch_features.resize(p.batch_lines.size());
+  for (size_t i = 0; i < p.batch_lines.size(); ++i)
+  {
+    VW::string_view line(p.batch_buffer.data() + p.batch_lines[i].first, p.batch_lines[i].second);
+    p.batch_features[i] = substring_to_label(all, examples[i], line);
+  }
+
+  p.parse_pool->parallel_for_ranges(p.batch_lines.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (!p.batch_features[i].empty()) { substring_to_features(all, examples[i], p.batch_features[i]); }
+    }
+  });
+
+  return static_cast<int>(std::min<size_t>(total_chars, std::numeric_limits<int>::max()));
+}
+
 template <bool audit>
 class TC_parser
 {
@@ -66,6 +115,7 @@ public:
   bool _redefine_some;
   std::array<unsigned char, NUM_NAMESPACES>* _redefine;
   parser* _p;
+  VW::string_table* _names;
   example* _ae;
   std::array<uint64_t, NUM_NAMESPACES>* _affix_features;
   std::array<bool, NUM_NAMESPACES>* _spelling_features;
@@ -218,11 +268,11 @@ public:
         {
           std::stringstream ss;
           ss << feature_name << "^" << string_feature_value;
-          fs.space_names.push_back(audit_strings(_base.to_string(), ss.str()));
+          fs.space_names.push_back(audit_strings(_names->intern(_base), _names->intern(ss.str())));
         }
         else
         {
-          fs.space_names.push_back(audit_strings(_base.to_string(), feature_name.to_string()));
+          fs.space_names.push_back(audit_strings(_names->intern(_base), _names->intern(feature_name)));
         }
       }
 
@@ -257,7 +307,7 @@ public:
             affix_v.push_back('=');
             affix_v.insert(affix_v.end(), affix_name.begin(), affix_name.end());
             affix_v.push_back('\0');
-            affix_fs.space_names.push_back(audit_strings("affix", affix_v.begin()));
+            affix_fs.space_names.push_back(audit_strings(_names->intern("affix"), _names->intern(affix_v.begin())));
           }
           affix >>= 4;
         }
@@ -298,7 +348,7 @@ public:
           }
           spelling_v.insert(spelling_v.end(), spelling_strview.begin(), spelling_strview.end());
           spelling_v.push_back('\0');
-          spell_fs.space_names.push_back(audit_strings("spelling", spelling_v.begin()));
+          spell_fs.space_names.push_back(audit_strings(_names->intern("spelling"), _names->intern(spelling_v.begin())));
         }
       }
       if ((*_namespace_dictionaries)[_index].size() > 0)
@@ -324,7 +374,7 @@ public:
                 ss << _index << '_';
                 ss << feature_name;
                 ss << '=' << id;
-                dict_fs.space_names.push_back(audit_strings("dictionary", ss.str()));
+                dict_fs.space_names.push_back(audit_strings(_names->intern("dictionary"), _names->intern(ss.str())));
               }
           }
         }
@@ -455,6 +505,7 @@ public:
     {
       this->_read_idx = 0;
       this->_p = all.example_parser;
+      this->_names = &all.name_table;
       this->_redefine_some = all.redefine_some;
       this->_redefine = &all.redefine;
       this->_ae = ae;
@@ -472,7 +523,7 @@ public:
   }
 };
 
-void substring_to_example(vw* all, example* ae, VW::string_view example)
+VW::string_view substring_to_label(vw* all, example* ae, VW::string_view example)
 {
   if (example.empty()) { ae->is_newline = true; }
 
@@ -509,13 +560,22 @@ void substring_to_example(vw* all, example* ae, VW::string_view example)
     all->example_parser->lbl_parser.parse_label(all->example_parser, all->example_parser->_shared_data, &ae->l,
         all->example_parser->words, ae->_reduction_features);
 
-  if (bar_idx != VW::string_view::npos)
-  {
-    if (all->audit || all->hash_inv)
-      TC_parser<true> parser_line(example.substr(bar_idx), *all, ae);
-    else
-      TC_parser<false> parser_line(example.substr(bar_idx), *all, ae);
-  }
+  if (bar_idx == VW::string_view::npos) { return VW::string_view(); }
+  return example.substr(bar_idx);
+}
+
+void substring_to_features(vw* all, example* ae, VW::string_view features)
+{
+  if (all->audit || all->hash_inv)
+    TC_parser<true> parser_line(features, *all, ae);
+  else
+    TC_parser<false> parser_line(features, *all, ae);
+}
+
+void substring_to_example(vw* all, example* ae, VW::string_view example)
+{
+  VW::string_view features = substring_to_label(all, ae, example);
+  if (!features.empty()) { substring_to_features(all, ae, features); }
 }
 
 namespace VW
@@ -15,6 +15,12 @@ typedef enum
 } FeatureInputType;
 
 void substring_to_example(vw* all, example* ae, VW::string_view example);
+// Parses the label and tag of a text example and returns the remaining feature portion of the line, which is empty if
+// the line has no namespaces.
+VW::string_view substring_to_label(vw* all, example* ae, VW::string_view example);
+// Parses the feature portion of a text example. Only reads shared parser state so may be called concurrently for
+// different examples.
+void substring_to_features(vw* all, example* ae, VW::string_view features);
 
 namespace VW
 {
@@ -26,4 +32,6 @@ void read_lines(vw* all, const char* line, size_t len,
 }  // namespace VW
 
 int read_features_string(vw* all, v_array<example*>& examples);
+// Reads a batch of text lines and parses their features on the parser's thread pool. Used when --parse_threads > 1.
+int read_features_string_threaded(vw* all, v_array<example*>& examples);
 size_t read_features(vw* all, char*& line, size_t& num_chars);
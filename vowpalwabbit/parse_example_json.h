@@ -1524,10 +1524,11 @@ public:
     Namespace<audit> n;
     n.feature_group = ns[0];
     n.namespace_hash = VW::hash_space_cstr(*all, ns);
-    n.ftrs = ex->feature_space.data() + ns[0];
+    n.ftrs = &ex->feature_space[ns[0]];
     n.feature_count = 0;
 
     n.name = ns;
+    n.names = &all->name_table;
 
     namespace_path.push_back(n);
     return_path.push_back(return_state);
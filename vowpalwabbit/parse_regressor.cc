@@ -23,6 +23,8 @@
 #include "crossplat_compat.h"
 #include "rand48.h"
 #include "global_data.h"
+#include "delta_checkpoint.h"
+#include "vw.h"
 #include "vw_exception.h"
 #include "vw_validate.h"
 #include "vw_versions.h"
@@ -57,6 +59,16 @@ double calculate_sd(vw& /* all */, T& weights)
   double sq_sum = inner_product(diff.begin(), diff.end(), diff.begin(), 0.0);
   return std::sqrt(sq_sum / my_size);
 }
+void allocate_weights(vw&, sparse_parameters& weights, size_t length, uint32_t stride_shift)
+{
+  new (&weights) sparse_parameters(length, stride_shift);
+}
+
+void allocate_weights(vw& all, dense_parameters& weights, size_t length, uint32_t stride_shift)
+{
+  new (&weights) dense_parameters(length, stride_shift, all.weights.page_options);
+}
+
 template <class T>
 void initialize_regressor(vw& all, T& weights)
 {
@@ -68,7 +80,7 @@ void initialize_regressor(vw& all, T& weights)
   {
     uint32_t ss = weights.stride_shift();
     weights.~T();  // dealloc so that we can realloc, now with a known size
-    new (&weights) T(length, ss);
+    allocate_weights(all, weights, length, ss);
   }
   catch (const VW::vw_exception&)
   {
@@ -464,6 +476,8 @@ void dump_regressor(vw& all, io_buf& buf, bool as_text)
 
   buf.flush();  // close_file() should do this for me ...
   buf.close_file();
+
+  if (all.delta_checkpoints && !as_text) VW::reset_delta_baseline(all);
 }
 
 void dump_regressor(vw& all, std::string reg_name, bool as_text)
@@ -487,7 +501,11 @@ void save_predictor(vw& all, std::string reg_name, size_t current_pass)
   std::stringstream filename;
   filename << reg_name;
   if (all.save_per_pass) filename << "." << current_pass;
-  dump_regressor(all, filename.str(), false);
+  // Only the first checkpoint is a full model.
+  if (all.delta_checkpoints && !all.checkpoint_fingerprints.empty())
+    VW::save_delta(all, filename.str() + ".delta");
+  else
+    dump_regressor(all, filename.str(), false);
 }
 
 void finalize_regressor(vw& all, std::string reg_name)
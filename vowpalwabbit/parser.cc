@@ -50,6 +50,7 @@ int VW_getpid() { return (int)::GetCurrentProcessId(); }
 #include "parse_primitives.h"
 #include "parse_example.h"
 #include "cache.h"
+#include "mapped_cache.h"
 #include "unique_sort.h"
 #include "constant.h"
 #include "vw.h"
@@ -59,6 +60,7 @@ int VW_getpid() { return (int)::GetCurrentProcessId(); }
 #include "parse_dispatch_loop.h"
 #include "parse_args.h"
 #include "io/io_adapter.h"
+#include "scope_exit.h"
 #ifdef BUILD_FLATBUFFERS
 #  include "parser/flatbuffer/parse_example_flatbuffer.h"
 #endif
@@ -92,7 +94,7 @@ bool is_test_only(uint32_t counter, uint32_t period, uint32_t after, bool holdou
 
 void set_compressed(parser* /*par*/) {}
 
-uint32_t cache_numbits(io_buf* buf, VW::io::reader* filepointer)
+uint32_t cache_numbits(io_buf* buf, VW::io::reader* filepointer, char* cache_type = nullptr)
 {
   size_t v_length;
   buf->read_file(filepointer, reinterpret_cast<char*>(&v_length), sizeof(v_length));
@@ -111,7 +113,9 @@ uint32_t cache_numbits(io_buf* buf, VW::io::reader* filepointer)
   char temp;
   if (buf->read_file(filepointer, &temp, 1) < 1) THROW("failed to read");
 
-  if (temp != 'c') THROW("data file is not a cache file");
+  if (temp != VW::VARINT_CACHE_TYPE && temp != VW::BLOCK_CACHE_TYPE && temp != VW::MAPPED_CACHE_TYPE)
+    THROW("data file is not a cache file");
+  if (cache_type != nullptr) { *cache_type = temp; }
 
   uint32_t cache_numbits;
   if (buf->read_file(filepointer, &cache_numbits, sizeof(cache_numbits)) < static_cast<int>(sizeof(cache_numbits)))
@@ -122,9 +126,19 @@ uint32_t cache_numbits(io_buf* buf, VW::io::reader* filepointer)
 
 void set_cache_reader(vw& all) { all.example_parser->reader = read_cached_features; }
 
+void set_mapped_cache_reader(vw& all, const std::string& file_name)
+{
+  all.example_parser->mapped_cache = VW::make_unique<VW::mapped_cache_reader>(file_name);
+  all.example_parser->reader = read_mapped_cached_features;
+}
+
 void set_string_reader(vw& all)
 {
-  all.example_parser->reader = read_features_string;
+  // Daemon connections are interactive, so waiting to fill a batch of lines would stall the client.
+  if (all.example_parser->parse_pool != nullptr && !all.daemon)
+    all.example_parser->reader = read_features_string_threaded;
+  else
+    all.example_parser->reader = read_features_string;
   VW_WARNING_STATE_PUSH
   VW_WARNING_DISABLE_DEPRECATED_USAGE
   all.print = print_result;
@@ -195,6 +209,8 @@ void reset_source(vw& all, size_t numbits)
   // If in write cache mode then close all of the input files then open the written cache as the new input.
   if (all.example_parser->write_cache)
   {
+    if (all.example_parser->mapped_cache_writer != nullptr)
+    { all.example_parser->mapped_cache_writer->finish(*all.example_parser->output); }
     all.example_parser->output->flush();
     // Turn off write_cache as we are now reading it instead of writing!
     all.example_parser->write_cache = false;
@@ -209,8 +225,16 @@ void reset_source(vw& all, size_t numbits)
                                                                           << all.example_parser->finalname);
     input->close_files();
     // Now open the written cache as the new input file.
-    input->add_file(VW::io::open_file_reader(all.example_parser->finalname));
-    set_cache_reader(all);
+    if (all.example_parser->mapped_cache_writer != nullptr)
+    {
+      all.example_parser->mapped_cache_writer.reset();
+      set_mapped_cache_reader(all, all.example_parser->finalname);
+    }
+    else
+    {
+      input->add_file(VW::io::open_file_reader(all.example_parser->finalname));
+      set_cache_reader(all);
+    }
   }
 
   if (all.example_parser->resettable == true)
@@ -247,6 +271,10 @@ void reset_source(vw& all, size_t numbits)
 
       set_daemon_reader(all, is_currently_json_reader(all), is_currently_dsjson_reader(all));
     }
+    else if (all.example_parser->mapped_cache != nullptr)
+    {
+      all.example_parser->mapped_cache->seek(0);
+    }
     else
     {
       for (auto& file : input->get_input_files())
@@ -282,12 +310,20 @@ void make_write_cache(vw& all, std::string& newname, bool quiet)
 
   size_t v_length = static_cast<uint64_t>(VW::version.to_string().length()) + 1;
 
+  char cache_type = all.example_parser->block_cache ? VW::BLOCK_CACHE_TYPE : VW::VARINT_CACHE_TYPE;
+  if (all.example_parser->write_mapped_cache) { cache_type = VW::MAPPED_CACHE_TYPE; }
   output->bin_write_fixed(reinterpret_cast<const char*>(&v_length), sizeof(v_length));
   output->bin_write_fixed(VW::version.to_string().c_str(), v_length);
-  output->bin_write_fixed("c", 1);
+  output->bin_write_fixed(&cache_type, 1);
   output->bin_write_fixed(reinterpret_cast<const char*>(&all.num_bits), sizeof(all.num_bits));
   output->flush();
 
+  if (all.example_parser->write_mapped_cache)
+  {
+    all.example_parser->mapped_cache_writer = VW::make_unique<VW::mapped_cache_writer>(
+        sizeof(v_length) + v_length + sizeof(cache_type) + sizeof(all.num_bits));
+  }
+
   all.example_parser->finalname = newname;
   all.example_parser->write_cache = true;
   if (!quiet) *(all.trace_message) << "creating cache_file = " << newname << endl;
@@ -296,6 +332,7 @@ void make_write_cache(vw& all, std::string& newname, bool quiet)
 void parse_cache(vw& all, std::vector<std::string> cache_files, bool kill_cache, bool quiet)
 {
   all.example_parser->write_cache = false;
+  char stream_cache_type = 0;
 
   for (auto& file : cache_files)
   {
@@ -313,8 +350,9 @@ void parse_cache(vw& all, std::vector<std::string> cache_files, bool kill_cache,
       make_write_cache(all, file, quiet);
     else
     {
-      uint64_t c =
-          cache_numbits(all.example_parser->input.get(), all.example_parser->input->get_input_files().back().get());
+      char cache_type = VW::VARINT_CACHE_TYPE;
+      uint64_t c = cache_numbits(
+          all.example_parser->input.get(), all.example_parser->input->get_input_files().back().get(), &cache_type);
       if (c < all.num_bits)
       {
         if (!quiet)
@@ -326,7 +364,22 @@ void parse_cache(vw& all, std::vector<std::string> cache_files, bool kill_cache,
       else
       {
         if (!quiet) *(all.trace_message) << "using cache_file = " << file.c_str() << endl;
-        set_cache_reader(all);
+        if (cache_type == VW::MAPPED_CACHE_TYPE)
+        {
+          if (cache_files.size() > 1) THROW("a mapped cache file can't be combined with other cache files");
+          // Mapped caches are read straight from the mapping rather than through the input io_buf.
+          all.example_parser->input->close_file();
+          set_mapped_cache_reader(all, file);
+        }
+        else
+        {
+          // Cache files are read back to back through one io_buf, so they have to share a codec.
+          if (stream_cache_type != 0 && stream_cache_type != cache_type)
+            THROW("cache files written with different codecs can't be combined");
+          stream_cache_type = cache_type;
+          all.example_parser->block_cache = cache_type == VW::BLOCK_CACHE_TYPE;
+          set_cache_reader(all);
+        }
         if (c == all.num_bits)
           all.example_parser->sorted_cache = true;
         else
@@ -351,6 +404,8 @@ void parse_cache(vw& all, std::vector<std::string> cache_files, bool kill_cache,
 void enable_sources(vw& all, bool quiet, size_t passes, input_options& input_options)
 {
   all.example_parser->input->current = 0;
+  all.example_parser->write_mapped_cache = input_options.mapped_cache;
+  all.example_parser->block_cache = input_options.block_cache;
   parse_cache(all, input_options.cache_files, input_options.kill_cache, quiet);
 
   // default text reader
@@ -540,7 +595,7 @@ void enable_sources(vw& all, bool quiet, size_t passes, input_options& input_opt
   }
   else
   {
-    if (all.example_parser->input->num_files() != 0)
+    if (all.example_parser->input->num_files() != 0 || all.example_parser->mapped_cache != nullptr)
     {
       if (!quiet) *(all.trace_message) << "ignoring text input in favor of cache input" << endl;
     }
@@ -677,14 +732,24 @@ void setup_example(vw& all, example* ae)
   if (all.example_parser->sort_features && ae->sorted == false) unique_sort_features(all.parse_mask, ae);
 
   if (all.example_parser->write_cache)
-  { VW::write_example_to_cache(*all.example_parser->output, ae, all.example_parser->lbl_parser, all.parse_mask); }
+  {
+    if (all.example_parser->mapped_cache_writer != nullptr)
+    {
+      all.example_parser->mapped_cache_writer->write_example(
+          *all.example_parser->output, *ae, all.example_parser->lbl_parser, all.parse_mask);
+    }
+    else
+    {
+      VW::write_example_to_cache(*all.example_parser->output, ae, all.example_parser->lbl_parser, all.parse_mask,
+          all.example_parser->block_cache);
+    }
+  }
 
   ae->partial_prediction = 0.;
   ae->num_features = 0;
   ae->reset_total_sum_feat_sq();
   ae->loss = 0.;
   ae->_debug_current_reduction_depth = 0;
-  ae->use_permutations = all.permutations;
 
   ae->example_counter = static_cast<size_t>(all.example_parser->end_parsed_examples.load());
   if (!all.example_parser->emptylines_separate_examples) all.example_parser->in_pass_counter++;
@@ -702,6 +767,13 @@ void setup_example(vw& all, example* ae)
 
   ae->weight = all.example_parser->lbl_parser.get_weight(&ae->l, ae->_reduction_features);
 
+  setup_example_features(all, ae);
+}
+
+void setup_example_features(vw& all, example* ae)
+{
+  ae->use_permutations = all.permutations;
+
   if (all.ignore_some)
   {
     for (unsigned char* i = ae->indices.begin(); i != ae->indices.end(); i++)
@@ -718,7 +790,7 @@ void setup_example(vw& all, example* ae)
     }
   }
 
-  if (all.skip_gram_transformer != nullptr) { all.skip_gram_transformer->generate_grams(ae); }
+  if (all.skip_gram_transformer != nullptr) { all.skip_gram_transformer->generate_grams(ae, all.name_table); }
 
   if (all.add_constant)  // add constant feature
     VW::add_constant_feature(all, ae);
@@ -730,6 +802,10 @@ void setup_example(vw& all, example* ae)
   if (multiplier != 1)  // make room for per-feature information.
     for (features& fs : *ae)
       for (auto& j : fs.indicies) j *= multiplier;
+
+  // A recycled example usually has all of its feature groups in its block already, then this only checks them.
+  ae->feature_space.pack();
+
   ae->num_features = 0;
   for (const features& fs : *ae)
   {
@@ -764,13 +840,86 @@ example* read_example(vw& all, const char* example_line)
 
 example* read_example(vw& all, const std::string& example_line) { return read_example(all, example_line.c_str()); }
 
+void clean_example(vw& all, example& ec, bool rewind);
+
+namespace
+{
+void check_batch_learner(vw& all)
+{
+  if (all.l->is_multiline) THROW("predict_batch does not support multi-line examples.");
+  if (all.l->pred_type != prediction_type_t::scalar && all.l->pred_type != prediction_type_t::prob &&
+      all.l->pred_type != prediction_type_t::multiclass)
+    THROW("predict_batch needs a scalar, prob or multiclass prediction, not " << ::to_string(all.l->pred_type));
+}
+
+float predict_one(vw& all, example& ec)
+{
+  // The example may belong to the caller, so it is left as it was found.
+  const bool test_only = ec.test_only;
+  auto restore_guard = VW::scope_exit([&ec, test_only] { ec.test_only = test_only; });
+  ec.test_only = true;
+  VW::LEARNER::as_singleline(all.l)->predict(ec);
+  return all.l->pred_type == prediction_type_t::multiclass ? static_cast<float>(ec.pred.multiclass) : ec.pred.scalar;
+}
+
+// The part of setup_example a prediction needs. The rest belongs to a pass over the data: the example isn't written to
+// the cache and the pass counter, which the holdout set is chosen by, doesn't move.
+void setup_batch_example(vw& all, example& ec)
+{
+  if (all.example_parser->sort_features && !ec.sorted) { unique_sort_features(all.parse_mask, &ec); }
+  ec.partial_prediction = 0.;
+  ec.reset_total_sum_feat_sq();
+  ec.loss = 0.;
+  ec._debug_current_reduction_depth = 0;
+  ec.weight = all.example_parser->lbl_parser.get_weight(&ec.l, ec._reduction_features);
+  setup_example_features(all, &ec);
+}
+}  // namespace
+
+void predict_batch(vw& all, example* const* examples, size_t count, float* predictions)
+{
+  check_batch_learner(all);
+  for (size_t i = 0; i < count; i++) { predictions[i] = predict_one(all, *examples[i]); }
+}
+
+size_t predict_batch(vw& all, const char* lines, size_t length, float* predictions, size_t max_predictions,
+    size_t* consumed, size_t* written)
+{
+  if (consumed != nullptr) { *consumed = 0; }
+  if (written != nullptr) { *written = 0; }
+  check_batch_learner(all);
+  // One example from the pool is parsed into for every line, so its feature storage is only grown, never freed.
+  example* ec = &get_unused_example(&all);
+  auto release_guard = VW::scope_exit([&all, ec] { clean_example(all, *ec, true); });
+
+  size_t count = 0;
+  VW::string_view remaining(lines, length);
+  while (!remaining.empty() && count < max_predictions)
+  {
+    const size_t end = remaining.find('\n');
+    const VW::string_view line = remaining.substr(0, end);
+    remaining.remove_prefix(end == VW::string_view::npos ? remaining.size() : end + 1);
+
+    empty_example(all, *ec);
+    substring_to_example(&all, ec, line);
+    setup_batch_example(all, *ec);
+    predictions[count++] = predict_one(all, *ec);
+    if (consumed != nullptr) { *consumed = length - remaining.size(); }
+    if (written != nullptr) { *written = count; }
+  }
+  return count;
+}
+
 void add_constant_feature(vw& vw, example* ec)
 {
   ec->indices.push_back(constant_namespace);
   ec->feature_space[constant_namespace].push_back(1, constant);
   ec->num_features++;
   if (vw.audit || vw.hash_inv)
-    ec->feature_space[constant_namespace].space_names.push_back(audit_strings("", "Constant"));
+  {
+    ec->feature_space[constant_namespace].space_names.push_back(
+        audit_strings(VW::interned_string(), vw.name_table.intern("Constant")));
+  }
 }
 
 void add_label(example* ec, float label, float weight, float base)
@@ -24,9 +24,12 @@
 #include <memory>
 #include "vw_string_view.h"
 #include "queue.h"
+#include "lock_free_queue.h"
 #include "object_pool.h"
 #include "hashstring.h"
+#include "mapped_cache.h"
 #include "simple_label_parser.h"
+#include "thread_pool.h"
 
 struct vw;
 struct input_options;
@@ -54,8 +57,21 @@ struct parser
   // helper(s) for text parsing
   std::vector<VW::string_view> words;
 
+  // helper(s) for multi-threaded text parsing
+  size_t parse_threads = 1;
+  std::unique_ptr<VW::thread_pool> parse_pool;
+  std::vector<char> batch_buffer;
+  std::vector<std::pair<size_t, size_t>> batch_lines;  // (offset, length) into batch_buffer
+  std::vector<VW::string_view> batch_features;
+  size_t max_examples_per_read = 1;  // set by the parse loop so batching readers honor --examples
+
+#ifdef VW_LOCK_FREE_QUEUES
+  VW::lock_free_object_pool<example> example_pool;
+  VW::lock_free_ptr_queue<example> ready_parsed_examples;
+#else
   VW::object_pool<example> example_pool;
   VW::ptr_queue<example> ready_parsed_examples;
+#endif
 
   std::unique_ptr<io_buf> input;  // Input source(s)
   /// reader consumes the input io_buf in the vw object and is generally for file based parsing
@@ -72,8 +88,12 @@ struct parser
   std::string finalname;
 
   bool write_cache = false;
+  bool write_mapped_cache = false;  // create new caches in the memory mappable layout
+  bool block_cache = false;         // cache records use the block codec instead of per feature varints
   bool sort_features = false;
   bool sorted_cache = false;
+  std::unique_ptr<VW::mapped_cache_writer> mapped_cache_writer;  // set while a mapped cache is being written
+  std::unique_ptr<VW::mapped_cache_reader> mapped_cache;         // set when reading from a mapped cache
 
   const size_t ring_size;
   std::atomic<uint64_t> begin_parsed_examples;  // The index of the beginning parsed example.
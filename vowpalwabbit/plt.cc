@@ -48,8 +48,10 @@ struct plt
   // for prediction
   float threshold;
   uint32_t top_k;
+  uint32_t beam_width;                     // 0 for the exact top-k search
   std::vector<polyprediction> node_preds;  // for storing results of base.multipredict
   std::vector<node> node_queue;        // container for queue used for both types of predictions
+  std::vector<node> beam_candidates;   // children of the beam in beam search
 
   // for measuring predictive performance
   std::unordered_set<uint32_t> true_labels;
@@ -149,6 +151,66 @@ inline float predict_node(uint32_t n, single_learner& base, example& ec)
   return 1.0f / (1.0f + std::exp(-ec.partial_prediction));
 }
 
+// Orders the nodes by decreasing probability, ties by node number.
+inline bool more_probable(const node& a, const node& b) { return a.p > b.p || (a.p == b.p && a.n < b.n); }
+
+// Top-k prediction with a beam of beam_width nodes, expanded one tree level at a time. All children of the internal
+// nodes of the beam are scored, then the beam_width most probable children and leaves of the beam form the next one.
+// The children of consecutive nodes are consecutive too, so each run of consecutive nodes in the beam is scored with
+// a single multipredict. Unlike the best-first search this scores at most beam_width * kary nodes per level, but it
+// can miss labels whose ancestors fall out of the beam.
+void predict_beam(plt& p, single_learner& base, example& ec, v_array<uint32_t>& labels)
+{
+  p.node_queue.clear();  // here queue is used as the beam
+  p.node_queue.push_back({0, predict_node(0, base, ec)});
+  ec.l.simple = {FLT_MAX};
+  ec._reduction_features.template get<simple_label_reduction_features>().reset_to_default();
+
+  bool expanded = true;
+  while (expanded)
+  {
+    expanded = false;
+    p.beam_candidates.clear();
+    std::sort(p.node_queue.begin(), p.node_queue.end(), [](const node& a, const node& b) { return a.n < b.n; });
+    for (size_t i = 0; i < p.node_queue.size();)
+    {
+      if (p.node_queue[i].n >= p.ti)
+      {
+        p.beam_candidates.push_back(p.node_queue[i++]);
+        continue;
+      }
+
+      size_t end = i + 1;
+      while (end < p.node_queue.size() && p.node_queue[end].n == p.node_queue[end - 1].n + 1 &&
+          p.node_queue[end].n < p.ti)
+      { ++end; }
+
+      const uint32_t first_child = p.kary * p.node_queue[i].n + 1;
+      const uint32_t count = p.kary * static_cast<uint32_t>(end - i);
+      base.multipredict(ec, first_child, count, p.node_preds.data(), false);
+      for (uint32_t c = 0; c < count && first_child + c < p.t; ++c)
+      {
+        const float cp_child = p.node_queue[i + c / p.kary].p * (1.f / (1.f + std::exp(-p.node_preds[c].scalar)));
+        p.beam_candidates.push_back({first_child + c, cp_child});
+      }
+      expanded = true;
+      i = end;
+    }
+
+    if (p.beam_candidates.size() > p.beam_width)
+    {
+      std::nth_element(p.beam_candidates.begin(), p.beam_candidates.begin() + p.beam_width,
+          p.beam_candidates.end(), more_probable);
+      p.beam_candidates.resize(p.beam_width);
+    }
+    std::swap(p.node_queue, p.beam_candidates);
+  }
+
+  std::sort(p.node_queue.begin(), p.node_queue.end(), more_probable);
+  for (size_t i = 0; i < p.node_queue.size() && labels.size() < p.top_k; ++i)
+  { labels.push_back(p.node_queue[i].n - p.ti); }
+}
+
 template <bool threshold>
 void predict(plt& p, single_learner& base, example& ec)
 {
@@ -215,6 +277,19 @@ void predict(plt& p, single_learner& base, example& ec)
   }
 
   // top-k prediction
+  else if (p.beam_width > 0)
+  {
+    predict_beam(p, base, ec, preds.label_v);
+    if (p.true_labels.size() > 0)
+    {
+      for (size_t i = 0; i < preds.label_v.size(); ++i)
+      {
+        if (p.true_labels.count(preds.label_v[i])) ++p.tp_at[i];
+      }
+      ++p.ec_count;
+      p.true_count += static_cast<uint32_t>(p.true_labels.size());
+    }
+  }
   else
   {
     p.node_queue.push_back({0, predict_node(0, base, ec)});  // here queue is used as priority queue
@@ -333,12 +408,22 @@ base_learner* plt_setup(options_i& options, vw& all)
                .help("predict labels with conditional marginal probability greater than <thr> threshold"))
       .add(make_option("top_k", tree->top_k)
                .default_value(0)
-               .help("predict top-<k> labels instead of labels above threshold"));
+               .help("predict top-<k> labels instead of labels above threshold"))
+      .add(make_option("beam_width", tree->beam_width)
+               .default_value(0)
+               .help("predict the top-<k> labels with a beam search that keeps <w> nodes per tree level, instead of "
+                     "the exact search"));
 
   if (!options.add_parse_and_check_necessary(new_options)) return nullptr;
 
   tree->all = &all;
 
+  if (tree->beam_width > 0)
+  {
+    if (tree->top_k == 0) THROW("beam_width requires --top_k");
+    if (tree->beam_width < tree->top_k) THROW("beam_width must be at least top_k, it is " << tree->beam_width);
+  }
+
   // calculate number of tree nodes
   const double a = std::pow(tree->kary, std::floor(std::log(tree->k) / std::log(tree->kary)));
   const double b = tree->k - a;
@@ -353,7 +438,11 @@ base_learner* plt_setup(options_i& options, vw& all)
     *(all.trace_message) << "PLT k = " << tree->k << "\nkary_tree = " << tree->kary << std::endl;
     if (!all.training)
     {
-      if (tree->top_k > 0) { *(all.trace_message) << "top_k = " << tree->top_k << std::endl; }
+      if (tree->top_k > 0)
+      {
+        *(all.trace_message) << "top_k = " << tree->top_k << std::endl;
+        if (tree->beam_width > 0) { *(all.trace_message) << "beam_width = " << tree->beam_width << std::endl; }
+      }
       else
       {
         *(all.trace_message) << "threshold = " << tree->threshold << std::endl;
@@ -364,7 +453,7 @@ base_learner* plt_setup(options_i& options, vw& all)
   // resize v_arrays
   tree->nodes_time.resize_but_with_stl_behavior(tree->t);
   std::fill(tree->nodes_time.begin(), tree->nodes_time.end(), all.initial_t);
-  tree->node_preds.resize(tree->kary);
+  tree->node_preds.resize(static_cast<size_t>(tree->kary) * std::max<uint32_t>(tree->beam_width, 1));
   if (tree->top_k > 0) tree->tp_at.resize_but_with_stl_behavior(tree->top_k);
 
   learner<plt, example>* l;
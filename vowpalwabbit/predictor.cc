@@ -0,0 +1,55 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "predictor.h"
+
+#include <cfloat>
+
+#include "learner.h"
+#include "parse_example.h"
+#include "unique_sort.h"
+#include "vw.h"
+#include "vw_exception.h"
+
+VW::predictor::predictor(vw& all) : _all(all)
+{
+  // gd and the scorer only read their state when predicting, like for --learn_threads.
+  for (const auto& reduction : all.enabled_reductions)
+  {
+    if (reduction != "gd" && reduction != "scorer")
+    { THROW("predictor only supports gd, but the " << reduction << " reduction is enabled"); }
+  }
+  // A lookup in sparse weights inserts the missing weight.
+  if (all.weights.sparse) THROW("predictor requires dense weights, it can't be used with --sparse_weights");
+  if (all.audit || all.hash_inv) THROW("predictor can't be used with audit or invert_hash");
+  // The ngram generator keeps its scratch state in the vw.
+  if (all.skip_gram_transformer != nullptr) THROW("predictor can't be used with --ngram or --skips");
+}
+
+float VW::predictor::predict(VW::string_view line, scratch& scratch) const
+{
+  example& ec = scratch._ec;
+  VW::empty_example(_all, ec);
+  ec.l.simple = label_data{FLT_MAX};
+  ec.weight = 1.f;
+
+  // Only the feature parser can run concurrently, the label parser keeps its tokens in the vw.
+  const size_t bar_idx = line.find('|');
+  if (bar_idx != VW::string_view::npos) { substring_to_features(&_all, &ec, line.substr(bar_idx)); }
+  if (_all.example_parser->sort_features) { unique_sort_features(_all.parse_mask, &ec); }
+
+  ec.partial_prediction = 0.f;
+  ec.loss = 0.f;
+  ec.reset_total_sum_feat_sq();
+  ec._debug_current_reduction_depth = 0;
+  VW::setup_example_features(_all, &ec);
+  return predict(ec);
+}
+
+float VW::predictor::predict(example& ec) const
+{
+  ec.test_only = true;
+  VW::LEARNER::as_singleline(_all.l)->predict(ec);
+  return ec.pred.scalar;
+}
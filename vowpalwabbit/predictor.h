@@ -0,0 +1,46 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include "example.h"
+#include "vw_string_view.h"
+
+struct vw;
+
+namespace VW
+{
+/// Predicts with a trained model from any number of threads at once, without locks and without a vw per thread.
+/// The predictor reads the weights, the shared data and the options of the vw it is built from, which must outlive it
+/// and must not learn or load a model while predictions run. Only gd with the scorer and dense weights is supported.
+class predictor
+{
+public:
+  /// Per thread state for parsing text. Every thread that predicts text needs its own, which it reuses across calls.
+  class scratch
+  {
+  public:
+    scratch() = default;
+    scratch(const scratch&) = delete;
+    scratch& operator=(const scratch&) = delete;
+
+  private:
+    friend class predictor;
+    example _ec;
+  };
+
+  /// Throws if the reductions, weights or parse options of all can't be used from several threads.
+  explicit predictor(vw& all);
+
+  /// Predicts one line in the text format. The label and tag are ignored.
+  float predict(VW::string_view line, scratch& scratch) const;
+
+  /// Predicts an example that went through setup_example, like the ones from read_example. The example must not be
+  /// used by another thread at the same time.
+  float predict(example& ec) const;
+
+private:
+  vw& _all;
+};
+}  // namespace VW
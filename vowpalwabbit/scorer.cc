@@ -55,6 +55,13 @@ void update(scorer& s, VW::LEARNER::single_learner& base, example& ec)
              << ", loss=" << ec.loss << std::endl;
 }
 
+void multiupdate(scorer& s, VW::LEARNER::single_learner& base, example& ec, size_t count, size_t, polyprediction* pred,
+    const float* labels)
+{
+  for (size_t c = 0; c < count; c++) s.all->set_minmax(s.all->sd, labels[c]);
+  base.multiupdate(ec, 0, count, pred, labels);
+}
+
 // y = f(x) -> [0, 1]
 inline float logistic(float in) { return 1.f / (1.f + correctedExp(-in)); }
 
@@ -112,6 +119,7 @@ VW::LEARNER::base_learner* scorer_setup(options_i& options, vw& all)
 
   l->set_multipredict(multipredict_f);
   l->set_update(update);
+  l->set_multiupdate(multiupdate);
   all.scorer = VW::LEARNER::as_singleline(l);
 
   return make_base(*all.scorer);
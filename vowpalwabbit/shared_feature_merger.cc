@@ -12,6 +12,7 @@
 #include "vw.h"
 #include "scope_exit.h"
 
+#include <algorithm>
 #include <iterator>
 
 namespace VW
@@ -23,6 +24,13 @@ static const std::vector<std::string> option_strings = {
 
 label_type_t label_type = label_type_t::cb;
 
+// The reductions that may run below --cache_shared_context. gd finds the shared features through the shared_context of
+// an action, so every reduction below must leave the features of the actions to gd.
+static const std::vector<std::string> shared_context_reductions = {"gd", "scorer", "csoaa_ldf", "cb_adf",
+    "cb_explore_adf_greedy", "cb_explore_adf_softmax", "cb_explore_adf_first", "cb_explore_adf_bag",
+    "cb_explore_adf_cover", "cb_explore_adf_regcb", "cb_explore_adf_squarecb", "cb_explore_adf_synthcover", "cb_dro",
+    "cb_sample", "explore_eval"};
+
 bool use_reduction(config::options_i& options)
 {
   for (const auto& opt : option_strings)
@@ -40,8 +48,56 @@ struct sfm_metrics
 struct sfm_data
 {
   std::unique_ptr<sfm_metrics> _metrics;
+  bool cache_shared_context = false;
 };
 
+// An action that has a namespace of the shared example would get both sets of features concatenated by a merge.
+bool overlaps(const multi_ex& ec_seq, const example& shared)
+{
+  for (const auto* example : ec_seq)
+  {
+    for (namespace_index ns : example->indices)
+    {
+      if (ns != constant_namespace && example->feature_space[ns].nonempty() && shared.feature_space[ns].nonempty())
+      { return true; }
+    }
+  }
+  return false;
+}
+
+size_t shared_num_features(const example& shared)
+{
+  size_t num_features = 0;
+  for (namespace_index ns : shared.indices)
+  {
+    if (ns != constant_namespace) { num_features += shared.feature_space[ns].size(); }
+  }
+  return num_features;
+}
+
+// Instead of merging, gd looks the shared namespaces up through the shared_context of each action.
+void attach_shared_context(multi_ex& ec_seq, example& shared)
+{
+  const size_t num_features = shared_num_features(shared);
+  shared.shared_context_scores.clear();
+  for (auto* example : ec_seq)
+  {
+    example->shared_context = &shared;
+    example->num_features += num_features;
+  }
+}
+
+void detach_shared_context(multi_ex& ec_seq, example& shared)
+{
+  const size_t num_features = shared_num_features(shared);
+  shared.shared_context_scores.clear();
+  for (auto* example : ec_seq)
+  {
+    example->shared_context = nullptr;
+    example->num_features -= num_features;
+  }
+}
+
 template <bool is_learn>
 void predict_or_learn(sfm_data& data, VW::LEARNER::multi_learner& base, multi_ex& ec_seq)
 {
@@ -50,22 +106,32 @@ void predict_or_learn(sfm_data& data, VW::LEARNER::multi_learner& base, multi_ex
   multi_ex::value_type shared_example = nullptr;
 
   const bool has_example_header = VW::LEARNER::ec_is_example_header(*ec_seq[0], label_type);
+  bool use_shared_context = false;
 
   if (has_example_header)
   {
     shared_example = ec_seq[0];
     ec_seq.erase(ec_seq.begin());
+    use_shared_context = data.cache_shared_context && !overlaps(ec_seq, *shared_example);
     // merge sequences
-    for (auto& example : ec_seq) LabelDict::add_example_namespaces_from_example(*example, *shared_example);
+    if (use_shared_context) { attach_shared_context(ec_seq, *shared_example); }
+    else
+    {
+      for (auto& example : ec_seq) LabelDict::add_example_namespaces_from_example(*example, *shared_example);
+    }
     std::swap(ec_seq[0]->pred, shared_example->pred);
     std::swap(ec_seq[0]->tag, shared_example->tag);
   }
 
   // Guard example state restore against throws
-  auto restore_guard = VW::scope_exit([has_example_header, &shared_example, &ec_seq] {
+  auto restore_guard = VW::scope_exit([has_example_header, use_shared_context, &shared_example, &ec_seq] {
     if (has_example_header)
     {
-      for (auto& example : ec_seq) LabelDict::del_example_namespaces_from_example(*example, *shared_example);
+      if (use_shared_context) { detach_shared_context(ec_seq, *shared_example); }
+      else
+      {
+        for (auto& example : ec_seq) LabelDict::del_example_namespaces_from_example(*example, *shared_example);
+      }
       std::swap(shared_example->pred, ec_seq[0]->pred);
       std::swap(shared_example->tag, ec_seq[0]->tag);
       ec_seq.insert(ec_seq.begin(), shared_example);
@@ -95,14 +161,38 @@ void persist(sfm_data& data, metric_sink& metrics)
 
 VW::LEARNER::base_learner* shared_feature_merger_setup(config::options_i& options, vw& all)
 {
+  bool cache_shared_context = false;
+  config::option_group_definition new_options("Shared Feature Merger");
+  new_options.add(config::make_option("cache_shared_context", cache_shared_context)
+                      .help("Score the features of the shared example once per multi-example instead of merging them "
+                            "into every action. Requires an adaptive or normalized update when learning"));
+  options.add_and_parse(new_options);
+
   if (!use_reduction(options)) return nullptr;
 
   auto data = scoped_calloc_or_throw<sfm_data>();
+  data->cache_shared_context = cache_shared_context;
 
   if (options.was_supplied("extra_metrics")) data->_metrics = VW::make_unique<sfm_metrics>();
 
   auto* base = VW::LEARNER::as_multiline(setup_base(options, all));
 
+  if (cache_shared_context)
+  {
+    for (const auto& name : all.enabled_reductions)
+    {
+      if (std::find(shared_context_reductions.begin(), shared_context_reductions.end(), name) ==
+          shared_context_reductions.end())
+      { THROW("cache_shared_context cannot be used with " << name); }
+    }
+    if (options.was_supplied("wap_ldf")) THROW("cache_shared_context cannot be used with wap_ldf");
+    if (all.audit || all.hash_inv) THROW("cache_shared_context cannot be used with audit or invert_hash");
+    // The plain sgd update scales by the sum of the squared features of an action, which is not kept for the
+    // features of the shared example.
+    if (all.training && !all.weights.adaptive && !all.weights.normalized)
+      THROW("cache_shared_context requires an adaptive or normalized update when learning");
+  }
+
   auto& learner = VW::LEARNER::init_learner(data, base, predict_or_learn<true>, predict_or_learn<false>,
       all.get_setupfn_name(shared_feature_merger_setup), base->learn_returns_prediction);
 
@@ -0,0 +1,90 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "sparse_dot.h"
+
+#include "cpu_features.h"
+
+#if defined(VW_HAVE_X86_DISPATCH)
+#  include <immintrin.h>
+#endif
+
+#if defined(VW_HAVE_X86_DISPATCH)
+namespace
+{
+// Written with intrinsics so that the compiler doesn't contract it into an fma, which would round differently than
+// the scalar merge.
+VW_TARGET_AVX2 inline float add_product_avx2(float dot, float x1, float x2)
+{
+  return _mm_cvtss_f32(_mm_add_ss(_mm_set_ss(dot), _mm_mul_ss(_mm_set_ss(x1), _mm_set_ss(x2))));
+}
+
+VW_TARGET_AVX2 inline int lane_mask_avx2(__m256i eq) { return _mm256_movemask_pd(_mm256_castsi256_pd(eq)); }
+
+// Compares a block of 4 indices of each list, all 16 pairs at once through the rotations of the second block, then
+// moves past the block with the smaller last index. Every common index is found when the two blocks holding it meet,
+// and blocks meet in increasing index order.
+VW_TARGET_AVX2 float sparse_dot_avx2(
+    const uint64_t* idx1, const float* v1, size_t n1, const uint64_t* idx2, const float* v2, size_t n2, float dot)
+{
+  size_t i = 0;
+  size_t j = 0;
+  while (i + 4 <= n1 && j + 4 <= n2)
+  {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx1 + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx2 + j));
+    // Lane k of rotation r compares a[k] with b[(k + r) % 4].
+    const __m256i eq0 = _mm256_cmpeq_epi64(a, b);
+    const __m256i eq1 = _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, 0x39));
+    const __m256i eq2 = _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, 0x4e));
+    const __m256i eq3 = _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, 0x93));
+    const int matched = lane_mask_avx2(_mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3)));
+    if (matched != 0)
+    {
+      const int rotated1 = lane_mask_avx2(eq1);
+      const int rotated2 = lane_mask_avx2(eq2);
+      const int rotated3 = lane_mask_avx2(eq3);
+      for (size_t k = 0; k < 4; ++k)
+      {
+        if ((matched >> k & 1) == 0) { continue; }
+        const size_t r = (rotated1 >> k & 1) ? 1 : (rotated2 >> k & 1) ? 2 : (rotated3 >> k & 1) ? 3 : 0;
+        dot = add_product_avx2(dot, v1[i + k], v2[j + ((k + r) & 3)]);
+      }
+    }
+
+    const uint64_t last1 = idx1[i + 3];
+    const uint64_t last2 = idx2[j + 3];
+    if (last1 <= last2) { i += 4; }
+    if (last2 <= last1) { j += 4; }
+  }
+
+  while (i < n1 && j < n2)
+  {
+    if (idx1[i] < idx2[j]) { ++i; }
+    else if (idx2[j] < idx1[i])
+    {
+      ++j;
+    }
+    else
+    {
+      dot = add_product_avx2(dot, v1[i++], v2[j++]);
+    }
+  }
+  return dot;
+}
+}  // namespace
+#endif
+
+bool VW::sparse_dot(
+    const uint64_t* idx1, const float* v1, size_t n1, const uint64_t* idx2, const float* v2, size_t n2, float& dot)
+{
+#if defined(VW_HAVE_X86_DISPATCH)
+  if (VW::get_cpu_features().avx2)
+  {
+    dot = sparse_dot_avx2(idx1, v1, n1, idx2, v2, n2, dot);
+    return true;
+  }
+#endif
+  return false;
+}
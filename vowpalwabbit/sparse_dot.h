@@ -0,0 +1,19 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized dot product of two sparse vectors, each given as strictly increasing indices with their values, e.g. the
+// features of two flat examples after flatten_sort_example. The instruction set is chosen at runtime.
+namespace VW
+{
+/// dot += v1[i] * v2[j] for every pair with idx1[i] == idx2[j], added in increasing index order like a scalar merge,
+/// so the result is the same bit for bit. Returns false without touching dot when there is no vectorized
+/// implementation for this machine, in which case the caller falls back to its merge loop.
+bool sparse_dot(const uint64_t* idx1, const float* v1, size_t n1, const uint64_t* idx2, const float* v2, size_t n2,
+    float& dot);
+}  // namespace VW
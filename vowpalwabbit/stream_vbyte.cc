@@ -0,0 +1,149 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#include "stream_vbyte.h"
+
+#include <cstring>
+
+#include "cpu_features.h"
+
+#if defined(VW_HAVE_X86_DISPATCH)
+#  include <immintrin.h>
+#endif
+
+namespace
+{
+inline uint8_t length_code(uint32_t value)
+{
+  if (value < (1u << 8)) { return 0; }
+  if (value < (1u << 16)) { return 1; }
+  if (value < (1u << 24)) { return 2; }
+  return 3;
+}
+
+// Decodes values [begin, count) one at a time.
+const char* decode_values(
+    const uint8_t* control, const char* data, const char* end, size_t begin, size_t count, uint32_t* out)
+{
+  for (size_t i = begin; i < count; ++i)
+  {
+    const size_t length = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+    if (data + length > end) { return nullptr; }
+    uint32_t value = 0;
+    for (size_t b = 0; b < length; ++b) { value |= static_cast<uint32_t>(static_cast<uint8_t>(data[b])) << (8 * b); }
+    out[i] = value;
+    data += length;
+  }
+  return data;
+}
+
+#if defined(VW_HAVE_X86_DISPATCH)
+// For every control byte, the pshufb mask that spreads its four values to 32 bit lanes and the number of data bytes
+// it covers.
+struct shuffle_tables
+{
+  uint8_t shuffle[256][16];
+  uint8_t length[256];
+
+  shuffle_tables()
+  {
+    for (size_t control = 0; control < 256; ++control)
+    {
+      uint8_t offset = 0;
+      for (size_t value = 0; value < 4; ++value)
+      {
+        const uint8_t length = ((control >> (2 * value)) & 3) + 1;
+        for (uint8_t b = 0; b < 4; ++b) { shuffle[control][value * 4 + b] = b < length ? offset + b : 0x80; }
+        offset += length;
+      }
+      this->length[control] = offset;
+    }
+  }
+};
+
+const shuffle_tables& get_shuffle_tables()
+{
+  static const shuffle_tables tables;
+  return tables;
+}
+
+VW_TARGET_SSSE3 const char* decode_ssse3(const char* in, const char* end, size_t count, uint32_t* out)
+{
+  const auto& tables = get_shuffle_tables();
+  const auto* control = reinterpret_cast<const uint8_t*>(in);
+  const char* data = in + VW::svb::control_size(count);
+
+  size_t i = 0;
+  // A full 16 byte load is only safe while it stays inside the input.
+  for (; i + 4 <= count && data + 16 <= end; i += 4)
+  {
+    const uint8_t c = control[i / 4];
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[c]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(bytes, mask));
+    data += tables.length[c];
+  }
+  return decode_values(control, data, end, i, count, out);
+}
+
+VW_TARGET_AVX2 const char* decode_avx2(const char* in, const char* end, size_t count, uint32_t* out)
+{
+  const auto& tables = get_shuffle_tables();
+  const auto* control = reinterpret_cast<const uint8_t*>(in);
+  const char* data = in + VW::svb::control_size(count);
+
+  size_t i = 0;
+  // Two control bytes per iteration, one per 128 bit lane.
+  for (; i + 8 <= count; i += 8)
+  {
+    const uint8_t c0 = control[i / 4];
+    const uint8_t c1 = control[i / 4 + 1];
+    const char* second = data + tables.length[c0];
+    if (second + 16 > end) { break; }
+    const __m256i bytes =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(second)), 1);
+    const __m256i mask = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[c0]))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[c1])), 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(bytes, mask));
+    data = second + tables.length[c1];
+  }
+  return decode_values(control, data, end, i, count, out);
+}
+#endif
+}  // namespace
+
+char* VW::svb::encode(const uint32_t* in, size_t count, char* out)
+{
+  if (count == 0) { return out; }
+  auto* control = reinterpret_cast<uint8_t*>(out);
+  char* data = out + control_size(count);
+  std::memset(control, 0, control_size(count));
+  for (size_t i = 0; i < count; ++i)
+  {
+    const uint32_t value = in[i];
+    const uint8_t code = length_code(value);
+    control[i / 4] |= static_cast<uint8_t>(code << (2 * (i % 4)));
+    for (uint8_t b = 0; b <= code; ++b) { *(data++) = static_cast<char>((value >> (8 * b)) & 0xff); }
+  }
+  return data;
+}
+
+const char* VW::svb::decode_scalar(const char* in, const char* end, size_t count, uint32_t* out)
+{
+  if (in + control_size(count) > end) { return nullptr; }
+  return decode_values(reinterpret_cast<const uint8_t*>(in), in + control_size(count), end, 0, count, out);
+}
+
+const char* VW::svb::decode(const char* in, const char* end, size_t count, uint32_t* out)
+{
+  if (in + control_size(count) > end) { return nullptr; }
+#if defined(VW_HAVE_X86_DISPATCH)
+  const auto& cpu = get_cpu_features();
+  if (cpu.avx2) { return decode_avx2(in, end, count, out); }
+  if (cpu.ssse3) { return decode_ssse3(in, end, count, out); }
+#endif
+  return decode_scalar(in, end, count, out);
+}
@@ -0,0 +1,33 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Stream VByte (Lemire, Kurz and Rupp) encoding of 32 bit integers. The lengths of four values are packed into one
+// control byte and all control bytes are stored before the data bytes, so a group of four values can be decoded with
+// a single byte shuffle instead of a loop over continuation bits.
+namespace VW
+{
+namespace svb
+{
+/// Number of control bytes for count values.
+inline size_t control_size(size_t count) { return (count + 3) / 4; }
+
+/// Upper bound of the encoded size of count values.
+inline size_t max_encoded_size(size_t count) { return control_size(count) + count * sizeof(uint32_t); }
+
+/// Encodes count values to out, which must have room for max_encoded_size(count) bytes. Returns the end of the output.
+char* encode(const uint32_t* in, size_t count, char* out);
+
+/// Decodes count values from in. Returns the end of the encoded input or nullptr if it would extend past end.
+/// Uses the widest instruction set available on this machine.
+const char* decode(const char* in, const char* end, size_t count, uint32_t* out);
+
+/// Portable decoder, exposed so that the vectorized paths can be checked against it.
+const char* decode_scalar(const char* in, const char* end, size_t count, uint32_t* out);
+}  // namespace svb
+}  // namespace VW
@@ -0,0 +1,158 @@
+// Copyright (c) by respective owners including Yahoo!, Microsoft, and
+// individual contributors. All rights reserved. Released under a BSD (revised)
+// license as described in the file LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <vector>
+
+// Mutex and CV cannot be used in managed C++, tell the compiler that this is unmanaged even if included in a managed
+// project.
+#ifdef _M_CEE
+#  pragma managed(push, off)
+#  undef _M_CEE
+#  include <mutex>
+#  include <condition_variable>
+#  include <thread>
+#  define _M_CEE 001
+#  pragma managed(pop)
+#else
+#  include <mutex>
+#  include <condition_variable>
+#  include <thread>
+#endif
+
+namespace VW
+{
+/// Fixed size pool of worker threads used to fan a loop out across cores.
+/// The thread that calls parallel_for participates in the work, so a pool of size N owns N - 1 background threads.
+/// parallel_for is not reentrant and must only be called by one thread at a time.
+class thread_pool
+{
+public:
+  explicit thread_pool(size_t num_threads)
+  {
+    for (size_t i = 1; i < num_threads; ++i) { _workers.emplace_back(&thread_pool::worker_loop, this); }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool()
+  {
+    {
+      std::unique_lock<std::mutex> lock(_mut);
+      _stop = true;
+    }
+    _work_available.notify_all();
+    for (auto& worker : _workers) { worker.join(); }
+  }
+
+  /// Total number of threads that execute work, including the caller of parallel_for.
+  size_t size() const { return _workers.size() + 1; }
+
+  /// Calls task(i) for every i in [0, count) and blocks until all calls have returned.
+  /// Indices are handed out dynamically so callers should pass coarse grained work items.
+  /// If any call throws, the remaining items still run and the first exception is rethrown here.
+  void parallel_for(size_t count, std::function<void(size_t)> task)
+  {
+    if (count == 0) { return; }
+    if (_workers.empty() || count == 1)
+    {
+      for (size_t i = 0; i < count; ++i) { task(i); }
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(_mut);
+      _task = std::move(task);
+      _count = count;
+      _next = 0;
+      _pending_workers = _workers.size();
+      _exc_ptr = nullptr;
+      ++_generation;
+    }
+    _work_available.notify_all();
+
+    run_tasks();
+
+    std::exception_ptr exc_ptr;
+    {
+      std::unique_lock<std::mutex> lock(_mut);
+      _work_done.wait(lock, [this] { return _pending_workers == 0; });
+      _task = nullptr;
+      std::swap(exc_ptr, _exc_ptr);
+    }
+    if (exc_ptr) { std::rethrow_exception(exc_ptr); }
+  }
+
+  /// Splits [0, count) into one contiguous range per thread and calls task(begin, end) for each non-empty range.
+  void parallel_for_ranges(size_t count, const std::function<void(size_t, size_t)>& task)
+  {
+    const size_t num_ranges = std::min(size(), count);
+    parallel_for(num_ranges, [&](size_t range) {
+      const size_t begin = count * range / num_ranges;
+      const size_t end = count * (range + 1) / num_ranges;
+      task(begin, end);
+    });
+  }
+
+private:
+  void run_tasks()
+  {
+    size_t i;
+    while ((i = _next.fetch_add(1)) < _count)
+    {
+      try
+      {
+        _task(i);
+      }
+      catch (...)
+      {
+        std::unique_lock<std::mutex> lock(_mut);
+        if (!_exc_ptr) { _exc_ptr = std::current_exception(); }
+      }
+    }
+  }
+
+  void worker_loop()
+  {
+    uint64_t seen_generation = 0;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(_mut);
+        _work_available.wait(lock, [&] { return _stop || _generation != seen_generation; });
+        if (_stop) { return; }
+        seen_generation = _generation;
+      }
+
+      run_tasks();
+
+      {
+        std::unique_lock<std::mutex> lock(_mut);
+        if (--_pending_workers == 0) { _work_done.notify_one(); }
+      }
+    }
+  }
+
+  std::vector<std::thread> _workers;
+  std::mutex _mut;
+  std::condition_variable _work_available;
+  std::condition_variable _work_done;
+
+  std::function<void(size_t)> _task;
+  size_t _count = 0;
+  std::atomic<size_t> _next{0};
+  size_t _pending_workers = 0;
+  uint64_t _generation = 0;
+  bool _stop = false;
+  std::exception_ptr _exc_ptr;
+};
+}  // namespace VW
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ostream>
@@ -43,12 +44,13 @@ private:
     if (_begin != nullptr)
     {
       for (iterator item = _begin; item != _end; ++item) { item->~T(); }
-      free(_begin);
+      if (!_borrowed) { free(_begin); }
     }
     _begin = nullptr;
     _end = nullptr;
     _end_array = nullptr;
     _erase_count = 0;
+    _borrowed = false;
   }
 
   void reserve_nocheck(size_t length)
@@ -56,7 +58,21 @@ private:
     if (capacity() == length || length == 0) { return; }
     const size_t old_len = size();
 
-    T* temp = reinterpret_cast<T*>(std::realloc(_begin, sizeof(T) * length));
+    // A borrowed buffer can't be reallocated, so the elements move into memory of this v_array's own.
+    T* temp = nullptr;
+    if (_borrowed)
+    {
+      temp = reinterpret_cast<T*>(std::malloc(sizeof(T) * length));
+      if (temp != nullptr)
+      {
+        if (old_len > 0) { memcpy(temp, _begin, sizeof(T) * std::min(old_len, length)); }
+        _borrowed = false;
+      }
+    }
+    else
+    {
+      temp = reinterpret_cast<T*>(std::realloc(_begin, sizeof(T) * length));
+    }
     if (temp == nullptr)
     { THROW_OR_RETURN("realloc of " << length << " failed in reserve_nocheck().  out of memory?"); }
     else
@@ -95,7 +111,8 @@ private:
   T* _begin;
   T* _end;
   T* _end_array;
-  size_t _erase_count;
+  uint32_t _erase_count;
+  bool _borrowed;  // _begin is owned by someone else, see borrow()
 
 public:
   using value_type = T;
@@ -119,12 +136,13 @@ public:
   inline const_iterator cbegin() const noexcept { return _begin; }
   inline const_iterator cend() const noexcept { return _end; }
 
-  v_array() noexcept : _begin(nullptr), _end(nullptr), _end_array(nullptr), _erase_count(0) {}
+  v_array() noexcept : _begin(nullptr), _end(nullptr), _end_array(nullptr), _erase_count(0), _borrowed(false) {}
   ~v_array() { delete_v_array(); }
 
   v_array(v_array<T>&& other) noexcept
   {
     _erase_count = 0;
+    _borrowed = false;
     _begin = nullptr;
     _end = nullptr;
     _end_array = nullptr;
@@ -133,6 +151,7 @@ public:
     std::swap(_end, other._end);
     std::swap(_end_array, other._end_array);
     std::swap(_erase_count, other._erase_count);
+    std::swap(_borrowed, other._borrowed);
   }
 
   v_array<T>& operator=(v_array<T>&& other) noexcept
@@ -141,6 +160,7 @@ public:
     std::swap(_end, other._end);
     std::swap(_end_array, other._end_array);
     std::swap(_erase_count, other._erase_count);
+    std::swap(_borrowed, other._borrowed);
     return *this;
   }
 
@@ -150,6 +170,7 @@ public:
     _end = nullptr;
     _end_array = nullptr;
     _erase_count = 0;
+    _borrowed = false;
 
     copy_into_this(other);
   }
@@ -218,6 +239,7 @@ public:
 
   void shrink_to_fit()
   {
+    if (_borrowed) { return; }
     if (size() < capacity())
     {
       if (empty())
@@ -233,6 +255,23 @@ public:
     }
   }
 
+  /// \brief Releases the memory of this v_array and uses buffer instead, which holds size elements and has room for
+  /// capacity. The caller keeps owning buffer and must keep it alive while this v_array uses it. Growing past
+  /// capacity moves the elements into memory of this v_array's own again, and shrink_to_fit leaves a borrowed buffer
+  /// alone.
+  void borrow(T* buffer, size_t size, size_t capacity)
+  {
+    assert(size <= capacity);
+    delete_v_array();
+    _begin = buffer;
+    _end = buffer + size;
+    _end_array = buffer + capacity;
+    _borrowed = true;
+  }
+
+  /// Whether the elements are in a buffer lent by borrow().
+  bool borrowed() const { return _borrowed; }
+
   // reserve enough space for the specified number of elements
   inline void reserve(size_t length)
   {
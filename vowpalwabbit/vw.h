@@ -96,6 +96,21 @@ struct primitive_feature_space  // just a helper definition.
 example* read_example(vw& all, const char* example_line);
 example* read_example(vw& all, const std::string& example_line);
 
+// Batched prediction for embedding.  Each writes one float per example into predictions: the scalar prediction, or the
+// class for multiclass predictions.  No output is written and nothing is counted in the shared data, so there is no
+// finish_example to call.  Only single-line reductions are supported.
+
+// Predicts examples created with read_example or import_example.  The caller still owns and finishes them.
+void predict_batch(vw& all, example* const* examples, size_t count, float* predictions);
+// Predicts every line of a buffer in the text format, parsing each into the same example from the pool.  A trailing
+// newline does not start another example.  The examples are not written to the cache and do not count towards the
+// holdout set.  Returns the number of predictions written, at most max_predictions.  If consumed is given it is set to
+// the number of bytes of lines that were predicted, so the rest can be passed to another call, and if written is given
+// to the number of predictions.  Both are kept up to date line by line: if a line throws, they cover the lines before
+// it, whose predictions are written.
+size_t predict_batch(vw& all, const char* lines, size_t length, float* predictions, size_t max_predictions,
+    size_t* consumed = nullptr, size_t* written = nullptr);
+
 // The more complex way to create an example.
 
 // after you create and fill feature_spaces, get an example with everything filled in.
@@ -119,6 +134,9 @@ void dealloc_examples(example* example_ptr, size_t count);
 void parse_example_label(vw& all, example& ec, std::string label);
 void setup_examples(vw& all, v_array<example*>& examples);
 void setup_example(vw& all, example* ae);
+// The part of setup_example that transforms the features: ignored namespaces, ngrams, the constant feature, feature
+// limits and the weight stride. Unlike setup_example it does not touch the parser, which VW::predictor relies on.
+void setup_example_features(vw& all, example* ae);
 example* new_unused_example(vw& all);
 example* get_example(parser* pf);
 float get_topic_prediction(example* ec, size_t i);  // i=0 to max topic -1
@@ -169,6 +187,11 @@ void releaseFeatureSpace(primitive_feature_space* features, size_t len);
 void save_predictor(vw& all, std::string reg_name);
 void save_predictor(vw& all, io_buf& buf);
 
+// Delta checkpoints, see delta_checkpoint.h. save_delta writes the weight blocks that changed since the last model or
+// delta that was saved or loaded with --delta_checkpoints. apply_delta applies one onto the model it was made from.
+void save_delta(vw& all, const std::string& delta_name);
+void apply_delta(vw& all, const std::string& delta_name);
+
 // inlines
 
 // First create the hash of a namespace.
@@ -13,6 +13,7 @@
 #include "parse_args.h"
 #include "vw.h"
 #include "memory.h"
+#include "io/logger.h"
 
 // This interface now provides "wide" functions for compatibility with .NET interop
 // The default functions assume a wide (16 bit char pointer) that is converted to a utf8-string and passed to
@@ -312,6 +313,48 @@ VW_DLL_PUBLIC float VW_CALLING_CONV VW_Predict(VW_HANDLE handle, VW_EXAMPLE e)
   return VW::get_prediction(ex);
 }
 
+VW_DLL_PUBLIC int VW_CALLING_CONV VW_PredictBatch(
+    VW_HANDLE handle, VW_EXAMPLE* examples, size_t count, float* predictions)
+{
+  vw* pointer = static_cast<vw*>(handle);
+  try
+  {
+    VW::predict_batch(*pointer, reinterpret_cast<example* const*>(examples), count, predictions);
+    return VW_BATCH_OK;
+  }
+  catch (const std::exception& e)
+  {
+    VW::io::logger::errlog_error("VW_PredictBatch: {}", e.what());
+    return VW_BATCH_ERROR;
+  }
+  catch (...)
+  {
+    VW::io::logger::errlog_error("VW_PredictBatch: unknown exception");
+    return VW_BATCH_ERROR;
+  }
+}
+
+VW_DLL_PUBLIC int VW_CALLING_CONV VW_PredictLinesA(VW_HANDLE handle, const char* lines, size_t length,
+    float* predictions, size_t max_predictions, size_t* written, size_t* consumed)
+{
+  vw* pointer = static_cast<vw*>(handle);
+  // predict_batch keeps both counts up to date, so they cover the lines before one that throws.
+  try
+  {
+    VW::predict_batch(*pointer, lines, length, predictions, max_predictions, consumed, written);
+    return VW_BATCH_OK;
+  }
+  catch (const std::exception& e)
+  {
+    VW::io::logger::errlog_error("VW_PredictLinesA: {}", e.what());
+  }
+  catch (...)
+  {
+    VW::io::logger::errlog_error("VW_PredictLinesA: unknown exception");
+  }
+  return VW_BATCH_ERROR;
+}
+
 VW_DLL_PUBLIC float VW_CALLING_CONV VW_PredictCostSensitive(VW_HANDLE handle, VW_EXAMPLE e)
 { vw * pointer = static_cast<vw*>(handle);
   example * ex = static_cast<example*>(e);
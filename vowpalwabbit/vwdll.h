@@ -46,6 +46,10 @@ extern "C"
   const VW_HANDLE INVALID_VW_HANDLE = VW_TYPE_SAFE_NULL;
   const VW_HANDLE INVALID_VW_EXAMPLE = VW_TYPE_SAFE_NULL;
 
+  // Returned by the batched predict functions, which report errors instead of throwing.
+  const int VW_BATCH_OK = 0;
+  const int VW_BATCH_ERROR = -1;
+
 #ifdef USE_CODECVT
   VW_DLL_PUBLIC VW_HANDLE VW_CALLING_CONV VW_Initialize(const char16_t* pstrArgs);
   VW_DLL_PUBLIC VW_HANDLE VW_CALLING_CONV VW_InitializeEscaped(const char16_t* pstrArgs);
@@ -116,6 +120,16 @@ extern "C"
   VW_DLL_PUBLIC float VW_CALLING_CONV VW_Learn(VW_HANDLE handle, VW_EXAMPLE e);
   VW_DLL_PUBLIC float VW_CALLING_CONV VW_Predict(VW_HANDLE handle, VW_EXAMPLE e);
   VW_DLL_PUBLIC float VW_CALLING_CONV VW_PredictCostSensitive(VW_HANDLE handle, VW_EXAMPLE e);
+  // Writes one prediction per example into predictions, see VW::predict_batch. Returns VW_BATCH_OK, or VW_BATCH_ERROR
+  // after logging the error, in which case the predictions are undefined.
+  VW_DLL_PUBLIC int VW_CALLING_CONV VW_PredictBatch(
+      VW_HANDLE handle, VW_EXAMPLE* examples, size_t count, float* predictions);
+  // Parses and predicts the lines of a buffer in the text format, at most max_predictions of them. written is set to
+  // the number of predictions written and consumed to the number of bytes of lines they came from, so the rest can be
+  // passed to another call. Returns VW_BATCH_OK, or VW_BATCH_ERROR after logging the error, in which case written and
+  // consumed cover the lines before the one that failed.
+  VW_DLL_PUBLIC int VW_CALLING_CONV VW_PredictLinesA(VW_HANDLE handle, const char* lines, size_t length,
+      float* predictions, size_t max_predictions, size_t* written, size_t* consumed);
   // deprecated. Please use either VW_ReadExample for parsing, or VW_ImportExample for example construction
   VW_DLL_PUBLIC void VW_CALLING_CONV VW_AddLabel(VW_EXAMPLE e, float label, float weight, float base);
   // deprecated. Please use either VW_ReadExample for parsing, or VW_ImportExample for example construction